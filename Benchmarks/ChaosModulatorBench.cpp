@@ -0,0 +1,220 @@
+/**
+ * Blackheart Chaos Modulator Benchmark
+ *
+ * Times ChaosModulator::processToBuffers at several control intervals
+ * against the per-sample path (getNextModulationValue once per sample) and
+ * reports ns per sample plus the speed-up over per-sample generation as
+ * JSON (stdout, or --output=<file>).
+ *
+ * Interval 1 runs a control step every sample through the block API, the
+ * block path's worst case. The default interval of 16 should come out about
+ * 10x cheaper than per-sample generation.
+ *
+ * Options:
+ *   --rate=48000            sample rate
+ *   --block=256             block size
+ *   --chaos=0.7             normalised CHAOS
+ *   --seconds=1.0           audio timed per run, excluding warm-up
+ *   --output=chaos.json     write JSON to a file instead of stdout
+ */
+
+#include "DSP/ChaosModulator.h"
+#include <iostream>
+#include <vector>
+
+//==============================================================================
+// Configuration
+//==============================================================================
+
+struct ChaosBenchConfig
+{
+    double sampleRate = 48000.0;
+    int blockSize = 256;
+    float chaos = 0.7f;
+    double seconds = 1.0;
+    double warmupSeconds = 0.25;
+    juce::String outputPath;
+};
+
+static ChaosBenchConfig parseArguments(const juce::ArgumentList& args)
+{
+    ChaosBenchConfig config;
+
+    if (args.containsOption("--rate"))
+        config.sampleRate = juce::jlimit(8000.0, 384000.0, args.getValueForOption("--rate").getDoubleValue());
+
+    if (args.containsOption("--block"))
+        config.blockSize = juce::jlimit(16, 8192, args.getValueForOption("--block").getIntValue());
+
+    if (args.containsOption("--chaos"))
+        config.chaos = juce::jlimit(0.0f, 1.0f, args.getValueForOption("--chaos").getFloatValue());
+
+    if (args.containsOption("--seconds"))
+        config.seconds = juce::jmax(0.1, args.getValueForOption("--seconds").getDoubleValue());
+
+    config.outputPath = args.getValueForOption("--output");
+    return config;
+}
+
+// 0 is the per-sample path; the rest are control intervals
+static const int intervals[] = { 0, 1, 4, 16, 32 };
+
+//==============================================================================
+// Runner
+//==============================================================================
+
+struct ChaosBenchResult
+{
+    juce::String variant;
+    int interval = 0;
+    double nsPerSample = 0.0;
+    double speedup = 1.0;
+};
+
+static double timeInterval(const ChaosBenchConfig& config, int interval)
+{
+    DSP::ChaosModulator modulator;
+    modulator.setSeed(4242);
+    modulator.setSpeed(0.6f);
+    modulator.setChaos(config.chaos);
+    modulator.prepare({ config.sampleRate, static_cast<juce::uint32>(config.blockSize), 2 });
+    if (interval > 0)
+        modulator.setControlInterval(interval);
+
+    const int blockSize = config.blockSize;
+    std::vector<float> pitch(static_cast<size_t>(blockSize));
+    std::vector<float> grain(static_cast<size_t>(blockSize));
+    std::vector<float> timing(static_cast<size_t>(blockSize));
+
+    const int warmupBlocks = juce::jmax(1, static_cast<int>(config.warmupSeconds * config.sampleRate) / blockSize);
+    const int timedBlocks = juce::jmax(1, static_cast<int>(config.seconds * config.sampleRate) / blockSize);
+    juce::int64 totalTicks = 0;
+    float sink = 0.0f;
+
+    for (int block = 0; block < warmupBlocks + timedBlocks; ++block)
+    {
+        // A slow envelope swell keeps the smoothers moving
+        modulator.setEnvelopeValue(0.5f + 0.5f * std::sin(static_cast<float>(block) * 0.05f));
+
+        const auto start = juce::Time::getHighResolutionTicks();
+        if (interval == 0)
+        {
+            for (int i = 0; i < blockSize; ++i)
+            {
+                modulator.getNextModulationValue();
+                const auto out = modulator.getModulation();
+                pitch[static_cast<size_t>(i)] = out.pitchMod;
+                grain[static_cast<size_t>(i)] = out.grainSizeMod;
+                timing[static_cast<size_t>(i)] = out.timingMod;
+            }
+        }
+        else
+        {
+            modulator.processToBuffers(pitch.data(), grain.data(), timing.data(), blockSize);
+        }
+        const auto elapsed = juce::Time::getHighResolutionTicks() - start;
+
+        if (block >= warmupBlocks)
+            totalTicks += elapsed;
+
+        // Keeps the buffers live so the per-sample loop isn't optimised away
+        sink += pitch.back() + grain.back() + timing.back();
+    }
+
+    if (! std::isfinite(sink))
+        std::cerr << "Non-finite modulation at interval " << interval << std::endl;
+
+    const double ticksToNs = 1.0e9 / static_cast<double>(juce::Time::getHighResolutionTicksPerSecond());
+    return static_cast<double>(totalTicks) * ticksToNs / (static_cast<double>(timedBlocks) * blockSize);
+}
+
+static std::vector<ChaosBenchResult> runAll(const ChaosBenchConfig& config)
+{
+    std::vector<ChaosBenchResult> results;
+    double perSampleNs = 0.0;
+
+    for (int interval : intervals)
+    {
+        ChaosBenchResult result;
+        result.variant = interval == 0 ? juce::String("per-sample") : "interval-" + juce::String(interval);
+        result.interval = juce::jmax(1, interval);
+        result.nsPerSample = timeInterval(config, interval);
+
+        if (interval == 0)
+            perSampleNs = result.nsPerSample;
+        result.speedup = result.nsPerSample > 0.0 ? perSampleNs / result.nsPerSample : 0.0;
+
+        std::cerr << result.variant << ": " << juce::String(result.nsPerSample, 2) << " ns/sample, "
+                  << juce::String(result.speedup, 1) << "x" << std::endl;
+
+        results.push_back(result);
+    }
+
+    return results;
+}
+
+//==============================================================================
+// Report
+//==============================================================================
+
+static juce::var toJson(const ChaosBenchConfig& config, const std::vector<ChaosBenchResult>& results)
+{
+    juce::DynamicObject::Ptr root = new juce::DynamicObject();
+    root->setProperty("benchmark", "chaosModulator");
+    root->setProperty("pluginVersion", JucePlugin_VersionString);
+   #if JUCE_DEBUG
+    root->setProperty("build", "debug");
+   #else
+    root->setProperty("build", "release");
+   #endif
+    root->setProperty("cpu", juce::SystemStats::getCpuModel());
+    root->setProperty("os", juce::SystemStats::getOperatingSystemName());
+    root->setProperty("sampleRate", config.sampleRate);
+    root->setProperty("blockSize", config.blockSize);
+    root->setProperty("chaos", config.chaos);
+    root->setProperty("secondsPerRun", config.seconds);
+
+    juce::Array<juce::var> runs;
+    for (const auto& r : results)
+    {
+        juce::DynamicObject::Ptr run = new juce::DynamicObject();
+        run->setProperty("variant", r.variant);
+        run->setProperty("interval", r.interval);
+        run->setProperty("nsPerSample", r.nsPerSample);
+        run->setProperty("speedup", r.speedup);
+        runs.add(juce::var(run.get()));
+    }
+    root->setProperty("results", runs);
+
+    return juce::var(root.get());
+}
+
+//==============================================================================
+// Entry point
+//==============================================================================
+
+int main(int argc, char* argv[])
+{
+    juce::ScopedJuceInitialiser_GUI juceInit;
+
+    const juce::ArgumentList args(argc, argv);
+    const auto config = parseArguments(args);
+
+    const auto json = juce::JSON::toString(toJson(config, runAll(config)));
+
+    if (config.outputPath.isNotEmpty())
+    {
+        const auto file = juce::File::getCurrentWorkingDirectory().getChildFile(config.outputPath);
+        if (! file.replaceWithText(json))
+        {
+            std::cerr << "Could not write " << file.getFullPathName() << std::endl;
+            return 1;
+        }
+    }
+    else
+    {
+        std::cout << json << std::endl;
+    }
+
+    return 0;
+}
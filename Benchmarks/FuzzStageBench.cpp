@@ -0,0 +1,289 @@
+/**
+ * Blackheart Fuzz Stage Benchmark
+ *
+ * Runs the fuzz stage on its own (oversampler round trip + FuzzEngine) in
+ * each anti-aliasing variant, per mode, and reports the cost in ns per
+ * native sample plus the aliasing of steady tones as JSON (stdout, or
+ * --output=<file>).
+ *
+ * Variants: 1x (direct), 1x-adaa (antiderivative shaping), 2x-iir (the
+ * Live tier) and 2x-iir-adaa. Aliasing is the power outside the tone's
+ * harmonics relative to the total, in dB (TestSignals::measureAliasingDb).
+ *
+ * Options:
+ *   --rate=48000            native sample rate
+ *   --block=256             block size
+ *   --gain=0.8              normalised GAIN
+ *   --seconds=1.0           audio timed per run, excluding warm-up
+ *   --output=fuzz.json      write JSON to a file instead of stdout
+ */
+
+#include "DSP/FuzzEngine.h"
+#include "DSP/Oversampler.h"
+#include "../Tests/TestSignals.h"
+#include <iostream>
+#include <vector>
+
+//==============================================================================
+// Configuration
+//==============================================================================
+
+struct FuzzBenchConfig
+{
+    double sampleRate = 48000.0;
+    int blockSize = 256;
+    float gain = 0.8f;
+    double seconds = 1.0;
+    double warmupSeconds = 0.25;
+    juce::String outputPath;
+};
+
+static FuzzBenchConfig parseArguments(const juce::ArgumentList& args)
+{
+    FuzzBenchConfig config;
+
+    if (args.containsOption("--rate"))
+        config.sampleRate = juce::jlimit(8000.0, 384000.0, args.getValueForOption("--rate").getDoubleValue());
+
+    if (args.containsOption("--block"))
+        config.blockSize = juce::jlimit(16, 8192, args.getValueForOption("--block").getIntValue());
+
+    if (args.containsOption("--gain"))
+        config.gain = juce::jlimit(0.0f, 1.0f, args.getValueForOption("--gain").getFloatValue());
+
+    if (args.containsOption("--seconds"))
+        config.seconds = juce::jmax(0.1, args.getValueForOption("--seconds").getDoubleValue());
+
+    config.outputPath = args.getValueForOption("--output");
+    return config;
+}
+
+struct FuzzVariant
+{
+    const char* name;
+    int factor;
+    bool antiderivative;
+};
+
+static const FuzzVariant variants[] = {
+    { "1x",          1, false },
+    { "1x-adaa",     1, true },
+    { "2x-iir",      2, false },
+    { "2x-iir-adaa", 2, true },
+};
+
+static const char* const modeNames[] = { "scream", "od", "doom" };
+static const double toneHz[] = { 1000.0, 2500.0, 5000.0 };
+
+//==============================================================================
+// Runner
+//==============================================================================
+
+// The processor's oversampled domain with only the fuzz inside
+struct FuzzChain
+{
+    DSP::Oversampler oversampler;
+    DSP::FuzzEngine fuzzEngine;
+
+    void prepare(const FuzzBenchConfig& config, const FuzzVariant& variant, int mode)
+    {
+        const juce::dsp::ProcessSpec spec { config.sampleRate, static_cast<juce::uint32>(config.blockSize), 2 };
+        oversampler.prepare(spec, { variant.factor, DSP::Oversampler::FilterType::MinimumPhaseIIR });
+
+        fuzzEngine.setAntiderivativeShaping(variant.antiderivative);
+        fuzzEngine.prepare(oversampler.getOversampledSpec());
+        fuzzEngine.setMode(mode);
+        fuzzEngine.setGain(config.gain);
+        fuzzEngine.reset();
+    }
+
+    void process(juce::AudioBuffer<float>& buffer)
+    {
+        juce::dsp::AudioBlock<float> block(buffer);
+        auto oversampled = oversampler.processUp(block);
+        fuzzEngine.process(oversampled);
+        oversampler.processDown(block);
+    }
+};
+
+struct FuzzBenchResult
+{
+    juce::String variant;
+    juce::String mode;
+    double nsPerSample = 0.0;
+    std::vector<std::pair<double, double>> aliasing;  // tone Hz, alias dB
+};
+
+static double timeVariant(const FuzzBenchConfig& config, const FuzzVariant& variant, int mode,
+                          const juce::AudioBuffer<float>& signal)
+{
+    FuzzChain chain;
+    chain.prepare(config, variant, mode);
+
+    const int blockSize = config.blockSize;
+    juce::AudioBuffer<float> buffer(2, blockSize);
+
+    const int warmupBlocks = juce::jmax(1, static_cast<int>(config.warmupSeconds * config.sampleRate) / blockSize);
+    const int timedBlocks = juce::jmax(1, static_cast<int>(config.seconds * config.sampleRate) / blockSize);
+    const int signalBlocks = signal.getNumSamples() / blockSize;
+    juce::int64 totalTicks = 0;
+
+    for (int block = 0; block < warmupBlocks + timedBlocks; ++block)
+    {
+        const int offset = (block % signalBlocks) * blockSize;
+        for (int ch = 0; ch < 2; ++ch)
+            buffer.copyFrom(ch, 0, signal, ch, offset, blockSize);
+
+        const auto start = juce::Time::getHighResolutionTicks();
+        chain.process(buffer);
+        const auto elapsed = juce::Time::getHighResolutionTicks() - start;
+
+        if (block >= warmupBlocks)
+            totalTicks += elapsed;
+    }
+
+    const double ticksToNs = 1.0e9 / static_cast<double>(juce::Time::getHighResolutionTicksPerSecond());
+    return static_cast<double>(totalTicks) * ticksToNs / (static_cast<double>(timedBlocks) * blockSize);
+}
+
+static std::pair<double, double> measureTone(const FuzzBenchConfig& config, const FuzzVariant& variant, int mode,
+                                             double targetHz)
+{
+    FuzzChain chain;
+    chain.prepare(config, variant, mode);
+
+    // One second to settle the envelopes and EQ, then a coherent capture
+    constexpr int captureSamples = 1 << 15;
+    const int bin = TestSignals::coherentToneBin(config.sampleRate, targetHz, captureSamples);
+    const double hz = bin * config.sampleRate / captureSamples;
+    const int blockSize = config.blockSize;
+    const int settleSamples = static_cast<int>(config.sampleRate);
+
+    juce::AudioBuffer<float> buffer(2, blockSize);
+    std::vector<float> capture;
+    capture.reserve(static_cast<size_t>(captureSamples));
+
+    for (int position = 0; static_cast<int>(capture.size()) < captureSamples; position += blockSize)
+    {
+        for (int i = 0; i < blockSize; ++i)
+        {
+            const double phase = juce::MathConstants<double>::twoPi * hz * (position + i) / config.sampleRate;
+            buffer.setSample(0, i, 0.5f * static_cast<float>(std::sin(phase)));
+            buffer.setSample(1, i, buffer.getSample(0, i));
+        }
+
+        chain.process(buffer);
+
+        for (int i = 0; i < blockSize && static_cast<int>(capture.size()) < captureSamples; ++i)
+            if (position + i >= settleSamples)
+                capture.push_back(buffer.getSample(0, i));
+    }
+
+    return { hz, TestSignals::measureAliasingDb(capture.data(), captureSamples, bin) };
+}
+
+static std::vector<FuzzBenchResult> runAll(const FuzzBenchConfig& config)
+{
+    // 4 seconds of source material, looped for longer runs
+    const auto signal = TestSignals::renderGuitarSignal(config.sampleRate, static_cast<int>(4.0 * config.sampleRate));
+    std::vector<FuzzBenchResult> results;
+
+    for (int mode = 0; mode < 3; ++mode)
+    {
+        for (const auto& variant : variants)
+        {
+            FuzzBenchResult result { variant.name, modeNames[mode] };
+            result.nsPerSample = timeVariant(config, variant, mode, signal);
+
+            std::cerr << modeNames[mode] << " / " << variant.name << ": "
+                      << juce::String(result.nsPerSample, 2) << " ns/sample, aliasing";
+
+            for (double target : toneHz)
+            {
+                result.aliasing.push_back(measureTone(config, variant, mode, target));
+                std::cerr << " " << juce::String(result.aliasing.back().second, 1) << " dB";
+            }
+            std::cerr << std::endl;
+
+            results.push_back(std::move(result));
+        }
+    }
+
+    return results;
+}
+
+//==============================================================================
+// Report
+//==============================================================================
+
+static juce::var toJson(const FuzzBenchConfig& config, const std::vector<FuzzBenchResult>& results)
+{
+    juce::DynamicObject::Ptr root = new juce::DynamicObject();
+    root->setProperty("benchmark", "fuzzStage");
+    root->setProperty("pluginVersion", JucePlugin_VersionString);
+   #if JUCE_DEBUG
+    root->setProperty("build", "debug");
+   #else
+    root->setProperty("build", "release");
+   #endif
+    root->setProperty("cpu", juce::SystemStats::getCpuModel());
+    root->setProperty("os", juce::SystemStats::getOperatingSystemName());
+    root->setProperty("sampleRate", config.sampleRate);
+    root->setProperty("blockSize", config.blockSize);
+    root->setProperty("gain", config.gain);
+    root->setProperty("secondsPerRun", config.seconds);
+
+    juce::Array<juce::var> runs;
+    for (const auto& r : results)
+    {
+        juce::DynamicObject::Ptr run = new juce::DynamicObject();
+        run->setProperty("variant", r.variant);
+        run->setProperty("mode", r.mode);
+        run->setProperty("nsPerSample", r.nsPerSample);
+
+        juce::Array<juce::var> tones;
+        for (const auto& [hz, aliasDb] : r.aliasing)
+        {
+            juce::DynamicObject::Ptr tone = new juce::DynamicObject();
+            tone->setProperty("hz", hz);
+            tone->setProperty("aliasDb", aliasDb);
+            tones.add(juce::var(tone.get()));
+        }
+        run->setProperty("aliasing", tones);
+
+        runs.add(juce::var(run.get()));
+    }
+    root->setProperty("results", runs);
+
+    return juce::var(root.get());
+}
+
+//==============================================================================
+// Entry point
+//==============================================================================
+
+int main(int argc, char* argv[])
+{
+    juce::ScopedJuceInitialiser_GUI juceInit;
+
+    const juce::ArgumentList args(argc, argv);
+    const auto config = parseArguments(args);
+
+    const auto json = juce::JSON::toString(toJson(config, runAll(config)));
+
+    if (config.outputPath.isNotEmpty())
+    {
+        const auto file = juce::File::getCurrentWorkingDirectory().getChildFile(config.outputPath);
+        if (! file.replaceWithText(json))
+        {
+            std::cerr << "Could not write " << file.getFullPathName() << std::endl;
+            return 1;
+        }
+    }
+    else
+    {
+        std::cout << json << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,229 @@
+/**
+ * Blackheart Math Kernel Benchmark
+ *
+ * Times the LookupTables functions against the table-free MathKernels tiers
+ * (and libm) on batches of inputs across each function's domain, and
+ * reports ns per value plus maximum error as JSON (stdout, or --output=<file>).
+ *
+ * Options:
+ *   --seconds=0.5           time spent per kernel
+ *   --batch=256             values per call (block-size analogue)
+ *   --output=math.json      write JSON to a file instead of stdout
+ */
+
+#include "DSP/LookupTables.h"
+#include "DSP/MathKernels.h"
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+using namespace DSP;
+using Tier = MathKernels::Tier;
+
+//==============================================================================
+// Configuration
+//==============================================================================
+
+struct MathBenchConfig
+{
+    double seconds = 0.5;
+    int batchSize = 256;
+    juce::String outputPath;
+};
+
+static MathBenchConfig parseArguments(const juce::ArgumentList& args)
+{
+    MathBenchConfig config;
+
+    if (args.containsOption("--seconds"))
+        config.seconds = juce::jmax(0.05, args.getValueForOption("--seconds").getDoubleValue());
+
+    if (args.containsOption("--batch"))
+        config.batchSize = juce::jlimit(16, 65536, args.getValueForOption("--batch").getIntValue());
+
+    config.outputPath = args.getValueForOption("--output");
+    return config;
+}
+
+// One function under test: its domain, double-precision reference and
+// whether the error is reported relative to the reference
+struct MathFunction
+{
+    const char* name;
+    float lo, hi;
+    double (*reference)(double);
+    bool relativeError;
+};
+
+static const MathFunction sine    { "sin",  -2.0f, 2.0f, [](double p) { return std::sin(2.0 * juce::MathConstants<double>::pi * p); }, false };
+static const MathFunction cosine  { "cos",  -2.0f, 2.0f, [](double p) { return std::cos(2.0 * juce::MathConstants<double>::pi * p); }, false };
+static const MathFunction tanhFn  { "tanh", -4.0f, 4.0f, [](double x) { return std::tanh(x); }, false };
+static const MathFunction expFn   { "exp",  -8.0f, 0.0f, [](double x) { return std::exp(x); }, true };
+
+//==============================================================================
+// Runner
+//==============================================================================
+
+struct MathBenchResult
+{
+    juce::String function;
+    juce::String variant;
+    double nsPerValue = 0.0;
+    double maxError = 0.0;
+};
+
+template <typename Batch>
+static MathBenchResult runKernel(const MathFunction& function, const char* variant, Batch&& batch,
+                                 const MathBenchConfig& config)
+{
+    const int n = config.batchSize;
+    std::vector<float> input(static_cast<size_t>(n)), output(static_cast<size_t>(n));
+
+    // Dense sweep for the error, then a shuffled-looking sweep for timing so
+    // table variants don't walk the table in order
+    MathBenchResult result { function.name, variant };
+    const int errorPoints = 1 << 20;
+    for (int start = 0; start < errorPoints; start += n)
+    {
+        for (int i = 0; i < n; ++i)
+            input[static_cast<size_t>(i)] = function.lo + (function.hi - function.lo)
+                                            * static_cast<float>(std::min(start + i, errorPoints)) / static_cast<float>(errorPoints);
+        batch(input.data(), output.data(), n);
+
+        for (int i = 0; i < n; ++i)
+        {
+            const double reference = function.reference(input[static_cast<size_t>(i)]);
+            double error = std::abs(static_cast<double>(output[static_cast<size_t>(i)]) - reference);
+            if (function.relativeError)
+                error /= std::max(std::abs(reference), 1.0e-30);
+            result.maxError = std::max(result.maxError, error);
+        }
+    }
+
+    for (int i = 0; i < n; ++i)
+        input[static_cast<size_t>(i)] = function.lo + (function.hi - function.lo)
+                                        * static_cast<float>((i * 7919) % n) / static_cast<float>(n);
+
+    const double ticksToNs = 1.0e9 / static_cast<double>(juce::Time::getHighResolutionTicksPerSecond());
+    const auto budget = static_cast<juce::int64>(config.seconds * 1.0e9 / ticksToNs);
+    juce::int64 elapsed = 0, values = 0;
+    float sink = 0.0f;
+
+    while (elapsed < budget)
+    {
+        const auto start = juce::Time::getHighResolutionTicks();
+        for (int repeat = 0; repeat < 64; ++repeat)
+        {
+            batch(input.data(), output.data(), n);
+            sink += output[static_cast<size_t>(repeat % n)];
+        }
+        elapsed += juce::Time::getHighResolutionTicks() - start;
+        values += 64 * static_cast<juce::int64>(n);
+    }
+
+    // Keep the timed work observable
+    static volatile float observed = 0.0f;
+    observed = sink;
+
+    result.nsPerValue = static_cast<double>(elapsed) * ticksToNs / static_cast<double>(values);
+    return result;
+}
+
+static std::vector<MathBenchResult> runAll(const MathBenchConfig& config)
+{
+    std::vector<MathBenchResult> results;
+    auto add = [&](const MathFunction& function, const char* variant, auto&& batch)
+    {
+        results.push_back(runKernel(function, variant, batch, config));
+        const auto& r = results.back();
+        std::cerr << r.function << " / " << r.variant << ": " << juce::String(r.nsPerValue, 3)
+                  << " ns/value, max error " << juce::String(r.maxError, 10) << std::endl;
+    };
+
+    add(sine, "table", [](const float* in, float* out, int n) { for (int i = 0; i < n; ++i) out[i] = LookupTables::fastSin(in[i]); });
+    add(sine, "libm", [](const float* in, float* out, int n) { for (int i = 0; i < n; ++i) out[i] = std::sin(in[i] * juce::MathConstants<float>::twoPi); });
+    add(sine, "fast", [](const float* in, float* out, int n) { MathKernels::Sine<Tier::Fast>::process(in, out, n); });
+    add(sine, "precise", [](const float* in, float* out, int n) { MathKernels::Sine<Tier::Precise>::process(in, out, n); });
+
+    add(cosine, "table", [](const float* in, float* out, int n) { for (int i = 0; i < n; ++i) out[i] = LookupTables::fastCos(in[i]); });
+    add(cosine, "libm", [](const float* in, float* out, int n) { for (int i = 0; i < n; ++i) out[i] = std::cos(in[i] * juce::MathConstants<float>::twoPi); });
+    add(cosine, "fast", [](const float* in, float* out, int n) { MathKernels::Cosine<Tier::Fast>::process(in, out, n); });
+    add(cosine, "precise", [](const float* in, float* out, int n) { MathKernels::Cosine<Tier::Precise>::process(in, out, n); });
+
+    add(tanhFn, "table", [](const float* in, float* out, int n) { for (int i = 0; i < n; ++i) out[i] = LookupTables::fastTanh(in[i]); });
+    add(tanhFn, "pade", [](const float* in, float* out, int n) { for (int i = 0; i < n; ++i) out[i] = LookupTables::fastTanhPoly(in[i]); });
+    add(tanhFn, "libm", [](const float* in, float* out, int n) { for (int i = 0; i < n; ++i) out[i] = std::tanh(in[i]); });
+    add(tanhFn, "fast", [](const float* in, float* out, int n) { MathKernels::Tanh<Tier::Fast>::process(in, out, n); });
+    add(tanhFn, "precise", [](const float* in, float* out, int n) { MathKernels::Tanh<Tier::Precise>::process(in, out, n); });
+
+    add(expFn, "table", [](const float* in, float* out, int n) { for (int i = 0; i < n; ++i) out[i] = LookupTables::fastExpDecay(in[i]); });
+    add(expFn, "libm", [](const float* in, float* out, int n) { for (int i = 0; i < n; ++i) out[i] = std::exp(in[i]); });
+    add(expFn, "fast", [](const float* in, float* out, int n) { MathKernels::Exp<Tier::Fast>::process(in, out, n); });
+    add(expFn, "precise", [](const float* in, float* out, int n) { MathKernels::Exp<Tier::Precise>::process(in, out, n); });
+
+    return results;
+}
+
+//==============================================================================
+// Report
+//==============================================================================
+
+static juce::var toJson(const MathBenchConfig& config, const std::vector<MathBenchResult>& results)
+{
+    juce::DynamicObject::Ptr root = new juce::DynamicObject();
+    root->setProperty("benchmark", "mathKernels");
+    root->setProperty("pluginVersion", JucePlugin_VersionString);
+   #if JUCE_DEBUG
+    root->setProperty("build", "debug");
+   #else
+    root->setProperty("build", "release");
+   #endif
+    root->setProperty("cpu", juce::SystemStats::getCpuModel());
+    root->setProperty("os", juce::SystemStats::getOperatingSystemName());
+    root->setProperty("batchSize", config.batchSize);
+    root->setProperty("secondsPerKernel", config.seconds);
+
+    juce::Array<juce::var> runs;
+    for (const auto& r : results)
+    {
+        juce::DynamicObject::Ptr run = new juce::DynamicObject();
+        run->setProperty("function", r.function);
+        run->setProperty("variant", r.variant);
+        run->setProperty("nsPerValue", r.nsPerValue);
+        run->setProperty("maxError", r.maxError);
+        runs.add(juce::var(run.get()));
+    }
+    root->setProperty("results", runs);
+
+    return juce::var(root.get());
+}
+
+//==============================================================================
+// Entry point
+//==============================================================================
+
+int main(int argc, char* argv[])
+{
+    juce::ScopedJuceInitialiser_GUI juceInit;
+
+    const juce::ArgumentList args(argc, argv);
+    const auto config = parseArguments(args);
+
+    const auto json = juce::JSON::toString(toJson(config, runAll(config)));
+
+    if (config.outputPath.isNotEmpty())
+    {
+        const auto file = juce::File::getCurrentWorkingDirectory().getChildFile(config.outputPath);
+        if (! file.replaceWithText(json))
+        {
+            std::cerr << "Could not write " << file.getFullPathName() << std::endl;
+            return 1;
+        }
+    }
+    else
+    {
+        std::cout << json << std::endl;
+    }
+
+    return 0;
+}
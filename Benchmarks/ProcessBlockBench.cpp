@@ -0,0 +1,342 @@
+/**
+ * Blackheart processBlock Benchmark
+ *
+ * Drives BlackheartAudioProcessor with a synthetic guitar signal across a
+ * matrix of sample rates, block sizes and parameter presets, and reports
+ * throughput and per-block timing as JSON (stdout, or --output=<file>).
+ *
+ * Options (comma-separated lists):
+ *   --rates=44100,48000     sample rates to run (default 44.1k-192k)
+ *   --blocks=32,256         block sizes to run (default 16-2048)
+ *   --presets=idle,panic    preset names to run (default all)
+ *   --seconds=2.0           audio rendered per run, excluding warm-up
+ *   --quick                 48k, 32/256 samples, all presets, 1 second
+ *   --output=bench.json     write JSON to a file instead of stdout
+ *
+ * Configure with -DBLACKHEART_PROFILE_STAGES=ON to add a per-stage timing
+ * breakdown (min/mean/max/histogram) to every result.
+ */
+
+#include "PluginProcessor.h"
+#include "../Tests/TestSignals.h"
+#include <algorithm>
+#include <iostream>
+#include <vector>
+
+//==============================================================================
+// Configuration
+//==============================================================================
+
+struct BenchPreset
+{
+    const char* name;
+    std::vector<std::pair<const char*, float>> values;  // denormalised parameter values
+};
+
+static const std::vector<BenchPreset>& getPresets()
+{
+    static const std::vector<BenchPreset> presets = {
+        { "idle",   { } },
+        { "scream", { { ParameterIDs::mode, 0.0f }, { ParameterIDs::gain, 0.8f } } },
+        { "od",     { { ParameterIDs::mode, 1.0f }, { ParameterIDs::gain, 0.8f } } },
+        { "doom",   { { ParameterIDs::mode, 2.0f }, { ParameterIDs::gain, 0.8f } } },
+        { "oct1",   { { ParameterIDs::octave1, 1.0f } } },
+        { "oct2",   { { ParameterIDs::octave2, 1.0f } } },
+        { "panic",  { { ParameterIDs::octave2, 1.0f }, { ParameterIDs::panic, 1.0f } } },
+        { "chaos",  { { ParameterIDs::octave1, 1.0f }, { ParameterIDs::chaos, 1.0f },
+                      { ParameterIDs::speed, 1.0f } } },
+    };
+    return presets;
+}
+
+struct BenchConfig
+{
+    std::vector<double> sampleRates { 44100.0, 48000.0, 88200.0, 96000.0, 176400.0, 192000.0 };
+    std::vector<int> blockSizes { 16, 32, 64, 128, 256, 512, 1024, 2048 };
+    std::vector<const BenchPreset*> presets;
+    double seconds = 2.0;
+    double warmupSeconds = 0.25;
+    juce::String outputPath;
+};
+
+static BenchConfig parseArguments(const juce::ArgumentList& args)
+{
+    BenchConfig config;
+
+    if (args.containsOption("--quick"))
+    {
+        config.sampleRates = { 48000.0 };
+        config.blockSizes = { 32, 256 };
+        config.seconds = 1.0;
+    }
+
+    if (args.containsOption("--rates"))
+    {
+        config.sampleRates.clear();
+        for (const auto& token : juce::StringArray::fromTokens(args.getValueForOption("--rates"), ",", ""))
+            if (token.getDoubleValue() > 0.0)
+                config.sampleRates.push_back(token.getDoubleValue());
+    }
+
+    if (args.containsOption("--blocks"))
+    {
+        config.blockSizes.clear();
+        for (const auto& token : juce::StringArray::fromTokens(args.getValueForOption("--blocks"), ",", ""))
+            if (token.getIntValue() > 0)
+                config.blockSizes.push_back(token.getIntValue());
+    }
+
+    const auto presetFilter = juce::StringArray::fromTokens(args.getValueForOption("--presets"), ",", "");
+    for (const auto& preset : getPresets())
+        if (presetFilter.isEmpty() || presetFilter.contains(preset.name))
+            config.presets.push_back(&preset);
+
+    if (args.containsOption("--seconds"))
+        config.seconds = juce::jmax(0.1, args.getValueForOption("--seconds").getDoubleValue());
+
+    config.outputPath = args.getValueForOption("--output");
+    return config;
+}
+
+//==============================================================================
+// Runner
+//==============================================================================
+
+struct BenchResult
+{
+    juce::String preset;
+    double sampleRate = 0.0;
+    int blockSize = 0;
+    int numBlocks = 0;
+    double nsPerSample = 0.0;
+    double realtimeFactor = 0.0;
+    double p50Us = 0.0;
+    double p99Us = 0.0;
+    double maxUs = 0.0;
+    juce::var stages;  // per-stage profile, void unless BLACKHEART_PROFILE_STAGES
+};
+
+static void applyPreset(BlackheartAudioProcessor& processor, const BenchPreset& preset)
+{
+    auto& apvts = processor.getAPVTS();
+    for (const auto& [id, value] : preset.values)
+        if (auto* param = apvts.getParameter(id))
+            param->setValueNotifyingHost(param->convertTo0to1(value));
+}
+
+static juce::var getStageProfile(DSP::StageProfiler& profiler)
+{
+    if (! DSP::StageProfiler::isEnabled())
+        return {};
+
+    juce::Array<juce::var> stages;
+    for (int i = 0; i < DSP::StageProfiler::numStages; ++i)
+    {
+        const auto stats = profiler.getStats(static_cast<DSP::StageProfiler::Stage>(i));
+
+        juce::DynamicObject::Ptr stage = new juce::DynamicObject();
+        stage->setProperty("name", DSP::StageProfiler::getStageName(i));
+        stage->setProperty("calls", static_cast<juce::int64>(stats.calls));
+        stage->setProperty("minNs", stats.minNs);
+        stage->setProperty("meanNs", stats.meanNs);
+        stage->setProperty("maxNs", stats.maxNs);
+        stage->setProperty("nsPerSample", stats.nsPerSample);
+
+        juce::Array<juce::var> histogram;
+        for (auto count : stats.histogram)
+            histogram.add(static_cast<juce::int64>(count));
+        stage->setProperty("histogram", histogram);
+
+        stages.add(juce::var(stage.get()));
+    }
+    return stages;
+}
+
+static double percentile(const std::vector<double>& sorted, double p)
+{
+    if (sorted.empty())
+        return 0.0;
+
+    const auto index = static_cast<size_t>(std::ceil(p * static_cast<double>(sorted.size() - 1)));
+    return sorted[std::min(index, sorted.size() - 1)];
+}
+
+static BenchResult runBenchmark(const BenchPreset& preset, double sampleRate, int blockSize,
+                                const BenchConfig& config, const juce::AudioBuffer<float>& signal)
+{
+    BlackheartAudioProcessor processor;
+    applyPreset(processor, preset);
+    processor.setNonRealtime(false);
+    processor.prepareToPlay(sampleRate, blockSize);
+
+    juce::AudioBuffer<float> buffer(2, blockSize);
+    juce::MidiBuffer midi;
+
+    const int warmupBlocks = juce::jmax(1, static_cast<int>(config.warmupSeconds * sampleRate) / blockSize);
+    const int timedBlocks = juce::jmax(1, static_cast<int>(config.seconds * sampleRate) / blockSize);
+    const int signalBlocks = signal.getNumSamples() / blockSize;
+
+    std::vector<double> blockNs;
+    blockNs.reserve(static_cast<size_t>(timedBlocks));
+
+    const double ticksToNs = 1.0e9 / static_cast<double>(juce::Time::getHighResolutionTicksPerSecond());
+    juce::int64 totalTicks = 0;
+
+    for (int block = 0; block < warmupBlocks + timedBlocks; ++block)
+    {
+        const int offset = (block % signalBlocks) * blockSize;
+        for (int ch = 0; ch < 2; ++ch)
+            buffer.copyFrom(ch, 0, signal, ch, offset, blockSize);
+
+        const auto start = juce::Time::getHighResolutionTicks();
+        processor.processBlock(buffer, midi);
+        const auto elapsed = juce::Time::getHighResolutionTicks() - start;
+
+        // Stage profile covers the timed blocks only
+        if (block == warmupBlocks - 1)
+            processor.getStageProfiler().reset();
+
+        if (block >= warmupBlocks)
+        {
+            totalTicks += elapsed;
+            blockNs.push_back(static_cast<double>(elapsed) * ticksToNs);
+        }
+    }
+
+    const auto stageProfile = getStageProfile(processor.getStageProfiler());
+    processor.releaseResources();
+
+    std::sort(blockNs.begin(), blockNs.end());
+
+    BenchResult result;
+    result.preset = preset.name;
+    result.sampleRate = sampleRate;
+    result.blockSize = blockSize;
+    result.numBlocks = timedBlocks;
+
+    const double totalNs = static_cast<double>(totalTicks) * ticksToNs;
+    const double totalSamples = static_cast<double>(timedBlocks) * blockSize;
+    const double audioNs = totalSamples / sampleRate * 1.0e9;
+
+    result.nsPerSample = totalNs / totalSamples;
+    result.realtimeFactor = totalNs > 0.0 ? audioNs / totalNs : 0.0;
+    result.p50Us = percentile(blockNs, 0.50) * 1.0e-3;
+    result.p99Us = percentile(blockNs, 0.99) * 1.0e-3;
+    result.maxUs = blockNs.empty() ? 0.0 : blockNs.back() * 1.0e-3;
+    result.stages = stageProfile;
+    return result;
+}
+
+//==============================================================================
+// Report
+//==============================================================================
+
+static juce::var toJson(const BenchConfig& config, const std::vector<BenchResult>& results)
+{
+    juce::DynamicObject::Ptr root = new juce::DynamicObject();
+    root->setProperty("benchmark", "processBlock");
+    root->setProperty("pluginVersion", JucePlugin_VersionString);
+    root->setProperty("juceVersion", juce::SystemStats::getJUCEVersion());
+   #if JUCE_DEBUG
+    root->setProperty("build", "debug");
+   #else
+    root->setProperty("build", "release");
+   #endif
+    root->setProperty("cpu", juce::SystemStats::getCpuModel());
+    root->setProperty("numCpus", juce::SystemStats::getNumCpus());
+    root->setProperty("os", juce::SystemStats::getOperatingSystemName());
+    root->setProperty("timestamp", juce::Time::getCurrentTime().toISO8601(true));
+    root->setProperty("secondsPerRun", config.seconds);
+    root->setProperty("stageProfiling", DSP::StageProfiler::isEnabled());
+    if (DSP::StageProfiler::isEnabled())
+    {
+        juce::Array<juce::var> bucketStarts;
+        for (int b = 0; b < DSP::StageProfiler::numHistogramBuckets; ++b)
+            bucketStarts.add(DSP::StageProfiler::getHistogramBucketStartNs(b));
+        root->setProperty("histogramBucketStartNs", bucketStarts);
+    }
+
+    juce::Array<juce::var> runs;
+    for (const auto& r : results)
+    {
+        juce::DynamicObject::Ptr run = new juce::DynamicObject();
+        run->setProperty("preset", r.preset);
+        run->setProperty("sampleRate", r.sampleRate);
+        run->setProperty("blockSize", r.blockSize);
+        run->setProperty("blocks", r.numBlocks);
+        run->setProperty("nsPerSample", r.nsPerSample);
+        run->setProperty("realtimeFactor", r.realtimeFactor);
+
+        juce::DynamicObject::Ptr blockUs = new juce::DynamicObject();
+        blockUs->setProperty("p50", r.p50Us);
+        blockUs->setProperty("p99", r.p99Us);
+        blockUs->setProperty("max", r.maxUs);
+        run->setProperty("blockUs", juce::var(blockUs.get()));
+
+        if (! r.stages.isVoid())
+            run->setProperty("stages", r.stages);
+
+        runs.add(juce::var(run.get()));
+    }
+    root->setProperty("results", runs);
+
+    return juce::var(root.get());
+}
+
+//==============================================================================
+// Entry point
+//==============================================================================
+
+int main(int argc, char* argv[])
+{
+    juce::ScopedJuceInitialiser_GUI juceInit;
+
+    const juce::ArgumentList args(argc, argv);
+    const auto config = parseArguments(args);
+
+    if (config.sampleRates.empty() || config.blockSizes.empty() || config.presets.empty())
+    {
+        std::cerr << "Nothing to run — check --rates, --blocks and --presets" << std::endl;
+        return 1;
+    }
+
+    std::vector<BenchResult> results;
+
+    for (double sampleRate : config.sampleRates)
+    {
+        // 4 seconds of source material, looped for longer runs
+        const auto signal = TestSignals::renderGuitarSignal(sampleRate, static_cast<int>(4.0 * sampleRate));
+
+        for (int blockSize : config.blockSizes)
+        {
+            for (const auto* preset : config.presets)
+            {
+                const auto result = runBenchmark(*preset, sampleRate, blockSize, config, signal);
+
+                std::cerr << preset->name << " @ " << static_cast<int>(sampleRate) << " Hz / "
+                          << blockSize << ": " << juce::String(result.nsPerSample, 2) << " ns/sample, "
+                          << juce::String(result.realtimeFactor, 1) << "x realtime" << std::endl;
+
+                results.push_back(result);
+            }
+        }
+    }
+
+    const auto json = juce::JSON::toString(toJson(config, results));
+
+    if (config.outputPath.isNotEmpty())
+    {
+        const auto file = juce::File::getCurrentWorkingDirectory().getChildFile(config.outputPath);
+        if (! file.replaceWithText(json))
+        {
+            std::cerr << "Could not write " << file.getFullPathName() << std::endl;
+            return 1;
+        }
+    }
+    else
+    {
+        std::cout << json << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,186 @@
+#include "AnalysisBus.h"
+#include <cstring>
+#include <limits>
+
+namespace DSP
+{
+
+namespace
+{
+    void clearFrame(AnalysisBus::Frame& frame) noexcept
+    {
+        frame.minimum.fill(std::numeric_limits<float>::max());
+        frame.maximum.fill(std::numeric_limits<float>::lowest());
+    }
+}
+
+void AnalysisBus::prepare(double sampleRate, int maxBlockSize)
+{
+    jassert(sampleRate > 0.0 && maxBlockSize > 0);
+
+    samplesPerFrame = juce::jmax(1, juce::roundToInt(sampleRate / frameRateHz));
+
+    // A block touches at most every whole frame it spans plus the carried one
+    staging.resize(static_cast<size_t>(juce::jmax(1, maxBlockSize) / samplesPerFrame + 2));
+
+    reset();
+}
+
+void AnalysisBus::reset() noexcept
+{
+    writePosition.store(0, std::memory_order_relaxed);
+    readPosition.store(0, std::memory_order_relaxed);
+    framesWritten.store(0, std::memory_order_relaxed);
+    framesDropped.store(0, std::memory_order_relaxed);
+
+    blockSamples = 0;
+    samplesIntoFrame = 0;
+    numStagedFrames = 0;
+
+    for (auto& frame : staging)
+        clearFrame(frame);
+}
+
+void AnalysisBus::beginBlock(int numSamples) noexcept
+{
+    blockSamples = juce::jmax(0, numSamples);
+
+    const int framesTouched = (samplesIntoFrame + blockSamples + samplesPerFrame - 1) / samplesPerFrame;
+    jassert(framesTouched <= static_cast<int>(staging.size()));
+    numStagedFrames = juce::jmin(framesTouched, static_cast<int>(staging.size()));
+
+    // Frame 0 already holds the partial frame from the previous block
+    for (int f = 1; f < numStagedFrames; ++f)
+        clearFrame(staging[static_cast<size_t>(f)]);
+}
+
+void AnalysisBus::capture(Probe probe, const float* data, int oversampling) noexcept
+{
+    jassert(data != nullptr && oversampling >= 1);
+    const auto p = static_cast<size_t>(probe);
+
+    int offset = 0;
+    int fill = samplesIntoFrame;
+
+    for (int f = 0; f < numStagedFrames && offset < blockSamples; ++f)
+    {
+        const int run = juce::jmin(samplesPerFrame - fill, blockSamples - offset);
+        const auto range = juce::FloatVectorOperations::findMinAndMax(data + offset * oversampling,
+                                                                      run * oversampling);
+        auto& frame = staging[static_cast<size_t>(f)];
+        frame.minimum[p] = juce::jmin(frame.minimum[p], range.getStart());
+        frame.maximum[p] = juce::jmax(frame.maximum[p], range.getEnd());
+
+        offset += run;
+        fill = 0;
+    }
+}
+
+void AnalysisBus::captureValue(Probe probe, float value) noexcept
+{
+    const auto p = static_cast<size_t>(probe);
+
+    for (int f = 0; f < numStagedFrames; ++f)
+    {
+        auto& frame = staging[static_cast<size_t>(f)];
+        frame.minimum[p] = juce::jmin(frame.minimum[p], value);
+        frame.maximum[p] = juce::jmax(frame.maximum[p], value);
+    }
+}
+
+void AnalysisBus::endBlock() noexcept
+{
+    const int totalFill = samplesIntoFrame + blockSamples;
+    const int completed = juce::jmin(totalFill / samplesPerFrame, numStagedFrames);
+
+    // Probes skipped this block (idle paths, test mode) read as silence
+    for (int f = 0; f < completed; ++f)
+    {
+        auto& frame = staging[static_cast<size_t>(f)];
+        for (size_t p = 0; p < static_cast<size_t>(numProbes); ++p)
+        {
+            if (frame.minimum[p] > frame.maximum[p])
+                frame.minimum[p] = frame.maximum[p] = 0.0f;
+        }
+    }
+
+    publish(staging.data(), completed);
+
+    if (completed < numStagedFrames)
+        staging[0] = staging[static_cast<size_t>(completed)];
+    else if (! staging.empty())
+        clearFrame(staging[0]);
+
+    samplesIntoFrame = totalFill % samplesPerFrame;
+    blockSamples = 0;
+    numStagedFrames = 0;
+}
+
+void AnalysisBus::publish(const Frame* frames, int numFrames) noexcept
+{
+    if (numFrames <= 0)
+        return;
+
+    const auto write = writePosition.load(std::memory_order_relaxed);
+    const auto read = readPosition.load(std::memory_order_acquire);
+    const int space = capacity - static_cast<int>(write - read);
+    const int toWrite = juce::jmin(numFrames, space);
+
+    if (toWrite < numFrames)
+        framesDropped.store(framesDropped.load(std::memory_order_relaxed) + static_cast<juce::uint64>(numFrames - toWrite),
+                            std::memory_order_relaxed);
+
+    if (toWrite <= 0)
+        return;
+
+    const int start = static_cast<int>(write & indexMask);
+    const int firstRun = juce::jmin(toWrite, capacity - start);
+
+    std::memcpy(&ring[static_cast<size_t>(start)], frames, sizeof(Frame) * static_cast<size_t>(firstRun));
+    if (toWrite > firstRun)
+        std::memcpy(&ring[0], frames + firstRun, sizeof(Frame) * static_cast<size_t>(toWrite - firstRun));
+
+    writePosition.store(write + static_cast<juce::uint32>(toWrite), std::memory_order_release);
+    framesWritten.store(framesWritten.load(std::memory_order_relaxed) + static_cast<juce::uint64>(toWrite),
+                        std::memory_order_relaxed);
+}
+
+int AnalysisBus::getNumReady() const noexcept
+{
+    return static_cast<int>(writePosition.load(std::memory_order_acquire)
+                            - readPosition.load(std::memory_order_relaxed));
+}
+
+int AnalysisBus::read(Frame* destination, int maxFrames) noexcept
+{
+    jassert(destination != nullptr || maxFrames <= 0);
+
+    const auto write = writePosition.load(std::memory_order_acquire);
+    const auto readPos = readPosition.load(std::memory_order_relaxed);
+    const int numToRead = juce::jmin(juce::jmax(0, maxFrames), static_cast<int>(write - readPos));
+
+    if (numToRead <= 0)
+        return 0;
+
+    const int start = static_cast<int>(readPos & indexMask);
+    const int firstRun = juce::jmin(numToRead, capacity - start);
+
+    std::memcpy(destination, &ring[static_cast<size_t>(start)], sizeof(Frame) * static_cast<size_t>(firstRun));
+    if (numToRead > firstRun)
+        std::memcpy(destination + firstRun, &ring[0], sizeof(Frame) * static_cast<size_t>(numToRead - firstRun));
+
+    readPosition.store(readPos + static_cast<juce::uint32>(numToRead), std::memory_order_release);
+    return numToRead;
+}
+
+void AnalysisBus::discardAllBut(int numToKeep) noexcept
+{
+    const auto write = writePosition.load(std::memory_order_acquire);
+    const auto readPos = readPosition.load(std::memory_order_relaxed);
+    const int keep = juce::jmax(0, numToKeep);
+
+    if (static_cast<int>(write - readPos) > keep)
+        readPosition.store(write - static_cast<juce::uint32>(keep), std::memory_order_release);
+}
+
+} // namespace DSP
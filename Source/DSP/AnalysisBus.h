@@ -0,0 +1,107 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include <atomic>
+#include <vector>
+
+namespace DSP
+{
+
+/**
+ * Single-producer/single-consumer bus of decimated analysis frames.
+ *
+ * The audio thread captures whole blocks per probe (first channel only);
+ * each frame holds the min and max of every probe over a fixed span of
+ * samples, so the frame rate depends on the sample rate only, never on the
+ * host block size. Completed frames are published once per block with a
+ * bulk copy into a power-of-two ring.
+ *
+ * When the consumer falls behind, new frames are dropped (never written
+ * over unread ones) and counted in getNumDroppedFrames(). Any one thread
+ * may consume: the editor, or a headless test draining it after a render.
+ */
+class AnalysisBus
+{
+public:
+    enum Probe
+    {
+        input = 0,
+        postFuzz,
+        postOctave,
+        output,
+        gateGain,
+        chaosMod,
+        numProbes
+    };
+
+    struct Frame
+    {
+        std::array<float, numProbes> minimum {};
+        std::array<float, numProbes> maximum {};
+    };
+
+    static constexpr double frameRateHz = 2000.0;
+    static constexpr int capacity = 4096;    // Frames, ~2s at frameRateHz
+
+    AnalysisBus() = default;
+
+    static const char* getProbeName(int probe) noexcept
+    {
+        static constexpr const char* names[numProbes] = {
+            "Input", "PostFuzz", "PostOctave", "Output", "GateGain", "ChaosMod"
+        };
+        return probe >= 0 && probe < numProbes ? names[probe] : "";
+    }
+
+    // Allocates staging storage and clears the ring — prepareToPlay only
+    void prepare(double sampleRate, int maxBlockSize);
+    void reset() noexcept;
+
+    //==========================================================================
+    // Audio thread
+    void beginBlock(int numSamples) noexcept;
+    // Block of numSamples * oversampling values (oversampled probes are
+    // reduced over the same spans of native samples)
+    void capture(Probe probe, const float* data, int oversampling = 1) noexcept;
+    // Block-rate probes: one value for the whole block
+    void captureValue(Probe probe, float value) noexcept;
+    void endBlock() noexcept;
+
+    //==========================================================================
+    // Consumer thread
+    int getNumReady() const noexcept;
+    // Copies up to maxFrames of the oldest unread frames; returns the count
+    int read(Frame* destination, int maxFrames) noexcept;
+    // Drops the oldest frames so at most numToKeep stay unread
+    void discardAllBut(int numToKeep) noexcept;
+
+    // Any thread
+    juce::uint64 getNumFramesWritten() const noexcept { return framesWritten.load(std::memory_order_relaxed); }
+    juce::uint64 getNumDroppedFrames() const noexcept { return framesDropped.load(std::memory_order_relaxed); }
+    int getSamplesPerFrame() const noexcept { return samplesPerFrame; }
+
+private:
+    static_assert((capacity & (capacity - 1)) == 0, "capacity must be a power of two");
+    static constexpr juce::uint32 indexMask = static_cast<juce::uint32>(capacity - 1);
+
+    void publish(const Frame* frames, int numFrames) noexcept;
+
+    std::array<Frame, capacity> ring {};
+    std::atomic<juce::uint32> writePosition { 0 };   // Monotonic, wraps with uint32
+    std::atomic<juce::uint32> readPosition { 0 };
+    std::atomic<juce::uint64> framesWritten { 0 };
+    std::atomic<juce::uint64> framesDropped { 0 };
+
+    // Audio-thread staging: frames touched by the current block, the first
+    // continuing the partial frame left by the previous block
+    std::vector<Frame> staging;
+    int samplesPerFrame = 24;
+    int blockSamples = 0;
+    int samplesIntoFrame = 0;   // Of the partial frame carried between blocks
+    int numStagedFrames = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(AnalysisBus)
+};
+
+} // namespace DSP
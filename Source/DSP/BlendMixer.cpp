@@ -9,19 +9,12 @@ void BlendMixer::prepare(const juce::dsp::ProcessSpec& spec)
     sampleRate = spec.sampleRate;
     maxBlockSize = static_cast<int>(spec.maximumBlockSize);
 
-    // Initialize lookup tables (thread-safe, only runs once)
-    LookupTables::initialize();
-
-    const double smoothingTime = 0.03;
-    blend.reset(sampleRate, smoothingTime);
-
     lastDryGain = 1.0f;
     lastWetGain = 0.0f;
 }
 
 void BlendMixer::reset()
 {
-    blend.reset(sampleRate, 0.03);
     lastDryGain = 1.0f;
     lastWetGain = 0.0f;
 }
@@ -32,46 +25,42 @@ void BlendMixer::calculateGains(float blendValue, float& dryGain, float& wetGain
     LookupTables::equalPowerGains(blendValue, dryGain, wetGain);
 }
 
-void BlendMixer::process(const juce::AudioBuffer<float>& dryBuffer,
-                         const juce::AudioBuffer<float>& wetBuffer,
-                         juce::AudioBuffer<float>& outputBuffer)
+void BlendMixer::process(const juce::AudioBuffer<float>& dryBuffer, juce::AudioBuffer<float>& wetBuffer)
 {
-    const int numSamples = outputBuffer.getNumSamples();
-    const int numChannels = outputBuffer.getNumChannels();
+    const int numSamples = wetBuffer.getNumSamples();
+    const int numChannels = wetBuffer.getNumChannels();
 
     jassert(dryBuffer.getNumSamples() >= numSamples);
-    jassert(wetBuffer.getNumSamples() >= numSamples);
     jassert(dryBuffer.getNumChannels() >= numChannels);
-    jassert(wetBuffer.getNumChannels() >= numChannels);
+    jassert(blend.isStatic() || blend.numSamples >= numSamples);
 
-    // Check if blend is smoothing for optimized path
-    if (!blend.isSmoothing())
+    // Static blend takes the SIMD block path
+    if (blend.isStatic())
     {
-        const float currentBlend = blend.getTargetValue();
+        const float currentBlend = blend.value;
         float dryGain, wetGain;
         calculateGains(currentBlend, dryGain, wetGain);
 
         lastDryGain = dryGain;
         lastWetGain = wetGain;
 
-        // SIMD-optimized block processing
+        // One fused pass per channel; same products and sum as scaling the
+        // dry copy and accumulating the wet on top
         for (int channel = 0; channel < numChannels; ++channel)
         {
-            float* output = outputBuffer.getWritePointer(channel);
+            float* wet = wetBuffer.getWritePointer(channel);
             const float* dry = dryBuffer.getReadPointer(channel);
-            const float* wet = wetBuffer.getReadPointer(channel);
 
-            // Use SIMD operations for bulk processing
-            juce::FloatVectorOperations::copyWithMultiply(output, dry, dryGain, numSamples);
-            juce::FloatVectorOperations::addWithMultiply(output, wet, wetGain, numSamples);
+            for (int i = 0; i < numSamples; ++i)
+                wet[i] = dry[i] * dryGain + wet[i] * wetGain;
         }
     }
     else
     {
-        // Per-sample processing when smoothing
+        // Per-sample processing while ramping
         for (int sample = 0; sample < numSamples; ++sample)
         {
-            const float currentBlend = blend.getNextValue();
+            const float currentBlend = blend.values[sample];
 
             float dryGain, wetGain;
             calculateGains(currentBlend, dryGain, wetGain);
@@ -83,16 +72,18 @@ void BlendMixer::process(const juce::AudioBuffer<float>& dryBuffer,
             {
                 const float drySample = dryBuffer.getSample(channel, sample);
                 const float wetSample = wetBuffer.getSample(channel, sample);
-                const float mixed = drySample * dryGain + wetSample * wetGain;
-                outputBuffer.setSample(channel, sample, mixed);
+                wetBuffer.setSample(channel, sample, drySample * dryGain + wetSample * wetGain);
             }
         }
     }
+
+    // Ramp array is only valid for this call
+    blend = RampBlock::constant(blend.value);
 }
 
 void BlendMixer::setBlend(float normalizedBlend)
 {
-    blend.setTargetValue(juce::jlimit(0.0f, 1.0f, normalizedBlend));
+    blend = RampBlock::constant(juce::jlimit(0.0f, 1.0f, normalizedBlend));
 }
 
 } // namespace DSP
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include "ParameterRamp.h"
 
 namespace DSP
 {
@@ -13,13 +14,15 @@ public:
 
     void prepare(const juce::dsp::ProcessSpec& spec);
     void reset();
-    void process(const juce::AudioBuffer<float>& dryBuffer,
-                 const juce::AudioBuffer<float>& wetBuffer,
-                 juce::AudioBuffer<float>& outputBuffer);
+    // In place: wetBuffer holds the wet signal and receives the mix, so the
+    // chain needs no staging copy of the wet path
+    void process(const juce::AudioBuffer<float>& dryBuffer, juce::AudioBuffer<float>& wetBuffer);
 
     void setBlend(float normalizedBlend);
+    // Blend ramp for the next process() call; array valid until it returns
+    void setBlendRamp(const RampBlock& blendRamp) noexcept { blend = blendRamp; }
 
-    float getCurrentBlend() const { return blend.getTargetValue(); }
+    float getCurrentBlend() const { return blend.value; }
     float getDryGain() const { return lastDryGain; }
     float getWetGain() const { return lastWetGain; }
 
@@ -29,7 +32,7 @@ private:
     double sampleRate = 44100.0;
     int maxBlockSize = 512;
 
-    juce::SmoothedValue<float> blend { 0.7f };
+    RampBlock blend = RampBlock::constant(0.7f);
 
     float lastDryGain = 0.0f;
     float lastWetGain = 1.0f;
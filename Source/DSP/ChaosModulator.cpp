@@ -7,12 +7,9 @@ namespace DSP
 void ChaosModulator::prepare(const juce::dsp::ProcessSpec& spec)
 {
     sampleRate = spec.sampleRate;
+    inverseSampleRate = static_cast<float>(1.0 / sampleRate);
 
-    // Initialize lookup tables (thread-safe, only runs once)
-    LookupTables::initialize();
-
-    speed.reset(sampleRate, 0.05);
-    chaos.reset(sampleRate, 0.03);
+    currentSpeedHz = speedToHz(speed.value);
 
     setEnvelopeAttack(defaultAttackMs);
     setEnvelopeRelease(defaultReleaseMs);
@@ -20,9 +17,10 @@ void ChaosModulator::prepare(const juce::dsp::ProcessSpec& spec)
     sampleAndHoldSmoothCoeff = std::exp(-1.0f / (static_cast<float>(sampleRate) * shSmoothMs * 0.001f));
     dynamicSHSmoothCoeff = sampleAndHoldSmoothCoeff;
     randomWalkSmoothCoeff = std::exp(-1.0f / (static_cast<float>(sampleRate) * randomWalkSmoothMs * 0.001f));
+    updateControlCoefficients();
 
     lfoPhase = 0.0f;
-    lfoPhaseIncrement = 2.0f / static_cast<float>(sampleRate);
+    lfoPhaseIncrement = 2.0f * inverseSampleRate;
 
     sampleAndHoldValue = 0.0f;
     sampleAndHoldTarget = 0.0f;
@@ -45,13 +43,14 @@ void ChaosModulator::prepare(const juce::dsp::ProcessSpec& spec)
     noisePhase = 0.0f;
     noiseSmoothValue = 0.0f;
 
+    samplesUntilControl = 0;
+    controlTarget = controlRamp = controlStep = ModulationOutput();
     currentOutput = ModulationOutput();
 }
 
 void ChaosModulator::reset()
 {
-    speed.reset(sampleRate, 0.05);
-    chaos.reset(sampleRate, 0.03);
+    currentSpeedHz = speedToHz(speed.value);
 
     lfoPhase = 0.0f;
     sampleAndHoldValue = 0.0f;
@@ -68,6 +67,8 @@ void ChaosModulator::reset()
     smoothedEnvelopeInfluence = 0.0f;
     effectiveChaosAmount = 0.0f;
 
+    samplesUntilControl = 0;
+    controlTarget = controlRamp = controlStep = ModulationOutput();
     currentOutput = ModulationOutput();
 }
 
@@ -106,7 +107,7 @@ float ChaosModulator::applyResponseCurve(float input) const
     }
 }
 
-void ChaosModulator::updateEnvelopeSmoothing(float rawEnvelope)
+float ChaosModulator::getEnvelopeTarget(float rawEnvelope) const
 {
     float scaledEnvelope = rawEnvelope;
 
@@ -122,13 +123,16 @@ void ChaosModulator::updateEnvelopeSmoothing(float rawEnvelope)
     scaledEnvelope *= envelopeSensitivity;
     scaledEnvelope = juce::jlimit(0.0f, 1.0f, scaledEnvelope);
 
-    const float curvedEnvelope = applyResponseCurve(scaledEnvelope);
+    return applyResponseCurve(scaledEnvelope);
+}
 
-    const float coeff = (curvedEnvelope > smoothedEnvelopeInfluence)
-                        ? envelopeAttackCoeff
-                        : envelopeReleaseCoeff;
+void ChaosModulator::updateEnvelopeSmoothing(float envelopeTarget, const StepCoefficients& coeffs)
+{
+    const float coeff = (envelopeTarget > smoothedEnvelopeInfluence)
+                        ? coeffs.envelopeAttack
+                        : coeffs.envelopeRelease;
 
-    smoothedEnvelopeInfluence += coeff * (curvedEnvelope - smoothedEnvelopeInfluence);
+    smoothedEnvelopeInfluence += coeff * (envelopeTarget - smoothedEnvelopeInfluence);
 
     // Guard against NaN propagation from upstream envelope processing.
     // Once NaN enters smoothedEnvelopeInfluence, it permanently corrupts
@@ -195,7 +199,7 @@ void ChaosModulator::updateSampleAndHold()
                            sampleAndHoldValue * (1.0f - dynamicSHSmoothCoeff);
 }
 
-void ChaosModulator::updateRandomWalk()
+void ChaosModulator::updateRandomWalk(float smoothCoeff)
 {
     if (randomWalkPhase >= 1.0f)
     {
@@ -205,27 +209,187 @@ void ChaosModulator::updateRandomWalk()
         randomWalkTarget = juce::jlimit(-1.0f, 1.0f, randomWalkValue + step);
     }
 
-    randomWalkValue = randomWalkValue * randomWalkSmoothCoeff +
-                     randomWalkTarget * (1.0f - randomWalkSmoothCoeff);
+    randomWalkValue = randomWalkValue * smoothCoeff +
+                     randomWalkTarget * (1.0f - smoothCoeff);
 }
 
 void ChaosModulator::process(int numSamples)
 {
-    for (int i = 0; i < numSamples; ++i)
+    advance(nullptr, nullptr, nullptr, numSamples);
+}
+
+void ChaosModulator::processToBuffers(float* pitchMod, float* grainMod, float* timingMod, int numSamples)
+{
+    jassert(pitchMod != nullptr && grainMod != nullptr && timingMod != nullptr);
+    advance(pitchMod, grainMod, timingMod, numSamples);
+}
+
+void ChaosModulator::advance(float* pitchMod, float* grainMod, float* timingMod, int numSamples)
+{
+    const float speedStep = beginSpeedRamp(numSamples);
+    const float envelopeTarget = getEnvelopeTarget(rawEnvelopeValue);
+    const bool writeBuffers = pitchMod != nullptr;
+
+    int i = 0;
+    while (i < numSamples)
+    {
+        if (samplesUntilControl <= 0)
+        {
+            // Step the generators a whole interval ahead and ramp toward the
+            // result; the interval's worth of lag is inaudible at sub-audio rates
+            controlRamp = controlTarget;
+            generateNext(chaos[i], envelopeTarget, controlInterval, perControl);
+            controlTarget = currentOutput;
+
+            const float inverseInterval = 1.0f / static_cast<float>(controlInterval);
+            controlStep.pitchMod = (controlTarget.pitchMod - controlRamp.pitchMod) * inverseInterval;
+            controlStep.grainSizeMod = (controlTarget.grainSizeMod - controlRamp.grainSizeMod) * inverseInterval;
+            controlStep.timingMod = (controlTarget.timingMod - controlRamp.timingMod) * inverseInterval;
+            samplesUntilControl = controlInterval;
+        }
+
+        const int run = std::min(samplesUntilControl, numSamples - i);
+        const bool landsOnTarget = run == samplesUntilControl;
+
+        if (writeBuffers)
+        {
+            // Locals so the fill vectorizes (members would alias the outputs)
+            const float pitchStart = controlRamp.pitchMod, pitchStep = controlStep.pitchMod;
+            const float grainStart = controlRamp.grainSizeMod, grainStep = controlStep.grainSizeMod;
+            const float timingStart = controlRamp.timingMod, timingStep = controlStep.timingMod;
+            float* const pitchOut = pitchMod + i;
+            float* const grainOut = grainMod + i;
+            float* const timingOut = timingMod + i;
+
+            for (int k = 0; k < run; ++k)
+                pitchOut[k] = pitchStart + pitchStep * static_cast<float>(k + 1);
+            for (int k = 0; k < run; ++k)
+                grainOut[k] = grainStart + grainStep * static_cast<float>(k + 1);
+            for (int k = 0; k < run; ++k)
+                timingOut[k] = timingStart + timingStep * static_cast<float>(k + 1);
+
+            if (landsOnTarget)
+            {
+                pitchMod[i + run - 1] = controlTarget.pitchMod;
+                grainMod[i + run - 1] = controlTarget.grainSizeMod;
+                timingMod[i + run - 1] = controlTarget.timingMod;
+            }
+        }
+
+        if (landsOnTarget)
+        {
+            controlRamp = controlTarget;
+        }
+        else
+        {
+            const float t = static_cast<float>(run);
+            controlRamp.pitchMod += controlStep.pitchMod * t;
+            controlRamp.grainSizeMod += controlStep.grainSizeMod * t;
+            controlRamp.timingMod += controlStep.timingMod * t;
+        }
+
+        currentSpeedHz += speedStep * static_cast<float>(run);
+        samplesUntilControl -= run;
+        i += run;
+    }
+
+    currentOutput.pitchMod = controlRamp.pitchMod;
+    currentOutput.grainSizeMod = controlRamp.grainSizeMod;
+    currentOutput.timingMod = controlRamp.timingMod;
+    currentOutput.combinedMod = (controlRamp.pitchMod + controlRamp.grainSizeMod + controlRamp.timingMod) * 0.333333f;
+
+    endBlock();
+}
+
+float ChaosModulator::beginSpeedRamp(int numSamples) noexcept
+{
+    const float targetHz = speedToHz(speed.value);
+
+    if (speed.isStatic() || numSamples <= 0)
     {
-        getNextModulationValue();
+        currentSpeedHz = targetHz;
+        return 0.0f;
     }
+
+    return (targetHz - currentSpeedHz) / static_cast<float>(numSamples);
 }
 
-void ChaosModulator::processToBuffers(float* pitchMod, float* grainMod, float* timingMod, int numSamples)
+void ChaosModulator::endBlock() noexcept
+{
+    // Land exactly on the ramp end; arrays are only valid for this call
+    currentSpeedHz = speedToHz(speed.value);
+    speed = RampBlock::constant(speed.value);
+    chaos = RampBlock::constant(chaos.value);
+}
+
+void ChaosModulator::skip(int numSamples)
 {
-    for (int i = 0; i < numSamples; ++i)
+    if (numSamples <= 0)
+        return;
+
+    endBlock();
+
+    // One-pole envelope smoothing over n samples in closed form
+    const float curvedEnvelope = getEnvelopeTarget(rawEnvelopeValue);
+    const float coeff = (curvedEnvelope > smoothedEnvelopeInfluence)
+                        ? envelopeAttackCoeff
+                        : envelopeReleaseCoeff;
+    const float blockCoeff = 1.0f - std::pow(1.0f - coeff, static_cast<float>(numSamples));
+    smoothedEnvelopeInfluence += blockCoeff * (curvedEnvelope - smoothedEnvelopeInfluence);
+    if (!std::isfinite(smoothedEnvelopeInfluence))
+        smoothedEnvelopeInfluence = 0.0f;
+
+    effectiveChaosAmount = chaos.value
+                         * (minChaosAtLowEnvelope + smoothedEnvelopeInfluence * (1.0f - minChaosAtLowEnvelope));
+
+    // Phases advance at the base speed (cross-modulation is a per-sample detail
+    // nobody hears while the pitch section is bypassed)
+    const float cycles = currentSpeedHz * static_cast<float>(numSamples) * inverseSampleRate;
+
+    lfoPhase += cycles;
+    lfoPhase -= std::floor(lfoPhase);
+    if (!std::isfinite(lfoPhase))
+        lfoPhase = 0.0f;
+
+    noisePhase = std::fmod(noisePhase + cycles * 4.0f, static_cast<float>(noiseTableSize));
+    if (!std::isfinite(noisePhase))
+        noisePhase = 0.0f;
+
+    // S&H and random walk keep stepping too. A block spans at most a couple
+    // of their periods, so only the last two draws can still be heard
+    const float chaosSquared = effectiveChaosAmount * effectiveChaosAmount;
+    sampleAndHoldPhase += cycles * (0.5f + chaosSquared * 3.0f);
+    randomWalkPhase += cycles * 0.25f;
+    if (!std::isfinite(sampleAndHoldPhase) || !std::isfinite(randomWalkPhase))
+        sampleAndHoldPhase = randomWalkPhase = 0.0f;
+
+    const int sampleAndHoldWraps = static_cast<int>(sampleAndHoldPhase);
+    sampleAndHoldPhase -= static_cast<float>(sampleAndHoldWraps);
+    for (int wrap = 0; wrap < std::min(sampleAndHoldWraps, 2); ++wrap)
+    {
+        sampleAndHoldValue = sampleAndHoldTarget;
+        sampleAndHoldTarget = random.nextFloat() * 2.0f - 1.0f;
+    }
+
+    const int randomWalkWraps = static_cast<int>(randomWalkPhase);
+    randomWalkPhase -= static_cast<float>(randomWalkWraps);
+    for (int wrap = 0; wrap < std::min(randomWalkWraps, 2); ++wrap)
     {
-        getNextModulationValue();
-        pitchMod[i] = currentOutput.pitchMod;
-        grainMod[i] = currentOutput.grainSizeMod;
-        timingMod[i] = currentOutput.timingMod;
+        const float step = (random.nextFloat() * 2.0f - 1.0f) * 0.3f;
+        randomWalkTarget = juce::jlimit(-1.0f, 1.0f, randomWalkValue + step);
     }
+
+    // Both smoothers settle toward their latest target over the block
+    const float blockSamples = static_cast<float>(numSamples);
+    const float sampleAndHoldDecay = std::pow(sampleAndHoldSmoothCoeff, blockSamples);
+    sampleAndHoldSmoothed = sampleAndHoldValue + (sampleAndHoldSmoothed - sampleAndHoldValue) * sampleAndHoldDecay;
+    const float randomWalkDecay = std::pow(randomWalkSmoothCoeff, blockSamples);
+    randomWalkValue = randomWalkTarget + (randomWalkValue - randomWalkTarget) * randomWalkDecay;
+
+    // Resume ramps in from silence on the next control step
+    samplesUntilControl = 0;
+    controlTarget = controlRamp = controlStep = ModulationOutput();
+    currentOutput = ModulationOutput();
 }
 
 ChaosModulator::ModulationOutput ChaosModulator::getModulation() const
@@ -235,17 +399,25 @@ ChaosModulator::ModulationOutput ChaosModulator::getModulation() const
 
 float ChaosModulator::getNextModulationValue()
 {
-    currentSpeedHz = speed.getNextValue();
-    const float baseChaos = chaos.getNextValue();
+    const float value = generateNext(chaos.value, getEnvelopeTarget(rawEnvelopeValue), 1, perSample);
 
-    updateEnvelopeSmoothing(rawEnvelopeValue);
+    // Keep the control-rate ramp continuous with the single step
+    samplesUntilControl = 0;
+    controlTarget = controlRamp = currentOutput;
+    return value;
+}
+
+// Advances every generator by `steps` samples in one update; coeffs holds the
+// one-pole coefficients raised to that step count
+float ChaosModulator::generateNext(float baseChaos, float envelopeTarget, int steps, const StepCoefficients& coeffs)
+{
+    updateEnvelopeSmoothing(envelopeTarget, coeffs);
 
     const float envelopeContribution = smoothedEnvelopeInfluence;
 
-    // Floor keeps the Chaos knob alive on quiet/sustained input — envelope adds
-    // emphasis on top of a constant instability baseline rather than gating it
-    // fully (full gating made the knob feel dead and chaos vanish mid-note)
-    const float minChaosAtLowEnvelope = 0.35f;
+    // Envelope adds emphasis on top of a constant instability baseline rather
+    // than gating it fully (full gating made the knob feel dead and chaos
+    // vanish mid-note)
     effectiveChaosAmount = baseChaos * (minChaosAtLowEnvelope + envelopeContribution * (1.0f - minChaosAtLowEnvelope));
 
     // Cross-modulation: at chaos > 0.7, envelope modulates LFO speed
@@ -253,37 +425,40 @@ float ChaosModulator::getNextModulationValue()
     const float speedCrossMod = 1.0f + envelopeContribution * (0.5f + crossModAmount);
     const float effectiveSpeed = currentSpeedHz * speedCrossMod;
 
-    lfoPhaseIncrement = effectiveSpeed / static_cast<float>(sampleRate);
+    const float stepTime = static_cast<float>(steps) * inverseSampleRate;
+    lfoPhaseIncrement = effectiveSpeed * inverseSampleRate;
 
-    lfoPhase += lfoPhaseIncrement;
+    lfoPhase += effectiveSpeed * stepTime;
     if (lfoPhase >= 1.0f)
-        lfoPhase -= 1.0f;
+        lfoPhase -= std::floor(lfoPhase);
     if (!std::isfinite(lfoPhase))
         lfoPhase = 0.0f;
 
     const float sampleAndHoldRate = effectiveSpeed * (0.5f + effectiveChaosAmount * effectiveChaosAmount * 3.0f);
-    sampleAndHoldPhase += sampleAndHoldRate / static_cast<float>(sampleRate);
+    sampleAndHoldPhase += sampleAndHoldRate * stepTime;
 
     // S&H aggression: at chaos > 0.6, smoothing drops toward zero (raw jagged stepping)
     if (baseChaos > 0.6f)
     {
         const float reduction = ((baseChaos - 0.6f) / 0.4f) * 0.95f;
         dynamicSHSmoothCoeff = std::max(0.0f, 1.0f - reduction) * sampleAndHoldSmoothCoeff;
+        if (steps > 1)
+            dynamicSHSmoothCoeff = std::pow(dynamicSHSmoothCoeff, static_cast<float>(steps));
     }
     else
     {
-        dynamicSHSmoothCoeff = sampleAndHoldSmoothCoeff;
+        dynamicSHSmoothCoeff = coeffs.sampleAndHold;
     }
 
     updateSampleAndHold();
 
     const float randomWalkRate = effectiveSpeed * 0.25f;
-    randomWalkPhase += randomWalkRate / static_cast<float>(sampleRate);
-    updateRandomWalk();
+    randomWalkPhase += randomWalkRate * stepTime;
+    updateRandomWalk(coeffs.randomWalk);
 
     // Noise phase traverses 4 table entries per LFO cycle, never wraps at 1.0 —
     // wrapping at the LFO period would only ever read 4 of 256 table slots
-    noisePhase += effectiveSpeed * 4.0f / static_cast<float>(sampleRate);
+    noisePhase += effectiveSpeed * 4.0f * stepTime;
     if (noisePhase >= static_cast<float>(noiseTableSize))
         noisePhase -= static_cast<float>(noiseTableSize);
     if (!std::isfinite(noisePhase))
@@ -332,19 +507,28 @@ float ChaosModulator::getNextModulationValue()
     return currentOutput.combinedMod;
 }
 
-void ChaosModulator::setSpeed(float normalizedSpeed)
+float ChaosModulator::speedToHz(float normalizedSpeed) noexcept
 {
     normalizedSpeed = juce::jlimit(0.0f, 1.0f, normalizedSpeed);
 
     const float skewedSpeed = std::pow(normalizedSpeed, speedSkew);
-    const float hz = minSpeedHz + skewedSpeed * (maxSpeedHz - minSpeedHz);
+    return minSpeedHz + skewedSpeed * (maxSpeedHz - minSpeedHz);
+}
 
-    speed.setTargetValue(hz);
+void ChaosModulator::setSpeed(float normalizedSpeed)
+{
+    speed = RampBlock::constant(juce::jlimit(0.0f, 1.0f, normalizedSpeed));
 }
 
 void ChaosModulator::setChaos(float normalizedChaos)
 {
-    chaos.setTargetValue(juce::jlimit(0.0f, 1.0f, normalizedChaos));
+    chaos = RampBlock::constant(juce::jlimit(0.0f, 1.0f, normalizedChaos));
+}
+
+void ChaosModulator::setParameterRamps(const RampBlock& speedRamp, const RampBlock& chaosRamp) noexcept
+{
+    speed = speedRamp;
+    chaos = chaosRamp;
 }
 
 void ChaosModulator::setEnvelopeValue(float envelopeLevel)
@@ -384,12 +568,43 @@ void ChaosModulator::setEnvelopeAttack(float attackMs)
 {
     attackMs = juce::jlimit(0.1f, 100.0f, attackMs);
     envelopeAttackCoeff = 1.0f - std::exp(-1.0f / (static_cast<float>(sampleRate) * attackMs * 0.001f));
+    updateControlCoefficients();
 }
 
 void ChaosModulator::setEnvelopeRelease(float releaseMs)
 {
     releaseMs = juce::jlimit(10.0f, 500.0f, releaseMs);
     envelopeReleaseCoeff = 1.0f - std::exp(-1.0f / (static_cast<float>(sampleRate) * releaseMs * 0.001f));
+    updateControlCoefficients();
+}
+
+void ChaosModulator::setControlInterval(int numSamples) noexcept
+{
+    jassert(numSamples >= 1 && numSamples <= maxControlInterval);
+    numSamples = juce::jlimit(1, maxControlInterval, numSamples);
+
+    if (numSamples == controlInterval)
+        return;
+
+    controlInterval = numSamples;
+    samplesUntilControl = std::min(samplesUntilControl, controlInterval);
+    updateControlCoefficients();
+}
+
+void ChaosModulator::updateControlCoefficients() noexcept
+{
+    perSample.envelopeAttack = envelopeAttackCoeff;
+    perSample.envelopeRelease = envelopeReleaseCoeff;
+    perSample.sampleAndHold = sampleAndHoldSmoothCoeff;
+    perSample.randomWalk = randomWalkSmoothCoeff;
+
+    // n steps of y += c * (x - y) collapse to one step with 1 - (1 - c)^n;
+    // the y = y * c + x * (1 - c) smoothers to c^n
+    const float steps = static_cast<float>(controlInterval);
+    perControl.envelopeAttack = 1.0f - std::pow(1.0f - envelopeAttackCoeff, steps);
+    perControl.envelopeRelease = 1.0f - std::pow(1.0f - envelopeReleaseCoeff, steps);
+    perControl.sampleAndHold = std::pow(sampleAndHoldSmoothCoeff, steps);
+    perControl.randomWalk = std::pow(randomWalkSmoothCoeff, steps);
 }
 
 } // namespace DSP
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include "ParameterRamp.h"
 
 namespace DSP
 {
@@ -33,12 +34,22 @@ public:
     void process(int numSamples);
     // Per-sample modulation: fills the three buffers (each numSamples long).
     // Buffers must be pre-allocated by the caller (audio-thread safe).
+    // The generators run once per control interval and the outputs are
+    // interpolated linearly in between.
     void processToBuffers(float* pitchMod, float* grainMod, float* timingMod, int numSamples);
+    // Idle fast path: advances smoothers, envelope, LFO/noise phases and the
+    // S&H and random-walk generators by a whole block without generating
+    // modulation. Output reads as zero.
+    void skip(int numSamples);
     ModulationOutput getModulation() const;
     float getNextModulationValue();
 
     void setSpeed(float normalizedSpeed);
     void setChaos(float normalizedChaos);
+    // Normalized speed/chaos ramps for the next process/processToBuffers/skip
+    // call; arrays must stay valid until it returns. Speed is mapped to Hz at
+    // the block edges and ramped linearly in Hz in between.
+    void setParameterRamps(const RampBlock& speedRamp, const RampBlock& chaosRamp) noexcept;
     void setEnvelopeValue(float envelopeLevel);
     // NOT real-time safe: mutates noiseTable/random read by the audio thread.
     // Only call while audio is stopped (e.g. from prepare).
@@ -49,9 +60,16 @@ public:
     void setEnvelopeThreshold(float threshold);
     void setEnvelopeAttack(float attackMs);
     void setEnvelopeRelease(float releaseMs);
+    // Samples per generator update (1 = every sample, up to maxControlInterval).
+    // Allocation-free, safe to change between blocks
+    void setControlInterval(int numSamples) noexcept;
+    int getControlInterval() const noexcept { return controlInterval; }
+
+    static constexpr int defaultControlInterval = 16;
+    static constexpr int maxControlInterval = 32;
 
     float getSpeed() const { return currentSpeedHz; }
-    float getChaos() const { return chaos.getTargetValue(); }
+    float getChaos() const { return chaos.value; }
     float getLFOPhase() const { return lfoPhase; }
     float getEnvelopeInfluence() const { return smoothedEnvelopeInfluence; }
     float getEffectiveChaos() const { return effectiveChaosAmount; }
@@ -62,15 +80,34 @@ private:
     float generateTriangleWave(float phase) const;
     float generateSmoothNoise(float t);
     float interpolateHermite(float y0, float y1, float y2, float y3, float t) const;
+
+    // One-pole coefficients for one generator step of `steps` samples
+    struct StepCoefficients
+    {
+        float envelopeAttack = 0.0f;
+        float envelopeRelease = 0.0f;
+        float sampleAndHold = 0.995f;
+        float randomWalk = 0.999f;
+    };
+
     void updateSampleAndHold();
-    void updateRandomWalk();
+    void updateRandomWalk(float smoothCoeff);
     float applyResponseCurve(float input) const;
-    void updateEnvelopeSmoothing(float rawEnvelope);
+    float getEnvelopeTarget(float rawEnvelope) const;
+    void updateEnvelopeSmoothing(float envelopeTarget, const StepCoefficients& coeffs);
+    float generateNext(float baseChaos, float envelopeTarget, int steps, const StepCoefficients& coeffs);
+    void updateControlCoefficients() noexcept;
+    void advance(float* pitchMod, float* grainMod, float* timingMod, int numSamples);
+    // Per-sample Hz increment that lands on the speed ramp's end value
+    float beginSpeedRamp(int numSamples) noexcept;
+    void endBlock() noexcept;
+    static float speedToHz(float normalizedSpeed) noexcept;
 
     double sampleRate = 44100.0;
+    float inverseSampleRate = 1.0f / 44100.0f;
 
-    juce::SmoothedValue<float> speed { 2.0f };
-    juce::SmoothedValue<float> chaos { 0.5f };
+    RampBlock speed = RampBlock::constant(0.0f);
+    RampBlock chaos = RampBlock::constant(0.5f);
 
     float rawEnvelopeValue = 0.0f;
     float smoothedEnvelopeInfluence = 0.0f;
@@ -88,6 +125,9 @@ private:
 
     float currentSpeedHz = 2.0f;
 
+    // Floor keeps the Chaos knob alive on quiet/sustained input
+    static constexpr float minChaosAtLowEnvelope = 0.35f;
+
     float lfoPhase = 0.0f;
     float lfoPhaseIncrement = 0.0f;
 
@@ -107,6 +147,16 @@ private:
     float randomWalkPhase = 0.0f;
     float randomWalkSmoothCoeff = 0.999f;
 
+    // Control-rate engine: generators step every controlInterval samples,
+    // outputs ramp from the previous step's values to the latest ones
+    int controlInterval = defaultControlInterval;
+    int samplesUntilControl = 0;
+    StepCoefficients perSample;
+    StepCoefficients perControl;
+    ModulationOutput controlTarget;
+    ModulationOutput controlRamp;     // Current interpolated value
+    ModulationOutput controlStep;     // Per-sample increment toward controlTarget
+
     static constexpr int noiseTableSize = 256;
     std::array<float, noiseTableSize> noiseTable {};
     float noisePhase = 0.0f;   // [0, noiseTableSize) — traverses full table
@@ -16,6 +16,7 @@ void DynamicGate::prepare(const juce::dsp::ProcessSpec& spec)
     envelopeFollower.setSensitivity(1.0f);
 
     gateGain.reset(sampleRate, 0.015);
+    dynamics.prepare(maxBlockSize);
 
     lastGateGain = 1.0f;
 }
@@ -43,31 +44,31 @@ void DynamicGate::process(juce::AudioBuffer<float>& buffer)
         lastGlareRelease = glareRelease;
     }
 
-    float* channelData[8] = {};
-    const int clampedChannels = std::min(numChannels, 8);
-    for (int ch = 0; ch < clampedChannels; ++ch)
-        channelData[ch] = buffer.getWritePointer(ch);
+    // Linked detection across every channel; one gain for all of them
+    float* const* channelData = buffer.getArrayOfWritePointers();
+    const int sliceSize = dynamics.getMaxBlockSize();
+    if (sliceSize == 0)
+    {
+        jassertfalse;  // process() before prepare()
+        return;
+    }
 
-    for (int sample = 0; sample < numSamples; ++sample)
+    for (int start = 0; start < numSamples; start += sliceSize)
     {
-        float maxLevel = 0.0f;
-        for (int channel = 0; channel < clampedChannels; ++channel)
-            maxLevel = std::max(maxLevel, std::abs(channelData[channel][sample]));
+        const int length = std::min(sliceSize, numSamples - start);
 
-        const float envelope = envelopeFollower.processSample(maxLevel);
+        dynamics.detect(channelData, numChannels, start, length);
 
         // No hysteresis: the smooth knee in calculateGateGain provides the
         // continuous gate/expander behavior; chatter is masked by the 15ms
         // gain smoother rather than a binary open/closed state
-        const float targetGain = calculateGateGain(envelope, dynamicThreshold);
-
-        gateGain.setTargetValue(targetGain);
-        const float smoothedGain = gateGain.getNextValue();
-
-        for (int channel = 0; channel < clampedChannels; ++channel)
-            channelData[channel][sample] *= smoothedGain;
+        dynamics.computeGains(length,
+                              [this](float level) { return envelopeFollower.processSample(level); },
+                              [this, dynamicThreshold](float envelope) { return calculateGateGain(envelope, dynamicThreshold); },
+                              gateGain, false);
 
-        lastGateGain = smoothedGain;
+        dynamics.applyGain(channelData, numChannels, start, length);
+        lastGateGain = dynamics.getGains()[length - 1];
     }
 }
 
@@ -86,35 +87,19 @@ float DynamicGate::calculateDynamicThreshold() const
     return juce::Decibels::decibelsToGain(effectiveThresholdDb, -96.0f);
 }
 
-float DynamicGate::calculateGateGain(float envelope, float threshold) const
+float DynamicGate::calculateGateGain(float envelope, float threshold) const noexcept
 {
-    if (envelope <= 0.0f)
-        return 0.0f;
-
     const float kneeStart = threshold * (1.0f - kneeWidth);
     const float kneeEnd = threshold * (1.0f + kneeWidth);
 
-    if (envelope >= kneeEnd)
-    {
-        return 1.0f;
-    }
-    else if (envelope <= kneeStart)
-    {
-        const float ratio = envelope / kneeStart;
-
-        const float shaped = ratio * ratio * (3.0f - 2.0f * ratio);
+    // Branch-free so the block loop vectorises: below the knee only the first
+    // smoothstep moves (0 -> 0.3), inside it only the second (0.3 -> 1.0),
+    // and both saturate above it
+    const float ratio = juce::jlimit(0.0f, 1.0f, envelope / kneeStart);
+    const float kneePosition = juce::jlimit(0.0f, 1.0f, (envelope - kneeStart) / (kneeEnd - kneeStart));
 
-        const float minGain = 0.0f;
-        return minGain + shaped * (0.3f - minGain);
-    }
-    else
-    {
-        const float kneePosition = (envelope - kneeStart) / (kneeEnd - kneeStart);
-
-        const float smoothKnee = kneePosition * kneePosition * (3.0f - 2.0f * kneePosition);
-
-        return 0.3f + smoothKnee * 0.7f;
-    }
+    return ratio * ratio * (3.0f - 2.0f * ratio) * 0.3f
+           + kneePosition * kneePosition * (3.0f - 2.0f * kneePosition) * 0.7f;
 }
 
 void DynamicGate::setBaseThreshold(float thresholdDb)
@@ -2,6 +2,7 @@
 
 #include <JuceHeader.h>
 #include "EnvelopeFollower.h"
+#include "LinkedDynamics.h"
 
 namespace DSP
 {
@@ -29,12 +30,13 @@ public:
 
 private:
     float calculateDynamicThreshold() const;
-    float calculateGateGain(float envelope, float threshold) const;
+    float calculateGateGain(float envelope, float threshold) const noexcept;
 
     double sampleRate = 44100.0;
     int maxBlockSize = 512;
 
     EnvelopeFollower envelopeFollower;
+    LinkedDynamics dynamics;
 
     juce::SmoothedValue<float> gateGain { 1.0f };
 
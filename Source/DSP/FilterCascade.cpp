@@ -0,0 +1,157 @@
+#include "FilterCascade.h"
+#include <cmath>
+
+namespace DSP
+{
+
+FilterCascade::Section FilterCascade::Section::tuned(double sampleRate, float cutoffHz, float resonance) noexcept
+{
+    const double rate = sampleRate > 0.0 ? sampleRate : 44100.0;
+    jassert(cutoffHz > 0.0f && cutoffHz < static_cast<float>(rate * 0.5));
+    jassert(resonance > 0.0f);
+
+    Section s;
+    s.g = static_cast<float>(std::tan(juce::MathConstants<double>::pi * cutoffHz / rate));
+    s.R2 = static_cast<float>(1.0 / resonance);
+    s.h = static_cast<float>(1.0 / (1.0 + s.R2 * s.g + s.g * s.g));
+    s.dry = 0.0f;
+    return s;
+}
+
+FilterCascade::Section FilterCascade::Section::highpassed(double sampleRate, float cutoffHz, float resonance) noexcept
+{
+    auto s = tuned(sampleRate, cutoffHz, resonance);
+    s.highpass = 1.0f;
+    return s;
+}
+
+FilterCascade::Section FilterCascade::Section::lowpassed(double sampleRate, float cutoffHz, float resonance) noexcept
+{
+    auto s = tuned(sampleRate, cutoffHz, resonance);
+    s.lowpass = 1.0f;
+    return s;
+}
+
+FilterCascade::Section FilterCascade::Section::peak(double sampleRate, float cutoffHz, float resonance, float gain) noexcept
+{
+    auto s = tuned(sampleRate, cutoffHz, resonance);
+    s.dry = 1.0f;
+    s.bandpass = gain;
+    return s;
+}
+
+void FilterCascade::prepare(int newNumChannels)
+{
+    jassert(newNumChannels >= 0);
+    numChannels = std::max(0, newNumChannels);
+    s1.assign(static_cast<size_t>(maxSections * numChannels), 0.0f);
+    s2.assign(static_cast<size_t>(maxSections * numChannels), 0.0f);
+}
+
+void FilterCascade::reset() noexcept
+{
+    std::fill(s1.begin(), s1.end(), 0.0f);
+    std::fill(s2.begin(), s2.end(), 0.0f);
+}
+
+void FilterCascade::setSection(int index, const Section& section) noexcept
+{
+    jassert(index >= 0 && index < maxSections);
+    if (index >= 0 && index < maxSections)
+        sections[static_cast<size_t>(index)] = section;
+}
+
+void FilterCascade::setNumSections(int newNumSections) noexcept
+{
+    jassert(newNumSections >= 0 && newNumSections <= maxSections);
+    numSections = juce::jlimit(0, maxSections, newNumSections);
+}
+
+void FilterCascade::process(juce::dsp::AudioBlock<float>& block) noexcept
+{
+    const int numSamples = static_cast<int>(block.getNumSamples());
+    jassert(static_cast<int>(block.getNumChannels()) <= numChannels);
+    const int channelsToProcess = std::min(static_cast<int>(block.getNumChannels()), numChannels);
+
+    if (numSections == 0 || numSamples == 0)
+        return;
+
+    // Widest lane groups first; stereo is a single two-lane pass
+    float* lanes[laneWidth] = {};
+    const auto gather = [&](int first, int count)
+    {
+        for (int lane = 0; lane < count; ++lane)
+            lanes[lane] = block.getChannelPointer(static_cast<size_t>(first + lane));
+        return lanes;
+    };
+
+    int ch = 0;
+    for (; ch + laneWidth <= channelsToProcess; ch += laneWidth)
+        processLanes<laneWidth>(gather(ch, laneWidth), ch, numSamples);
+    for (; ch + 2 <= channelsToProcess; ch += 2)
+        processLanes<2>(gather(ch, 2), ch, numSamples);
+    if (ch < channelsToProcess)
+        processLanes<1>(gather(ch, 1), ch, numSamples);
+}
+
+template <int NumLanes>
+void FilterCascade::processLanes(float* const* channels, int firstChannel, int numSamples) noexcept
+{
+    // State lives in locals for the block; written back once at the end
+    float z1[maxSections][NumLanes];
+    float z2[maxSections][NumLanes];
+
+    for (int s = 0; s < numSections; ++s)
+    {
+        const auto row = static_cast<size_t>(s * numChannels + firstChannel);
+        for (int ch = 0; ch < NumLanes; ++ch)
+        {
+            z1[s][ch] = s1[row + static_cast<size_t>(ch)];
+            z2[s][ch] = s2[row + static_cast<size_t>(ch)];
+        }
+    }
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        float y[NumLanes];
+        float sectionInput[NumLanes];
+
+        for (int ch = 0; ch < NumLanes; ++ch)
+            y[ch] = sectionInput[ch] = channels[ch][i];
+
+        for (int s = 0; s < numSections; ++s)
+        {
+            const Section& c = sections[static_cast<size_t>(s)];
+
+            for (int ch = 0; ch < NumLanes; ++ch)
+            {
+                const float x = c.parallel ? sectionInput[ch] : y[ch];
+                sectionInput[ch] = x;
+
+                const float yHP = c.h * (x - z1[s][ch] * (c.g + c.R2) - z2[s][ch]);
+                const float yBP = yHP * c.g + z1[s][ch];
+                z1[s][ch] = yHP * c.g + yBP;
+                const float yLP = yBP * c.g + z2[s][ch];
+                z2[s][ch] = yBP * c.g + yLP;
+
+                const float out = c.dry * x + c.highpass * yHP + c.bandpass * yBP + c.lowpass * yLP;
+                y[ch] = c.parallel ? y[ch] + out : out;
+            }
+        }
+
+        for (int ch = 0; ch < NumLanes; ++ch)
+            channels[ch][i] = y[ch];
+    }
+
+    for (int s = 0; s < numSections; ++s)
+    {
+        const auto row = static_cast<size_t>(s * numChannels + firstChannel);
+        for (int ch = 0; ch < NumLanes; ++ch)
+        {
+            s1[row + static_cast<size_t>(ch)] = z1[s][ch];
+            s2[row + static_cast<size_t>(ch)] = z2[s][ch];
+        }
+    }
+}
+
+} // namespace DSP
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include <vector>
+
+namespace DSP
+{
+
+/**
+ * A chain of TPT state-variable sections evaluated in a single pass.
+ *
+ * Each section is a full second-order filter: its output is a mix of the
+ * input and the SVF's highpass, bandpass and lowpass outputs, so a peak
+ * boost ("input + k * bandpass") or a shelf-style blend is one section
+ * instead of a filter pass plus a mixing loop. Coefficients are plain data:
+ * build them off the hot path and swap them in with setSection().
+ *
+ * Channels run side by side as lanes of one loop (up to laneWidth at a
+ * time), so the per-section state recurrences of neighbouring channels
+ * interleave instead of each channel re-streaming the block through every
+ * filter. Any channel count works; state is sized in prepare().
+ */
+class FilterCascade
+{
+public:
+    static constexpr int maxSections = 6;
+    static constexpr int laneWidth = 4;    // Channels per pass: one SSE/NEON register
+
+    struct Section
+    {
+        // TPT SVF coefficients (same topology as juce::dsp::StateVariableTPTFilter)
+        float g = 0.0f;
+        float R2 = 1.0f;
+        float h = 1.0f;
+
+        // Output = dry * in + highpass * yHP + bandpass * yBP + lowpass * yLP
+        float dry = 1.0f;
+        float highpass = 0.0f;
+        float bandpass = 0.0f;
+        float lowpass = 0.0f;
+
+        // Parallel sections read the previous section's input and add their
+        // output to its result instead of filtering it
+        bool parallel = false;
+
+        static Section tuned(double sampleRate, float cutoffHz, float resonance) noexcept;
+        static Section highpassed(double sampleRate, float cutoffHz, float resonance) noexcept;
+        static Section lowpassed(double sampleRate, float cutoffHz, float resonance) noexcept;
+        // Input plus gain * bandpass — the additive peak boost
+        static Section peak(double sampleRate, float cutoffHz, float resonance, float gain) noexcept;
+    };
+
+    FilterCascade() = default;
+    ~FilterCascade() = default;
+
+    // Allocates integrator state for numChannels — not on the audio thread
+    void prepare(int numChannels);
+    void reset() noexcept;
+
+    // Replaces a section's coefficients; its filter state is kept, so
+    // retuning between blocks doesn't click
+    void setSection(int index, const Section& section) noexcept;
+    void setNumSections(int newNumSections) noexcept;
+    int getNumSections() const noexcept { return numSections; }
+
+    // Channels beyond the prepared count are left untouched
+    void process(juce::dsp::AudioBlock<float>& block) noexcept;
+
+private:
+    template <int NumLanes>
+    void processLanes(float* const* channels, int firstChannel, int numSamples) noexcept;
+
+    std::array<Section, maxSections> sections {};
+    int numSections = 0;
+
+    // Integrator state, one row of channels per section: [section * numChannels + channel]
+    int numChannels = 0;
+    std::vector<float> s1;
+    std::vector<float> s2;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(FilterCascade)
+};
+
+} // namespace DSP
@@ -4,44 +4,16 @@
 namespace DSP
 {
 
-void FuzzEngine::prepare(const juce::dsp::ProcessSpec& spec)
+void FuzzEngine::prepare(const juce::dsp::ProcessSpec& oversampledSpec)
 {
-    sampleRate = spec.sampleRate;
-    maxBlockSize = static_cast<int>(spec.maximumBlockSize);
-
-    LookupTables::initialize();
-
-    oversampling.initProcessing(static_cast<size_t>(maxBlockSize));
-    oversampledRate = sampleRate * 2.0;  // 2x oversampling
-
-    const double smoothingTime = 0.02;
-    gain.reset(oversampledRate, smoothingTime);
-    level.reset(oversampledRate, smoothingTime);
-    shape.reset(oversampledRate, 0.02);
-
-    juce::dsp::ProcessSpec osSpec;
-    osSpec.sampleRate = oversampledRate;
-    osSpec.maximumBlockSize = spec.maximumBlockSize * 2;
-    osSpec.numChannels = spec.numChannels;
-
-    // Prepare all filters at oversampled rate
-    preEqHP.prepare(osSpec);
-    preEqPeak.prepare(osSpec);
-    preEqShelf.prepare(osSpec);
-    postEqLP.prepare(osSpec);
-    postEqPeak.prepare(osSpec);
-    shapeMidEQ.prepare(osSpec);
-    shapeLowEQ.prepare(osSpec);
-    dcBlocker.prepare(osSpec);
-
-    // DC blocker: 20Hz highpass
-    dcBlocker.setType(juce::dsp::StateVariableTPTFilterType::highpass);
-    dcBlocker.setCutoffFrequency(20.0f);
-    dcBlocker.setResonance(0.707f);
-
-    // SHAPE filters initial config
-    shapeMidEQ.setType(juce::dsp::StateVariableTPTFilterType::bandpass);
-    shapeLowEQ.setType(juce::dsp::StateVariableTPTFilterType::lowpass);
+    oversampledRate = oversampledSpec.sampleRate > 0.0 ? oversampledSpec.sampleRate : 88200.0;
+    maxBlockSize = static_cast<int>(oversampledSpec.maximumBlockSize);
+    numChannels = std::max(1, static_cast<int>(oversampledSpec.numChannels));
+
+    // All EQ runs at the oversampled rate; voicings are tuned for it here
+    buildVoicings();
+    preClipEq.prepare(numChannels);
+    postClipEq.prepare(numChannels);
 
     // Envelope coefficients
     attackCoeff = std::exp(-1.0f / (static_cast<float>(oversampledRate) * 0.001f));
@@ -49,339 +21,545 @@ void FuzzEngine::prepare(const juce::dsp::ProcessSpec& spec)
     sagAttackCoeff = std::exp(-1.0f / (static_cast<float>(oversampledRate) * 0.2f));
     sagReleaseCoeff = std::exp(-1.0f / (static_cast<float>(oversampledRate) * 0.5f));
 
-    compressionEnvelope.fill(0.0f);
-    sagEnvelope.fill(0.0f);
+    compressionEnvelope.assign(static_cast<size_t>(numChannels), 0.0f);
+    sagEnvelope.assign(static_cast<size_t>(numChannels), 0.0f);
+    antiderivativeStates.assign(static_cast<size_t>(numChannels), AntiderivativeState {});
+    shaperIntegralsStale = true;
     biasDriftPhase = 0.0f;
     lastShapeValue = -1.0f;
 
+    // Native-rate ramps are never longer than the oversampled block
+    gainStages.assign(static_cast<size_t>(std::max(1, maxBlockSize)), GainStage {});
+    gainStagesRamping = false;
+
     configureFiltersForMode(currentMode);
+    updateShapeSections(shape.value);
 }
 
 void FuzzEngine::reset()
 {
-    const double smoothingTime = 0.02;
-    gain.reset(oversampledRate, smoothingTime);
-    level.reset(oversampledRate, smoothingTime);
-    shape.reset(oversampledRate, 0.02);
-
-    oversampling.reset();
-    preEqHP.reset();
-    preEqPeak.reset();
-    preEqShelf.reset();
-    postEqLP.reset();
-    postEqPeak.reset();
-    shapeMidEQ.reset();
-    shapeLowEQ.reset();
-    dcBlocker.reset();
-
-    compressionEnvelope.fill(0.0f);
-    sagEnvelope.fill(0.0f);
+    preClipEq.reset();
+    postClipEq.reset();
+
+    std::fill(compressionEnvelope.begin(), compressionEnvelope.end(), 0.0f);
+    std::fill(sagEnvelope.begin(), sagEnvelope.end(), 0.0f);
+    std::fill(antiderivativeStates.begin(), antiderivativeStates.end(), AntiderivativeState {});
+    shaperIntegralsStale = true;
     biasDriftPhase = 0.0f;
     lastShapeValue = -1.0f;
 }
 
+// Boost: pre-clip peak gain. Asymmetry: negative-half clipping bias.
+template <> struct FuzzEngine::ModeTraits<FuzzEngine::ModeScreaming>
+{
+    static constexpr float boost = 2.0f;        // +6dB equivalent
+    static constexpr float asymmetry = 0.4f;    // Tighter, harder clipping
+    static constexpr float driveScale = 1.2f;
+};
+
+template <> struct FuzzEngine::ModeTraits<FuzzEngine::ModeOverdrive>
+{
+    static constexpr float boost = 1.0f;        // +3dB equivalent
+    static constexpr float asymmetry = 0.2f;    // Softer saturation, more dynamic range
+    static constexpr float driveScale = 0.6f;
+};
+
+template <> struct FuzzEngine::ModeTraits<FuzzEngine::ModeDoom>
+{
+    static constexpr float boost = 2.5f;        // +8dB equivalent
+    static constexpr float asymmetry = 0.25f;   // Maximum headroom, slower compression
+    static constexpr float driveScale = 0.85f;
+};
+
+void FuzzEngine::buildVoicings()
+{
+    using Section = FilterCascade::Section;
+    const double rate = oversampledRate;
+
+    // Screaming — Pre: HPF 120Hz, peak at 2.5kHz Q=2
+    // Post: LPF 9kHz, presence at 3kHz (preserves pick attack for metal)
+    auto& screaming = voicings[ModeScreaming];
+    screaming.preClip[0] = Section::highpassed(rate, 120.0f, 0.707f);
+    screaming.preClip[1] = Section::peak(rate, 2500.0f, 2.0f, ModeTraits<ModeScreaming>::boost);
+    screaming.numPreClipSections = 2;
+    screaming.postLowpass = Section::lowpassed(rate, 9000.0f, 0.707f);
+    screaming.postPresence = Section::peak(rate, 3000.0f, 1.0f, 0.5f);
+
+    // Overdrive — Pre: HPF 80Hz, mild peak at 1kHz
+    // Post: LPF 8kHz, mild presence
+    auto& overdrive = voicings[ModeOverdrive];
+    overdrive.preClip[0] = Section::highpassed(rate, 80.0f, 0.707f);
+    overdrive.preClip[1] = Section::peak(rate, 1000.0f, 0.7f, ModeTraits<ModeOverdrive>::boost);
+    overdrive.numPreClipSections = 2;
+    overdrive.postLowpass = Section::lowpassed(rate, 8000.0f, 0.707f);
+    overdrive.postPresence = Section::peak(rate, 1500.0f, 0.6f, 0.5f);
+
+    // Doom — Pre: HPF 40Hz, peak at 400Hz Q=1.5, roll off highs before clipping
+    // Post: LPF 4kHz, low presence at 200Hz
+    auto& doom = voicings[ModeDoom];
+    doom.preClip[0] = Section::highpassed(rate, 40.0f, 0.707f);
+    doom.preClip[1] = Section::peak(rate, 400.0f, 1.5f, ModeTraits<ModeDoom>::boost);
+    doom.preClip[2] = Section::lowpassed(rate, 3000.0f, 0.5f);
+    doom.numPreClipSections = 3;
+    doom.postLowpass = Section::lowpassed(rate, 4000.0f, 0.707f);
+    doom.postPresence = Section::peak(rate, 200.0f, 0.8f, 0.5f);
+
+    // DC blocker: 20Hz highpass (removes bias drift residual)
+    postClipEq.setSection(0, Section::highpassed(rate, 20.0f, 0.707f));
+    postClipEq.setNumSections(postShapeLowSection + 1);
+}
+
 void FuzzEngine::configureFiltersForMode(int mode)
 {
-    // Pre-clip EQ
-    preEqHP.setType(juce::dsp::StateVariableTPTFilterType::highpass);
-    preEqPeak.setType(juce::dsp::StateVariableTPTFilterType::bandpass);
-    preEqShelf.setType(juce::dsp::StateVariableTPTFilterType::lowpass);
+    // Coefficient copies only: filter state carries across the switch
+    const auto& voicing = voicings[static_cast<size_t>(juce::jlimit(0, 2, mode))];
 
-    // Post-clip EQ
-    postEqLP.setType(juce::dsp::StateVariableTPTFilterType::lowpass);
-    postEqPeak.setType(juce::dsp::StateVariableTPTFilterType::bandpass);
+    for (int i = 0; i < voicing.numPreClipSections; ++i)
+        preClipEq.setSection(i, voicing.preClip[static_cast<size_t>(i)]);
+    preClipEq.setNumSections(voicing.numPreClipSections);
 
-    switch (mode)
-    {
-        case ModeScreaming:
-            // Pre: HPF 120Hz, peak at 2.5kHz Q=2
-            preEqHP.setCutoffFrequency(120.0f);
-            preEqHP.setResonance(0.707f);
-            preEqPeak.setCutoffFrequency(2500.0f);
-            preEqPeak.setResonance(2.0f);
-            preEqShelf.setCutoffFrequency(20000.0f);  // Effectively bypassed
-            preEqShelf.setResonance(0.707f);
-            // Post: LPF 9kHz, presence at 3kHz (preserves pick attack for metal)
-            postEqLP.setCutoffFrequency(9000.0f);
-            postEqLP.setResonance(0.707f);
-            postEqPeak.setCutoffFrequency(3000.0f);
-            postEqPeak.setResonance(1.0f);
-            // Tighter, harder clipping
-            modeAsymmetry = 0.4f;
-            modeDriveScale = 1.2f;
-            break;
+    postClipEq.setSection(1, voicing.postLowpass);
+    postClipEq.setSection(2, voicing.postPresence);
+}
 
-        case ModeDoom:
-            // Pre: HPF 40Hz, peak at 400Hz Q=1.5, darken highs
-            preEqHP.setCutoffFrequency(40.0f);
-            preEqHP.setResonance(0.707f);
-            preEqPeak.setCutoffFrequency(400.0f);
-            preEqPeak.setResonance(1.5f);
-            preEqShelf.setCutoffFrequency(3000.0f);  // Rolls off highs before clipping
-            preEqShelf.setResonance(0.5f);
-            // Post: LPF 4kHz, low presence at 200Hz
-            postEqLP.setCutoffFrequency(4000.0f);
-            postEqLP.setResonance(0.707f);
-            postEqPeak.setCutoffFrequency(200.0f);
-            postEqPeak.setResonance(0.8f);
-            // Maximum headroom, slower compression
-            modeAsymmetry = 0.25f;
-            modeDriveScale = 0.85f;
-            break;
+// Negative half: harder clipping, lower threshold (PNP germanium asymmetry)
+template <int Mode>
+constexpr float FuzzEngine::negativeDriveFor() noexcept
+{
+    return (1.0f + ModeTraits<Mode>::asymmetry * 2.5f) * 0.6f;
+}
 
-        case ModeOverdrive:
-        default:
-            // Pre: HPF 80Hz, mild peak at 1kHz
-            preEqHP.setCutoffFrequency(80.0f);
-            preEqHP.setResonance(0.707f);
-            preEqPeak.setCutoffFrequency(1000.0f);
-            preEqPeak.setResonance(0.7f);
-            preEqShelf.setCutoffFrequency(20000.0f);  // Bypassed
-            preEqShelf.setResonance(0.707f);
-            // Post: LPF 8kHz, mild presence
-            postEqLP.setCutoffFrequency(8000.0f);
-            postEqLP.setResonance(0.707f);
-            postEqPeak.setCutoffFrequency(1500.0f);
-            postEqPeak.setResonance(0.6f);
-            // Softer saturation, more dynamic range
-            modeAsymmetry = 0.2f;
-            modeDriveScale = 0.6f;
-            break;
-    }
+template <int Mode>
+constexpr float FuzzEngine::evenAmountFor() noexcept
+{
+    return ModeTraits<Mode>::asymmetry * 0.08f;
 }
 
-float FuzzEngine::germaniumWaveshape(float sample, float drive, float asymmetry) const
+template <int Mode>
+float FuzzEngine::germaniumWaveshape(float sample, float drive) const noexcept
 {
     const float driven = sample * drive;
 
-    float shaped;
+    // Positive half: softer germanium onset — tanh with gradual saturation
     if (driven >= 0.0f)
-    {
-        // Positive half: softer germanium onset — tanh with gradual saturation
-        shaped = LookupTables::fastTanh(driven * 0.8f);
-    }
-    else
-    {
-        // Negative half: harder clipping, lower threshold (PNP germanium asymmetry)
-        const float asymDrive = 1.0f + asymmetry * 2.5f;
-        shaped = -LookupTables::fastTanh(-driven * asymDrive * 0.6f);
-        // Even harmonic content from the unscaled input — using the driven
-        // sample saturated to a constant and injected pure DC bias instead
-        shaped += asymmetry * 0.08f * LookupTables::fastTanhPoly(sample * 2.0f);
-    }
+        return saturate(driven * 0.8f);
+
+    constexpr float negativeDrive = negativeDriveFor<Mode>();
+    constexpr float evenAmount = evenAmountFor<Mode>();
 
-    return shaped;
+    // Even harmonic content from the unscaled input — using the driven
+    // sample saturated to a constant and injected pure DC bias instead
+    return -saturate(-driven * negativeDrive)
+           + evenAmount * (exactWaveshaping ? std::tanh(sample * 2.0f) : LookupTables::fastTanhPoly(sample * 2.0f));
 }
 
-void FuzzEngine::process(juce::AudioBuffer<float>& buffer)
+float FuzzEngine::softKnee(float x) const noexcept
 {
-    juce::dsp::AudioBlock<float> block(buffer);
+    const float magnitude = std::abs(x);
+    if (magnitude > 1.0f)
+        return (x > 0.0f ? 1.0f : -1.0f) * (1.0f + saturate((magnitude - 1.0f) * 2.0f) * 0.2f);
+    return x;
+}
+
+//==============================================================================
+// Antiderivative shaping. With ln cosh(z) = |z| + log1p(e^-2|z|) - ln 2:
+//   waveshaper  x >= 0:  ln cosh(a x) / a                         a = 0.8 drive
+//               x <  0:  ln cosh(k x) / k + e ln cosh(2x) / 2     k, e per mode
+//   clamped at +-0.95 beyond the clip points, where it continues linearly
+//   soft knee   |x| <= 1: x^2 / 2, else 1/2 + (|x| - 1) + 0.1 ln cosh(2(|x| - 1))
+// Second order would need the dilogarithm for the tanh segments, so this is
+// first order; BlackheartFuzzBench measures it against the 2x path
 
-    // Upsample
-    auto oversampledBlock = oversampling.processSamplesUp(block);
+namespace
+{
+    constexpr double clampLevel = 0.95;
 
-    const auto numSamples = oversampledBlock.getNumSamples();
-    const auto numChannels = oversampledBlock.getNumChannels();
+    // Inputs closer than this take the curve at their midpoint instead: the
+    // integral difference carries ~1e-16 of rounding, the midpoint rule an
+    // error of order step^2
+    constexpr double antiderivativeTolerance = 1.0e-5;
 
-    // Pre-clip EQ (mode-dependent voicing)
+    double logCosh(double z) noexcept
     {
-        juce::dsp::ProcessContextReplacing<float> ctx(oversampledBlock);
-        preEqHP.process(ctx);
+        const double magnitude = std::abs(z);
+        return magnitude + std::log1p(std::exp(-2.0 * magnitude)) - 0.69314718055994530942;
     }
 
-    // Apply pre-EQ peak boost: read from bandpass, mix back into signal
-    // StateVariableTPT bandpass outputs only the band — we add it back for a peak boost
-    for (size_t ch = 0; ch < numChannels; ++ch)
+    // Mean of the curve between the previous input and this one
+    template <typename Curve>
+    float antiderivativeMean(float x, float previousX, double integral, double previousIntegral, Curve&& curve) noexcept
     {
-        float* data = oversampledBlock.getChannelPointer(ch);
-        for (size_t i = 0; i < numSamples; ++i)
-        {
-            const float dry = data[i];
-            const float band = preEqPeak.processSample(static_cast<int>(ch), dry);
-            // Peak boost: original + scaled bandpass
-            float boostAmount;
-            if (currentMode == ModeScreaming)
-                boostAmount = 2.0f;   // +6dB equivalent
-            else if (currentMode == ModeDoom)
-                boostAmount = 2.5f;   // +8dB equivalent
-            else
-                boostAmount = 1.0f;   // +3dB equivalent
-            data[i] = dry + band * boostAmount;
-        }
+        const double step = static_cast<double>(x) - static_cast<double>(previousX);
+        if (std::abs(step) > antiderivativeTolerance)
+            return static_cast<float>((integral - previousIntegral) / step);
+        return curve(0.5f * (x + previousX));
     }
+}
 
-    // Pre-clip shelf (doom mode darkening)
-    if (currentMode == ModeDoom)
+template <int Mode>
+double FuzzEngine::germaniumAntiderivative(double x, double drive) noexcept
+{
+    if (x >= 0.0)
     {
-        juce::dsp::ProcessContextReplacing<float> ctx(oversampledBlock);
-        preEqShelf.process(ctx);
+        const double slope = 0.8 * drive;
+        return logCosh(slope * x) / slope;
     }
 
-    const float biasDriftPhaseInc = 0.05f / static_cast<float>(oversampledRate); // 0.05 Hz LFO
+    const double slope = negativeDriveFor<Mode>() * drive;
+    return logCosh(slope * x) / slope + evenAmountFor<Mode>() * 0.5 * logCosh(2.0 * x);
+}
+
+template <int Mode>
+void FuzzEngine::computeClipPoints(GainStage& stage) noexcept
+{
+    const double atanhClamp = 0.5 * std::log((1.0 + clampLevel) / (1.0 - clampLevel));
+    const double negativeSlope = negativeDriveFor<Mode>() * stage.drive;
+    const double evenAmount = evenAmountFor<Mode>();
+
+    stage.upperClip = atanhClamp / (0.8 * stage.drive);
 
-    // Germanium gain stage — per-sample processing
-    for (size_t sample = 0; sample < numSamples; ++sample)
+    // Negative half: solve tanh(k x) + e tanh(2x) = -0.95. The curve is
+    // convex there, so Newton from the e = 0 root converges monotonically
+    double x = -atanhClamp / negativeSlope;
+    for (int i = 0; i < 8; ++i)
     {
-        const float currentGain = gain.getNextValue();
-        const float currentLevel = level.getNextValue();
-        const float currentShapeVal = shape.getNextValue();
+        const double t1 = std::tanh(negativeSlope * x);
+        const double t2 = std::tanh(2.0 * x);
+        const double slope = negativeSlope * (1.0 - t1 * t1) + 2.0 * evenAmount * (1.0 - t2 * t2);
+        x -= (t1 + evenAmount * t2 + clampLevel) / slope;
+    }
+    stage.lowerClip = x;
 
-        // Gain curve: gain^1.5 == x*sqrt(x) — avoids std::pow in the hot loop
-        const float gainCurved = currentGain * std::sqrt(currentGain);
-        const float baseDrive = minDrive + gainCurved * (maxDrive - minDrive);
-        const float drive = baseDrive * modeDriveScale;
+    stage.upperClipIntegral = germaniumAntiderivative<Mode>(stage.upperClip, stage.drive);
+    stage.lowerClipIntegral = germaniumAntiderivative<Mode>(stage.lowerClip, stage.drive);
+}
 
-        // Bias drift: slow LFO modulated by envelope
-        biasDriftPhase += biasDriftPhaseInc;
-        if (biasDriftPhase >= 1.0f) biasDriftPhase -= 1.0f;
-        const float biasDriftLfo = LookupTables::fastSin(biasDriftPhase) * 0.02f;
+template <int Mode>
+double FuzzEngine::shaperAntiderivative(double x, const GainStage& stage) noexcept
+{
+    if (x >= stage.upperClip)
+        return stage.upperClipIntegral + clampLevel * (x - stage.upperClip);
+    if (x <= stage.lowerClip)
+        return stage.lowerClipIntegral - clampLevel * (x - stage.lowerClip);
+    return germaniumAntiderivative<Mode>(x, stage.drive);
+}
 
-        // Update SHAPE EQ periodically (every 64 samples)
-        if ((sample & 63) == 0 && std::abs(currentShapeVal - lastShapeValue) > 0.005f)
-        {
-            lastShapeValue = currentShapeVal;
+double FuzzEngine::kneeAntiderivative(double x) noexcept
+{
+    const double magnitude = std::abs(x);
+    if (magnitude <= 1.0)
+        return 0.5 * magnitude * magnitude;
+    return 0.5 + (magnitude - 1.0) + 0.1 * logCosh(2.0 * (magnitude - 1.0));
+}
 
-            // Mid sweep: 400Hz (shape=0) -> 800Hz (0.5) -> 2kHz (1.0)
-            const float midFreq = 400.0f * std::pow(5.0f, currentShapeVal);
-            // Q: 0.5 (shape=0) -> 0.7 (0.5) -> 3.0 (1.0)
-            const float midQ = 0.5f + currentShapeVal * currentShapeVal * 2.5f;
-            shapeMidEQ.setCutoffFrequency(midFreq);
-            shapeMidEQ.setResonance(midQ);
-
-            // Low shelf: rolls off more at shape=0, boosts at shape=1
-            const float lowFreq = 200.0f;
-            shapeLowEQ.setCutoffFrequency(lowFreq);
-            shapeLowEQ.setResonance(0.5f + currentShapeVal * 0.3f);
-        }
+FuzzEngine::GainStage FuzzEngine::computeGainStage(float gainValue, float levelValue, float driveScale) noexcept
+{
+    GainStage stage;
 
-        // Level: map 0-1 to -24..+24dB
-        const float levelDb = currentLevel * 48.0f - 24.0f;
-        const float levelGain = juce::Decibels::decibelsToGain(levelDb, -96.0f);
-        const float makeupGain = 1.0f / (1.0f + drive * 0.005f);
+    // Gain curve: gain^1.5 == x*sqrt(x)
+    const float gainCurved = gainValue * std::sqrt(gainValue);
+    stage.drive = (minDrive + gainCurved * (maxDrive - minDrive)) * driveScale;
 
-        const size_t envChannels = std::min(numChannels, static_cast<size_t>(maxChannels));
-        for (size_t ch = 0; ch < envChannels; ++ch)
-        {
-            float* data = oversampledBlock.getChannelPointer(ch);
-            float inputSample = data[sample];
+    // Level: map 0-1 to -24..+24dB
+    const float levelGain = juce::Decibels::decibelsToGain(levelValue * 48.0f - 24.0f, -96.0f);
+    stage.outputGain = levelGain / (1.0f + stage.drive * 0.005f);
 
-            const float inputLevel = std::abs(inputSample);
+    // Ratio scales with gain so compression is strongest at high gain
+    // (gain-dependent squash), not weakest where the threshold is lowest
+    stage.threshold = 0.3f + (1.0f - gainValue) * 0.5f;
+    stage.inverseRatio = 1.0f / (4.0f + gainValue * 8.0f);
 
-            // Envelope follower for compression (per channel)
-            const float envCoeff = inputLevel > compressionEnvelope[ch] ? attackCoeff : releaseCoeff;
-            compressionEnvelope[ch] = compressionEnvelope[ch] * envCoeff + inputLevel * (1.0f - envCoeff);
+    return stage;
+}
 
-            // Sag envelope (slower, per channel)
-            const float sagCoeff = inputLevel > sagEnvelope[ch] ? sagAttackCoeff : sagReleaseCoeff;
-            sagEnvelope[ch] = sagEnvelope[ch] * sagCoeff + inputLevel * (1.0f - sagCoeff);
+void FuzzEngine::updateShapeSections(float shapeValue)
+{
+    appliedShapeValue = shapeValue;
 
-            // Voltage sag: reduce clipping headroom under sustained signal
-            const float sagFactor = 1.0f - sagEnvelope[ch] * 0.3f;
+    // Mid sweep: 400Hz (shape=0) -> 800Hz (0.5) -> 2kHz (1.0)
+    const float midFreq = 400.0f * std::pow(5.0f, shapeValue);
+    // Q: 0.5 (shape=0) -> 0.7 (0.5) -> 3.0 (1.0)
+    const float midQ = 0.5f + shapeValue * shapeValue * 2.5f;
 
-            // Soft compression before clipping — ratio scales with gain so
-            // compression is strongest at high gain (gain-dependent squash),
-            // not weakest where the threshold is lowest
-            const float threshold = (0.3f + (1.0f - currentGain) * 0.5f) * sagFactor;
-            if (inputLevel > threshold && inputLevel > 0.0f)
-            {
-                const float ratio = 4.0f + currentGain * 8.0f;
-                const float compGain = (threshold + (inputLevel - threshold) / ratio) / inputLevel;
-                inputSample *= compGain;
-            }
+    // Shape gain: +3dB at 0, 0dB at 0.5, +9dB at 1.0
+    float shapeGain;
+    if (shapeValue < 0.5f)
+        shapeGain = 1.0f + (0.5f - shapeValue) * 0.8f;   // 1.4 -> 1.0
+    else
+        shapeGain = 1.0f + (shapeValue - 0.5f) * 4.6f;    // 1.0 -> 3.3 (~+9dB)
 
-            // Add bias drift (depth follows this channel's envelope)
-            inputSample += biasDriftLfo * (0.3f + compressionEnvelope[ch] * 0.7f);
+    // Low shelf influence: cuts low at shape=0, boosts at shape=1
+    const float lowGain = (shapeValue - 0.5f) * 2.0f;  // -1 to +1
 
-            // Germanium waveshaping
-            float shaped = germaniumWaveshape(inputSample, drive, modeAsymmetry);
+    // dry + mid * (shapeGain - 1) + (low - dry) * lowGain * 0.3, as a
+    // bandpass section plus a parallel lowpass section on the same input
+    auto mid = FilterCascade::Section::tuned(oversampledRate, midFreq, midQ);
+    mid.dry = 1.0f - lowGain * 0.3f;
+    mid.bandpass = shapeGain - 1.0f;
 
-            // Hard limit safety
-            shaped = juce::jlimit(-0.95f, 0.95f, shaped);
+    auto low = FilterCascade::Section::tuned(oversampledRate, 200.0f, 0.5f + shapeValue * 0.3f);
+    low.lowpass = lowGain * 0.3f;
+    low.parallel = true;
 
-            float out = shaped * makeupGain * levelGain;
+    postClipEq.setSection(postShapeMidSection, mid);
+    postClipEq.setSection(postShapeLowSection, low);
+}
 
-            // Bound output: linear below 1.0, soft knee caps at 1.2 — closes
-            // the stage's gain budget instead of leaking up to ~3x full scale
-            // and relying on downstream limiting
-            const float absOut = std::abs(out);
-            if (absOut > 1.0f)
-                out = (out > 0.0f ? 1.0f : -1.0f) * (1.0f + LookupTables::fastTanh((absOut - 1.0f) * 2.0f) * 0.2f);
+void FuzzEngine::process(juce::dsp::AudioBlock<float>& oversampledBlock)
+{
+    // Mode dispatch once per block; the kernels see it as a constant
+    switch (currentMode)
+    {
+        case ModeScreaming: processMode<ModeScreaming>(oversampledBlock); break;
+        case ModeDoom:      processMode<ModeDoom>(oversampledBlock);      break;
+        default:            processMode<ModeOverdrive>(oversampledBlock); break;
+    }
 
-            data[sample] = out;
+    // Ramp arrays are only valid for this call; keep their end values
+    gain = RampBlock::constant(gain.value);
+    level = RampBlock::constant(level.value);
+    shape = RampBlock::constant(shape.value);
+}
+
+template <int Mode>
+void FuzzEngine::processMode(juce::dsp::AudioBlock<float>& oversampledBlock)
+{
+    const int numSamples = static_cast<int>(oversampledBlock.getNumSamples());
+    const auto blockChannels = oversampledBlock.getNumChannels();
+    jassert(static_cast<int>(blockChannels) <= numChannels);
+    const int gainStageChannels = std::min(static_cast<int>(blockChannels), numChannels);
+
+    // Pre-clip EQ (mode-dependent voicing), one pass
+    preClipEq.process(oversampledBlock);
+
+    // Ramps arrive at the native rate: hold each value for the oversampling
+    // factor (a power of two, so the index is a shift)
+    int rampShift = 0;
+    int rampLength = 0;
+    for (const auto* ramp : { &gain, &level, &shape })
+    {
+        if (!ramp->isStatic() && ramp->numSamples > 0)
+        {
+            rampLength = ramp->numSamples;
+            while ((static_cast<int64_t>(rampLength) << (rampShift + 1)) <= numSamples)
+                ++rampShift;
+            break;
         }
     }
 
-    // DC blocker (removes bias drift residual)
+    // Drive, makeup and level are derived per native-rate value while
+    // gain/level ramp, and once per block otherwise
+    gainStagesRamping = (!gain.isStatic() || !level.isStatic())
+                        && rampLength > 0 && rampLength <= static_cast<int>(gainStages.size());
+
+    if (gainStagesRamping)
     {
-        juce::dsp::ProcessContextReplacing<float> ctx(oversampledBlock);
-        dcBlocker.process(ctx);
+        for (int i = 0; i < rampLength; ++i)
+            gainStages[static_cast<size_t>(i)] = computeGainStage(gain[i], level[i], ModeTraits<Mode>::driveScale);
     }
-
-    // Post-clip EQ (mode-dependent)
+    else if (!gainStages.empty())
+    {
+        gainStages.front() = computeGainStage(gain.value, level.value, ModeTraits<Mode>::driveScale);
+    }
+    else
     {
-        juce::dsp::ProcessContextReplacing<float> ctx(oversampledBlock);
-        postEqLP.process(ctx);
+        jassertfalse;  // process() before prepare()
+        return;
     }
 
-    // Post-clip presence boost (additive bandpass)
-    for (size_t ch = 0; ch < numChannels; ++ch)
+    if (antiderivativeShaping)
     {
-        float* data = oversampledBlock.getChannelPointer(ch);
-        for (size_t i = 0; i < numSamples; ++i)
+        const int numStages = gainStagesRamping ? rampLength : 1;
+        for (int i = 0; i < numStages; ++i)
+            computeClipPoints<Mode>(gainStages[static_cast<size_t>(i)]);
+
+        // Stored shaper integrals are for the previous drive and mode; while
+        // ramping every sample re-evaluates the previous input instead
+        const auto& stage = gainStages.front();
+        if (!gainStagesRamping && (shaperIntegralsStale || stage.drive != shaperIntegralDrive))
         {
-            const float dry = data[i];
-            const float band = postEqPeak.processSample(static_cast<int>(ch), dry);
-            data[i] = dry + band * 0.5f;
+            for (int ch = 0; ch < gainStageChannels; ++ch)
+            {
+                auto& state = antiderivativeStates[static_cast<size_t>(ch)];
+                state.shaperIntegral = shaperAntiderivative<Mode>(state.shaperInput, stage);
+            }
         }
+
+        shaperIntegralsStale = false;
+        shaperIntegralDrive = gainStagesRamping ? gainStages[static_cast<size_t>(rampLength - 1)].drive : stage.drive;
     }
 
-    // SHAPE EQ: apply mid sweep as additive peak + low shelf blend
+    // Germanium gain stage in 64-sample segments: SHAPE EQ retune and the
+    // bias-drift LFO (0.05 Hz — linear within a segment) run per segment
+    constexpr int segmentLength = 64;
+    const float biasDriftPhaseInc = 0.05f / static_cast<float>(oversampledRate);
+    float biasDrift = LookupTables::fastSin(biasDriftPhase) * 0.02f;
+
+    for (int start = 0; start < numSamples; start += segmentLength)
     {
-        const float shapeVal = lastShapeValue >= 0.0f ? lastShapeValue : 0.5f;
-        // Shape gain: +3dB at 0, 0dB at 0.5, +9dB at 1.0
-        float shapeGain;
-        if (shapeVal < 0.5f)
-            shapeGain = 1.0f + (0.5f - shapeVal) * 0.8f;   // 1.4 -> 1.0
+        const int length = std::min(segmentLength, numSamples - start);
+
+        const float currentShapeVal = shape[start >> rampShift];
+        if (std::abs(currentShapeVal - lastShapeValue) > 0.005f)
+            lastShapeValue = currentShapeVal;
+
+        biasDriftPhase += biasDriftPhaseInc * static_cast<float>(length);
+        if (biasDriftPhase >= 1.0f) biasDriftPhase -= 1.0f;
+        const float nextBiasDrift = LookupTables::fastSin(biasDriftPhase) * 0.02f;
+        const float biasStep = (nextBiasDrift - biasDrift) / static_cast<float>(length);
+
+        if (antiderivativeShaping)
+            processGainStages<Mode, true>(oversampledBlock, gainStageChannels, start, length, rampShift, biasDrift, biasStep);
         else
-            shapeGain = 1.0f + (shapeVal - 0.5f) * 4.6f;    // 1.0 -> 3.3 (~+9dB)
+            processGainStages<Mode, false>(oversampledBlock, gainStageChannels, start, length, rampShift, biasDrift, biasStep);
+
+        biasDrift = nextBiasDrift;
+    }
+
+    // Post-clip EQ (DC blocker, mode voicing, SHAPE), one pass
+    if (lastShapeValue >= 0.0f && lastShapeValue != appliedShapeValue)
+        updateShapeSections(lastShapeValue);
+
+    postClipEq.process(oversampledBlock);
+
+    // SHAPE EQ is additive (mid gain up to 3.3x, resonant bandpass) and
+    // runs after the waveshaper's 1.2 budget clamp — re-close the budget
+    // here or the stage leaks up to ~3-4x full scale at high SHAPE
+    for (size_t ch = 0; ch < blockChannels; ++ch)
+    {
+        float* data = oversampledBlock.getChannelPointer(ch);
+        for (int i = 0; i < numSamples; ++i)
+            data[i] = softKnee(data[i]);
+    }
+}
+
+template <int Mode, bool Antiderivative>
+void FuzzEngine::processGainStages(juce::dsp::AudioBlock<float>& block, int channels, int start, int length,
+                                   int rampShift, float biasStart, float biasStep)
+{
+    // Widest lane groups first, the same grouping as the EQ cascades
+    int ch = 0;
+    for (; ch + laneWidth <= channels; ch += laneWidth)
+        processGainStage<Mode, laneWidth, Antiderivative>(block, ch, start, length, rampShift, biasStart, biasStep);
+    for (; ch + 2 <= channels; ch += 2)
+        processGainStage<Mode, 2, Antiderivative>(block, ch, start, length, rampShift, biasStart, biasStep);
+    if (ch < channels)
+        processGainStage<Mode, 1, Antiderivative>(block, ch, start, length, rampShift, biasStart, biasStep);
+}
+
+template <int Mode, int NumLanes, bool Antiderivative>
+void FuzzEngine::processGainStage(juce::dsp::AudioBlock<float>& block, int firstChannel, int start, int length,
+                                  int rampShift, float biasStart, float biasStep)
+{
+    static_assert(NumLanes >= 1 && NumLanes <= laneWidth, "One lane per channel of the group");
 
-        // Low shelf influence: cuts low at shape=0, boosts at shape=1
-        const float lowGain = (shapeVal - 0.5f) * 2.0f;  // -1 to +1
+    // Channels run side by side as lanes of one loop: the fixed lane count
+    // unrolls, and the envelope recurrences live in registers for the segment
+    float* data[NumLanes];
+    float compression[NumLanes];
+    float sag[NumLanes];
+    AntiderivativeState antiderivative[NumLanes];
 
-        for (size_t ch = 0; ch < numChannels; ++ch)
+    for (int ch = 0; ch < NumLanes; ++ch)
+    {
+        const auto channel = static_cast<size_t>(firstChannel + ch);
+        data[ch] = block.getChannelPointer(channel);
+        compression[ch] = compressionEnvelope[channel];
+        sag[ch] = sagEnvelope[channel];
+        if constexpr (Antiderivative)
+            antiderivative[ch] = antiderivativeStates[channel];
+    }
+
+    for (int offset = 0; offset < length; ++offset)
+    {
+        const int sample = start + offset;
+        const GainStage& stage = gainStagesRamping ? gainStages[static_cast<size_t>(sample >> rampShift)]
+                                                   : gainStages.front();
+        const float biasDriftLfo = biasStart + biasStep * static_cast<float>(offset);
+
+        for (int ch = 0; ch < NumLanes; ++ch)
         {
-            float* data = oversampledBlock.getChannelPointer(ch);
-            for (size_t i = 0; i < numSamples; ++i)
+            float inputSample = data[ch][sample];
+            const float inputLevel = std::abs(inputSample);
+
+            // Envelope follower for compression (per channel)
+            const float envCoeff = inputLevel > compression[ch] ? attackCoeff : releaseCoeff;
+            compression[ch] = compression[ch] * envCoeff + inputLevel * (1.0f - envCoeff);
+
+            // Sag envelope (slower, per channel)
+            const float sagCoeff = inputLevel > sag[ch] ? sagAttackCoeff : sagReleaseCoeff;
+            sag[ch] = sag[ch] * sagCoeff + inputLevel * (1.0f - sagCoeff);
+
+            // Voltage sag: reduce clipping headroom under sustained signal
+            const float threshold = stage.threshold * (1.0f - sag[ch] * 0.3f);
+
+            // Soft compression before clipping
+            if (inputLevel > threshold && inputLevel > 0.0f)
+                inputSample *= (threshold + (inputLevel - threshold) * stage.inverseRatio) / inputLevel;
+
+            // Add bias drift (depth follows this channel's envelope)
+            inputSample += biasDriftLfo * (0.3f + compression[ch] * 0.7f);
+
+            // Germanium waveshaping, hard limit safety
+            const auto clampedWaveshape = [this, &stage](float x)
             {
-                const float dry = data[i];
-                const float mid = shapeMidEQ.processSample(static_cast<int>(ch), dry);
-                const float low = shapeLowEQ.processSample(static_cast<int>(ch), dry);
-                float out = dry + mid * (shapeGain - 1.0f) + (low - dry) * lowGain * 0.3f;
-
-                // SHAPE EQ is additive (mid gain up to 3.3x, resonant bandpass) and
-                // runs after the waveshaper's 1.2 budget clamp — re-close the budget
-                // here or the stage leaks up to ~3-4x full scale at high SHAPE
-                const float absOut = std::abs(out);
-                if (absOut > 1.0f)
-                    out = (out > 0.0f ? 1.0f : -1.0f) * (1.0f + LookupTables::fastTanh((absOut - 1.0f) * 2.0f) * 0.2f);
-
-                data[i] = out;
+                return juce::jlimit(-0.95f, 0.95f, germaniumWaveshape<Mode>(x, stage.drive));
+            };
+
+            // Bound output: linear below 1.0, soft knee caps at 1.2 — closes
+            // the stage's gain budget instead of leaking up to ~3x full scale
+            // and relying on downstream limiting
+            if constexpr (Antiderivative)
+            {
+                auto& state = antiderivative[ch];
+
+                const double shaperIntegral = shaperAntiderivative<Mode>(inputSample, stage);
+                const double previousShaperIntegral = gainStagesRamping
+                    ? shaperAntiderivative<Mode>(state.shaperInput, stage)
+                    : state.shaperIntegral;
+                const float shaped = antiderivativeMean(inputSample, state.shaperInput, shaperIntegral,
+                                                        previousShaperIntegral, clampedWaveshape);
+                state.shaperInput = inputSample;
+                state.shaperIntegral = shaperIntegral;
+
+                const float scaled = shaped * stage.outputGain;
+                const double kneeIntegral = kneeAntiderivative(scaled);
+                data[ch][sample] = antiderivativeMean(scaled, state.kneeInput, kneeIntegral, state.kneeIntegral,
+                                                      [this](float x) { return softKnee(x); });
+                state.kneeInput = scaled;
+                state.kneeIntegral = kneeIntegral;
+            }
+            else
+            {
+                data[ch][sample] = softKnee(clampedWaveshape(inputSample) * stage.outputGain);
             }
         }
     }
 
-    // Downsample
-    oversampling.processSamplesDown(block);
+    for (int ch = 0; ch < NumLanes; ++ch)
+    {
+        compressionEnvelope[static_cast<size_t>(firstChannel + ch)] = compression[ch];
+        sagEnvelope[static_cast<size_t>(firstChannel + ch)] = sag[ch];
+        if constexpr (Antiderivative)
+            antiderivativeStates[static_cast<size_t>(firstChannel + ch)] = antiderivative[ch];
+    }
 }
 
 void FuzzEngine::setGain(float normalizedGain)
 {
-    gain.setTargetValue(juce::jlimit(0.0f, 1.0f, normalizedGain));
+    gain = RampBlock::constant(juce::jlimit(0.0f, 1.0f, normalizedGain));
 }
 
 void FuzzEngine::setLevel(float normalizedLevel)
 {
-    level.setTargetValue(juce::jlimit(0.0f, 1.0f, normalizedLevel));
+    level = RampBlock::constant(juce::jlimit(0.0f, 1.0f, normalizedLevel));
+}
+
+void FuzzEngine::setParameterRamps(const RampBlock& gainRamp, const RampBlock& levelRamp, const RampBlock& shapeRamp) noexcept
+{
+    gain = gainRamp;
+    level = levelRamp;
+    shape = shapeRamp;
 }
 
 void FuzzEngine::setMode(int mode)
@@ -391,12 +569,24 @@ void FuzzEngine::setMode(int mode)
     {
         currentMode = mode;
         configureFiltersForMode(mode);
+        shaperIntegralsStale = true;
     }
 }
 
+void FuzzEngine::setAntiderivativeShaping(bool shouldUseAntiderivatives) noexcept
+{
+    if (shouldUseAntiderivatives == antiderivativeShaping)
+        return;
+
+    // The stored inputs are stale once the other path has run
+    antiderivativeShaping = shouldUseAntiderivatives;
+    std::fill(antiderivativeStates.begin(), antiderivativeStates.end(), AntiderivativeState {});
+    shaperIntegralsStale = true;
+}
+
 void FuzzEngine::setShape(float normalizedShape)
 {
-    shape.setTargetValue(juce::jlimit(0.0f, 1.0f, normalizedShape));
+    shape = RampBlock::constant(juce::jlimit(0.0f, 1.0f, normalizedShape));
 }
 
 } // namespace DSP
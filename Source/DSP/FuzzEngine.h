@@ -1,7 +1,12 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include "FilterCascade.h"
+#include "LookupTables.h"
+#include "ParameterRamp.h"
 #include <array>
+#include <cmath>
+#include <vector>
 
 namespace DSP
 {
@@ -17,83 +22,161 @@ public:
     static constexpr int ModeOverdrive = 1;
     static constexpr int ModeDoom      = 2;
 
-    void prepare(const juce::dsp::ProcessSpec& spec);
+    // Runs inside the shared oversampled domain: prepare with the
+    // Oversampler's spec and process its upsampled block in place
+    void prepare(const juce::dsp::ProcessSpec& oversampledSpec);
     void reset();
-    void process(juce::AudioBuffer<float>& buffer);
+    void process(juce::dsp::AudioBlock<float>& block);
 
+    // Constant values (no smoothing) — for standalone use
     void setGain(float normalizedGain);
     void setLevel(float normalizedLevel);
     void setMode(int mode);
     void setShape(float normalizedShape);
-
-    float getGain() const { return gain.getTargetValue(); }
-    float getLevel() const { return level.getTargetValue(); }
+    // Native-rate ramps for the next process() call; each value is held for
+    // the oversampling factor. Arrays must stay valid until process() returns.
+    void setParameterRamps(const RampBlock& gainRamp, const RampBlock& levelRamp, const RampBlock& shapeRamp) noexcept;
+    // Exact std::tanh in the waveshaper instead of the lookup table —
+    // offline renders only; allocation-free, safe to switch between blocks
+    void setExactWaveshaping(bool shouldBeExact) noexcept { exactWaveshaping = shouldBeExact; }
+    bool isExactWaveshaping() const noexcept { return exactWaveshaping; }
+    // First-order antiderivative anti-aliasing (ADAA) on the waveshaper and
+    // the output knee: each sample is the mean of the curve between the
+    // previous input and this one, so aliasing stays low without running
+    // the stage oversampled. Costs getLatencySamples() of delay and a gentle
+    // top-octave roll-off. Allocation-free; switch it between blocks only
+    void setAntiderivativeShaping(bool shouldUseAntiderivatives) noexcept;
+    bool isAntiderivativeShaping() const noexcept { return antiderivativeShaping; }
+    // Delay of the shaped signal, in samples at the rate the engine runs:
+    // half a sample per antiderivative stage
+    int getLatencySamples() const noexcept { return antiderivativeShaping ? 1 : 0; }
+
+    float getGain() const { return gain.value; }
+    float getLevel() const { return level.value; }
     int getMode() const { return currentMode; }
-    float getShape() const { return shape.getTargetValue(); }
+    float getShape() const { return shape.value; }
 
 private:
+    // Per-mode constants, resolved at compile time inside the kernels
+    template <int Mode> struct ModeTraits;
+
+    // Everything the clipper needs from gain/level, derived once per
+    // native-rate value instead of per oversampled sample
+    struct GainStage
+    {
+        float drive = 1.0f;
+        float outputGain = 1.0f;      // makeup * level
+        float threshold = 0.55f;      // Compression threshold before sag
+        float inverseRatio = 0.125f;  // 1 / compression ratio
+
+        // Antiderivative shaping only: inputs where the waveshaper reaches
+        // its +-0.95 clamp, and its antiderivative at those points
+        double upperClip = 0.0;
+        double lowerClip = 0.0;
+        double upperClipIntegral = 0.0;
+        double lowerClipIntegral = 0.0;
+    };
+
+    static GainStage computeGainStage(float gain, float level, float driveScale) noexcept;
+
+    template <int Mode> void processMode(juce::dsp::AudioBlock<float>& block);
+    template <int Mode, bool Antiderivative>
+    void processGainStages(juce::dsp::AudioBlock<float>& block, int numChannels, int start, int length,
+                           int rampShift, float biasStart, float biasStep);
+    template <int Mode, int NumLanes, bool Antiderivative>
+    void processGainStage(juce::dsp::AudioBlock<float>& block, int firstChannel, int start, int length,
+                          int rampShift, float biasStart, float biasStep);
+    void updateShapeSections(float shapeValue);
+
     // Germanium waveshaping
-    float germaniumWaveshape(float sample, float drive, float asymmetry) const;
+    template <int Mode> static constexpr float negativeDriveFor() noexcept;
+    template <int Mode> static constexpr float evenAmountFor() noexcept;
+    template <int Mode> float germaniumWaveshape(float sample, float drive) const noexcept;
+    float saturate(float x) const noexcept { return exactWaveshaping ? std::tanh(x) : LookupTables::fastTanh(x); }
+    // Output bound: linear below 1.0, soft knee capping at 1.2
+    float softKnee(float x) const noexcept;
+
+    // Antiderivatives (in double: ADAA divides their difference by the input
+    // step) of the clamped waveshaper and of the soft knee
+    template <int Mode> static void computeClipPoints(GainStage& stage) noexcept;
+    template <int Mode> static double germaniumAntiderivative(double x, double drive) noexcept;
+    template <int Mode> static double shaperAntiderivative(double x, const GainStage& stage) noexcept;
+    static double kneeAntiderivative(double x) noexcept;
 
     // Mode-dependent filter configuration
+    void buildVoicings();
     void configureFiltersForMode(int mode);
 
-    double sampleRate = 44100.0;
     double oversampledRate = 88200.0;
-    int maxBlockSize = 512;
+    int maxBlockSize = 1024;
 
-    // Parameters
-    juce::SmoothedValue<float> gain { 0.5f };
-    juce::SmoothedValue<float> level { 0.7f };
-    juce::SmoothedValue<float> shape { 0.5f };
+    // Parameters (smoothed upstream by the processor's ramp bank)
+    RampBlock gain = RampBlock::constant(0.5f);
+    RampBlock level = RampBlock::constant(0.7f);
+    RampBlock shape = RampBlock::constant(0.5f);
     int currentMode = ModeOverdrive;
-
-    // Oversampling: 2x with IIR for low latency
-    juce::dsp::Oversampling<float> oversampling {
-        2,  // numChannels
-        1,  // order (2^1 = 2x)
-        juce::dsp::Oversampling<float>::filterHalfBandPolyphaseIIR,
-        true
+    bool exactWaveshaping = false;
+
+    // Linear EQ around the clipper, one single-pass cascade each side.
+    // Pre:  mode highpass -> mode peak boost [-> doom darkening lowpass]
+    // Post: DC blocker -> mode lowpass -> mode presence -> SHAPE mid || SHAPE low
+    FilterCascade preClipEq;
+    FilterCascade postClipEq;
+
+    // Mode voicings, built once per prepare() so setMode() only copies
+    struct Voicing
+    {
+        std::array<FilterCascade::Section, 3> preClip {};
+        int numPreClipSections = 0;
+        FilterCascade::Section postLowpass;
+        FilterCascade::Section postPresence;
     };
+    std::array<Voicing, 3> voicings {};
 
-    // Mode-dependent pre-clip EQ
-    juce::dsp::StateVariableTPTFilter<float> preEqHP;     // Highpass (mode-dependent cutoff)
-    juce::dsp::StateVariableTPTFilter<float> preEqPeak;   // Parametric peak (voicing)
-    juce::dsp::StateVariableTPTFilter<float> preEqShelf;  // High shelf (doom mode darkening)
+    static constexpr int postShapeMidSection = 3;
+    static constexpr int postShapeLowSection = 4;
 
-    // Mode-dependent post-clip EQ
-    juce::dsp::StateVariableTPTFilter<float> postEqLP;    // Lowpass (tame harshness)
-    juce::dsp::StateVariableTPTFilter<float> postEqPeak;  // Presence/character
-
-    // SHAPE EQ (post-clip, user-controlled)
-    juce::dsp::StateVariableTPTFilter<float> shapeMidEQ;  // Parametric mid sweep
-    juce::dsp::StateVariableTPTFilter<float> shapeLowEQ;  // Low shelf
-
-    // DC blocker (removes bias drift DC)
-    juce::dsp::StateVariableTPTFilter<float> dcBlocker;
-
-    // Germanium emulation state (per channel — shared state corrupts stereo)
-    static constexpr int maxChannels = 2;
-    std::array<float, maxChannels> compressionEnvelope {};
-    std::array<float, maxChannels> sagEnvelope {};     // Voltage sag tracking
+    // Germanium emulation state, one array per envelope indexed by channel
+    // (shared state corrupts stereo); sized in prepare()
+    static constexpr int laneWidth = FilterCascade::laneWidth;
+    int numChannels = 2;
+    std::vector<float> compressionEnvelope;
+    std::vector<float> sagEnvelope;     // Voltage sag tracking
     float biasDriftPhase = 0.0f;       // Slow LFO for bias drift
 
+    // Antiderivative shaping state per channel: the previous input to each
+    // stage and its antiderivative. The shaper's depends on drive and mode,
+    // so it is recomputed when either changes
+    struct AntiderivativeState
+    {
+        float shaperInput = 0.0f;
+        float kneeInput = 0.0f;
+        double shaperIntegral = 0.0;
+        double kneeIntegral = 0.0;
+    };
+    std::vector<AntiderivativeState> antiderivativeStates;
+    bool antiderivativeShaping = false;
+    bool shaperIntegralsStale = true;
+    float shaperIntegralDrive = 0.0f;   // Drive the stored shaper integrals used
+
     // Pre-calculated coefficients
     float attackCoeff = 0.0f;
     float releaseCoeff = 0.0f;
     float sagAttackCoeff = 0.0f;
     float sagReleaseCoeff = 0.0f;
 
-    // Mode-specific drive scaling
-    float modeAsymmetry = 0.3f;       // Asymmetry amount per mode
-    float modeDriveScale = 1.0f;      // Drive multiplier per mode
+    // Gain-stage values for this block: one entry when gain and level are
+    // static, one per native-rate sample while either is ramping
+    std::vector<GainStage> gainStages;
+    bool gainStagesRamping = false;
 
     // Drive range
     static constexpr float minDrive = 1.0f;
     static constexpr float maxDrive = 80.0f;
 
     // Cached filter params to avoid redundant updates
-    float lastShapeValue = -1.0f;
+    float lastShapeValue = -1.0f;     // Latest SHAPE seen by the gain stage
+    float appliedShapeValue = -1.0f;  // SHAPE the post-clip sections are tuned for
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(FuzzEngine)
 };
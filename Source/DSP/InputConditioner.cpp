@@ -9,10 +9,11 @@ void InputConditioner::prepare(const juce::dsp::ProcessSpec& spec)
     numChannels = static_cast<int>(spec.numChannels);
     maxBlockSize = static_cast<int>(spec.maximumBlockSize);
 
-    inputGain.reset(sampleRate, 0.02);
+    inputGain.prepare(sampleRate, 0.02, maxBlockSize);
 
     dcBlockCoeffs = juce::dsp::IIR::Coefficients<float>::makeHighPass(sampleRate, dcBlockCutoffHz);
 
+    dcBlockFilters.resize(static_cast<size_t>(std::max(1, numChannels)));
     for (auto& filter : dcBlockFilters)
     {
         filter.coefficients = dcBlockCoeffs;
@@ -30,7 +31,7 @@ void InputConditioner::prepare(const juce::dsp::ProcessSpec& spec)
 
 void InputConditioner::reset()
 {
-    inputGain.reset(sampleRate, 0.02);
+    inputGain.setCurrentAndTargetValue(inputGain.getTargetValue());
 
     for (auto& filter : dcBlockFilters)
         filter.reset();
@@ -57,7 +58,9 @@ void InputConditioner::processDCBlock(juce::AudioBuffer<float>& buffer)
     const int numSamples = buffer.getNumSamples();
     const int channels = buffer.getNumChannels();
 
-    for (int channel = 0; channel < std::min(channels, 2); ++channel)
+    jassert(channels <= static_cast<int>(dcBlockFilters.size()));
+
+    for (int channel = 0; channel < std::min(channels, static_cast<int>(dcBlockFilters.size())); ++channel)
     {
         float* channelData = buffer.getWritePointer(channel);
 
@@ -74,22 +77,16 @@ void InputConditioner::processGain(juce::AudioBuffer<float>& buffer)
     const int numSamples = buffer.getNumSamples();
     const int channels = buffer.getNumChannels();
 
-    if (inputGain.isSmoothing())
-    {
-        for (int sample = 0; sample < numSamples; ++sample)
-        {
-            const float gain = inputGain.getNextValue();
+    const auto gainRamp = inputGain.process(numSamples);
 
-            for (int channel = 0; channel < channels; ++channel)
-            {
-                buffer.setSample(channel, sample,
-                                 buffer.getSample(channel, sample) * gain);
-            }
-        }
+    if (!gainRamp.isStatic())
+    {
+        for (int channel = 0; channel < channels; ++channel)
+            juce::FloatVectorOperations::multiply(buffer.getWritePointer(channel), gainRamp.values, numSamples);
     }
     else
     {
-        const float gain = inputGain.getTargetValue();
+        const float gain = gainRamp.value;
         if (std::abs(gain - 1.0f) > 0.0001f)
         {
             for (int channel = 0; channel < channels; ++channel)
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include "ParameterRamp.h"
+#include <vector>
 
 namespace DSP
 {
@@ -34,10 +36,10 @@ private:
     int numChannels = 2;
     int maxBlockSize = 512;
 
-    juce::SmoothedValue<float> inputGain { 1.0f };
+    ParameterRamp inputGain { 1.0f };
 
     static constexpr float dcBlockCutoffHz = 10.0f;
-    std::array<juce::dsp::IIR::Filter<float>, 2> dcBlockFilters;
+    std::vector<juce::dsp::IIR::Filter<float>> dcBlockFilters;    // One per channel, sized in prepare()
     juce::dsp::IIR::Coefficients<float>::Ptr dcBlockCoeffs;
 
     juce::dsp::StateVariableTPTFilter<float> antiAliasingFilter;
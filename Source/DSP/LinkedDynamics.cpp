@@ -0,0 +1,44 @@
+#include "LinkedDynamics.h"
+#include <cmath>
+
+namespace DSP
+{
+
+void LinkedDynamics::prepare(int maxBlockSize)
+{
+    jassert(maxBlockSize > 0);
+    const auto size = static_cast<size_t>(juce::jmax(1, maxBlockSize));
+    detector.assign(size, 0.0f);
+    gains.assign(size, 1.0f);
+}
+
+void LinkedDynamics::detect(const float* const* channels, int numChannels, int startSample, int numSamples) noexcept
+{
+    jassert(numSamples <= getMaxBlockSize());
+    float* level = detector.data();
+
+    if (numChannels <= 0)
+    {
+        juce::FloatVectorOperations::clear(level, numSamples);
+        return;
+    }
+
+    juce::FloatVectorOperations::abs(level, channels[0] + startSample, numSamples);
+
+    for (int ch = 1; ch < numChannels; ++ch)
+    {
+        const float* input = channels[ch] + startSample;
+        for (int i = 0; i < numSamples; ++i)
+            level[i] = std::max(level[i], std::abs(input[i]));
+    }
+}
+
+void LinkedDynamics::applyGain(float* const* channels, int numChannels, int startSample, int numSamples) const noexcept
+{
+    jassert(numSamples <= getMaxBlockSize());
+
+    for (int ch = 0; ch < numChannels; ++ch)
+        juce::FloatVectorOperations::multiply(channels[ch] + startSample, gains.data(), numSamples);
+}
+
+} // namespace DSP
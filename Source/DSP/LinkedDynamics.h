@@ -0,0 +1,72 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <vector>
+
+namespace DSP
+{
+
+/**
+ * Block kernel shared by the linked dynamics stages (DynamicGate,
+ * OutputLimiter).
+ *
+ * Instead of one per-sample loop that interleaves detection, the gain curve
+ * and channel writes, a stage runs its block as three passes over
+ * block-length arrays:
+ *
+ *   1. detect()        max |x| across channels, one contiguous pass per channel
+ *   2. computeGains()  the only serial pass: the stage's envelope, its
+ *                      branch-free gain curve and the gain smoother. The two
+ *                      recurrences share one loop so their latencies overlap
+ *   3. applyGain()     one vector multiply per channel
+ *
+ * Channels are linked: every channel gets the same gain. Blocks longer than
+ * the prepared size are run in slices by the caller.
+ */
+class LinkedDynamics
+{
+public:
+    LinkedDynamics() = default;
+
+    // Allocates the detector and gain arrays — prepareToPlay only
+    void prepare(int maxBlockSize);
+    int getMaxBlockSize() const noexcept { return static_cast<int>(gains.size()); }
+
+    float* getDetector() noexcept { return detector.data(); }
+    float* getGains() noexcept { return gains.data(); }
+
+    // Detector array = max |x| across channels, from startSample on
+    void detect(const float* const* channels, int numChannels, int startSample, int numSamples) noexcept;
+
+    // Gain array from the detector array: envelope(level) -> detected value,
+    // gainCurve(detected) -> target, then the smoother retargeted every
+    // sample (same output as calling setTargetValue()/getNextValue() per
+    // sample). instantAttack lets reductions through unsmoothed.
+    template <typename Envelope, typename GainCurve>
+    void computeGains(int numSamples, Envelope&& envelope, GainCurve&& gainCurve,
+                      juce::SmoothedValue<float>& smoother, bool instantAttack) noexcept
+    {
+        jassert(numSamples <= getMaxBlockSize());
+        const float* level = detector.data();
+        float* gain = gains.data();
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const float target = gainCurve(envelope(level[i]));
+            smoother.setTargetValue(target);
+            const float smoothed = smoother.getNextValue();
+            gain[i] = instantAttack ? std::min(smoothed, target) : smoothed;
+        }
+    }
+
+    // Channels (from startSample on) *= gain array
+    void applyGain(float* const* channels, int numChannels, int startSample, int numSamples) const noexcept;
+
+private:
+    std::vector<float> detector;
+    std::vector<float> gains;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(LinkedDynamics)
+};
+
+} // namespace DSP
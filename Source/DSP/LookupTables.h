@@ -3,84 +3,112 @@
 #include <JuceHeader.h>
 #include <array>
 #include <cmath>
-#include <mutex>
+#include "MathKernels.h"
 
 namespace DSP
 {
 
-/**
- * High-performance lookup tables for common DSP functions.
- * All tables are thread-safe (read-only after initialization).
- * Uses linear interpolation for smooth output.
- */
-class LookupTables
+namespace LookupTableGenerators
 {
-public:
-    static constexpr int tableSize = 4096;
-    static constexpr int tableMask = tableSize - 1;
+    using namespace MathKernels::detail;
 
-    // Initialize all tables - call once at startup
-    static void initialize()
-    {
-        static std::once_flag initFlag;
-        std::call_once(initFlag, []
-        {
-        // Sine table: full period [0, 2π)
-        for (int i = 0; i < tableSize; ++i)
-        {
-            const float phase = static_cast<float>(i) / static_cast<float>(tableSize);
-            sineTable[i] = std::sin(phase * juce::MathConstants<float>::twoPi);
-        }
+    constexpr int size = 4096;
+    using Table = std::array<float, size>;
 
-        // Cosine table: full period [0, 2π)
-        for (int i = 0; i < tableSize; ++i)
-        {
-            const float phase = static_cast<float>(i) / static_cast<float>(tableSize);
-            cosineTable[i] = std::cos(phase * juce::MathConstants<float>::twoPi);
-        }
+    // Each generator is O(size) — rotations and geometric steps instead of a
+    // series per entry — so every table stays far inside the compilers'
+    // constexpr evaluation limits (MSVC's default is 100k steps)
 
-        // Tanh table: range [-4, 4] mapped to [0, tableSize)
-        for (int i = 0; i < tableSize; ++i)
+    // One full period [0, 2pi) by repeated rotation; error ~size * 1e-16
+    template <bool Sine>
+    constexpr Table makePeriodTable()
+    {
+        Table table {};
+        const double step = 2.0 * pi / size;
+        const double stepCos = cosSeries(step), stepSin = sinSeries(step);
+        double c = 1.0, s = 0.0;
+        for (int i = 0; i < size; ++i)
         {
-            const float x = (static_cast<float>(i) / static_cast<float>(tableSize - 1)) * 8.0f - 4.0f;
-            tanhTable[i] = std::tanh(x);
+            table[static_cast<size_t>(i)] = static_cast<float>(Sine ? s : c);
+            const double nextC = c * stepCos - s * stepSin;
+            s = s * stepCos + c * stepSin;
+            c = nextC;
         }
+        return table;
+    }
 
-        // Exp table for envelope followers: range [-8, 0] mapped to exp(x)
-        for (int i = 0; i < tableSize; ++i)
+    // Hann window: 0.5 * (1 - cos), one full window [0, 1]
+    constexpr Table makeHannTable()
+    {
+        Table table = makePeriodTable<false>();
+        for (auto& value : table)
+            value = static_cast<float>(0.5 * (1.0 - static_cast<double>(value)));
+        return table;
+    }
+
+    // tanh over [-4, 4]: e^2x stepped geometrically from e^-8
+    constexpr Table makeTanhTable()
+    {
+        Table table {};
+        const double ratio = expSeries(16.0 / (size - 1));
+        double e2x = 1.0 / expSeries(8.0);
+        for (int i = 0; i < size; ++i)
         {
-            const float x = (static_cast<float>(i) / static_cast<float>(tableSize - 1)) * -8.0f;
-            expDecayTable[i] = std::exp(x);
+            table[static_cast<size_t>(i)] = static_cast<float>((e2x - 1.0) / (e2x + 1.0));
+            e2x *= ratio;
         }
+        return table;
+    }
 
-        // Hann window table: one full window [0, 1]
-        for (int i = 0; i < tableSize; ++i)
+    // exp over [0, -8]: entry i holds exp(-8i / (size - 1))
+    constexpr Table makeExpDecayTable()
+    {
+        Table table {};
+        const double ratio = 1.0 / expSeries(8.0 / (size - 1));
+        double value = 1.0;
+        for (int i = 0; i < size; ++i)
         {
-            const float phase = static_cast<float>(i) / static_cast<float>(tableSize);
-            hannTable[i] = 0.5f * (1.0f - std::cos(phase * juce::MathConstants<float>::twoPi));
+            table[static_cast<size_t>(i)] = static_cast<float>(value);
+            value *= ratio;
         }
+        return table;
+    }
 
-        // Soft clip table: x - x^3/3 for [-1, 1], asymptotic beyond
-        for (int i = 0; i < tableSize; ++i)
+    // Soft clip over [-2, 2]: x - x^3/3 inside [-1, 1], exponential
+    // approach to +-1 beyond (continuous at the joins)
+    constexpr Table makeSoftClipTable()
+    {
+        Table table {};
+        const double ratio = 1.0 / expSeries(4.0 / (size - 1));
+        const double e3 = expSeries(3.0);
+        const double eMinus1 = 1.0 / expSeries(1.0);
+        double decay = 1.0;     // e^(-4i / (size - 1))
+        for (int i = 0; i < size; ++i)
         {
-            const float x = (static_cast<float>(i) / static_cast<float>(tableSize - 1)) * 4.0f - 2.0f;
-            if (x >= -1.0f && x <= 1.0f)
-            {
-                const float x2 = x * x;
-                softClipTable[i] = x - (x * x2) / 3.0f;
-            }
-            else if (x > 1.0f)
-            {
-                softClipTable[i] = 1.0f - std::exp(-x + 1.0f) * (1.0f - 2.0f/3.0f);
-            }
-            else
-            {
-                softClipTable[i] = -1.0f + std::exp(x + 1.0f) * (1.0f - 2.0f/3.0f);
-            }
+            const double x = -2.0 + 4.0 * i / (size - 1);
+            double value = x - x * x * x / 3.0;
+            if (x > 1.0)
+                value = 1.0 - e3 * decay / 3.0;         // e^(1 - x) = e^3 * decay
+            else if (x < -1.0)
+                value = -1.0 + eMinus1 / decay / 3.0;   // e^(x + 1) = e^-1 / decay
+            table[static_cast<size_t>(i)] = static_cast<float>(value);
+            decay *= ratio;
         }
-
-        });
+        return table;
     }
+} // namespace LookupTableGenerators
+
+/**
+ * High-performance lookup tables for common DSP functions.
+ * Generated at compile time into read-only data: no initialisation step,
+ * nothing computed when a plugin instance is created.
+ * Uses linear interpolation for smooth output.
+ */
+class LookupTables
+{
+public:
+    static constexpr int tableSize = LookupTableGenerators::size;
+    static constexpr int tableMask = tableSize - 1;
 
     // Fast sine lookup with linear interpolation
     // Input: normalized phase [0, 1)
@@ -136,7 +164,8 @@ public:
     static float fastExpDecay(float x) noexcept
     {
         x = juce::jlimit(-8.0f, 0.0f, x);
-        const float index = (x + 8.0f) * (static_cast<float>(tableSize - 1) / 8.0f);
+        // Entry i holds exp(-8i / (tableSize - 1))
+        const float index = -x * (static_cast<float>(tableSize - 1) / 8.0f);
         const int idx0 = static_cast<int>(index);
         const int idx1 = std::min(idx0 + 1, tableSize - 1);
         const float frac = index - static_cast<float>(idx0);
@@ -180,12 +209,12 @@ public:
     }
 
 private:
-    static inline std::array<float, tableSize> sineTable;
-    static inline std::array<float, tableSize> cosineTable;
-    static inline std::array<float, tableSize> tanhTable;
-    static inline std::array<float, tableSize> expDecayTable;
-    static inline std::array<float, tableSize> hannTable;
-    static inline std::array<float, tableSize> softClipTable;
+    static constexpr auto sineTable = LookupTableGenerators::makePeriodTable<true>();
+    static constexpr auto cosineTable = LookupTableGenerators::makePeriodTable<false>();
+    static constexpr auto tanhTable = LookupTableGenerators::makeTanhTable();
+    static constexpr auto expDecayTable = LookupTableGenerators::makeExpDecayTable();
+    static constexpr auto hannTable = LookupTableGenerators::makeHannTable();
+    static constexpr auto softClipTable = LookupTableGenerators::makeSoftClipTable();
 };
 
 } // namespace DSP
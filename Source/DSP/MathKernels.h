@@ -0,0 +1,306 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include <cstdint>
+#include <cstring>
+
+namespace DSP
+{
+
+/**
+ * Table-free math kernels: range reduction plus a short polynomial, so a
+ * loop calling them vectorises (no gathers, no table in L1).
+ *
+ * Coefficients are Chebyshev fits computed at compile time from constexpr
+ * series of the target function; Chebyshev interpolants sit within a small
+ * factor of the true minimax error. Two tiers per function:
+ *
+ *   Fast      low-degree, for modulation and control signals
+ *   Precise   at or near float resolution, for audio-path use
+ *
+ * Maximum errors against double-precision references (absolute unless
+ * noted; measured, then rounded up, and checked by testMathKernels):
+ *
+ *   Sine / Cosine (phase in turns)   Fast 1.5e-4    Precise 2.5e-7
+ *   Exp (relative, x in [-87, 88])   Fast 1.1e-4    Precise 3.0e-7
+ *   Tanh                             Fast 5.5e-5    Precise 2.0e-7
+ *
+ * LookupTables for comparison: fastSin/fastCos 6.7e-7, fastTanh 7.1e-7
+ * inside its [-4, 4] table.
+ *
+ * Each kernel has a scalar evaluate() and a batched process(in, out, n);
+ * in and out may alias. Clang vectorises process() as written; GCC needs
+ * -fno-trapping-math to if-convert the clamps and selects (the CMake tools
+ * set it). Rounding relies on IEEE arithmetic, so no -ffast-math.
+ */
+namespace MathKernels
+{
+
+enum class Tier
+{
+    Fast,
+    Precise
+};
+
+namespace detail
+{
+    //==========================================================================
+    // Compile-time coefficient generation
+
+    constexpr double pi = 3.14159265358979323846;
+    constexpr double ln2 = 0.69314718055994530942;
+
+    constexpr double sqrtConstexpr(double x)
+    {
+        double r = x > 1.0 ? x : 1.0;
+        for (int i = 0; i < 64; ++i)
+            r = 0.5 * (r + x / r);
+        return r;
+    }
+
+    constexpr double sinSeries(double x)
+    {
+        double term = x, sum = x;
+        for (int k = 1; k < 30; ++k)
+        {
+            term *= -x * x / ((2.0 * k) * (2.0 * k + 1.0));
+            sum += term;
+        }
+        return sum;
+    }
+
+    constexpr double cosSeries(double x)
+    {
+        double term = 1.0, sum = 1.0;
+        for (int k = 1; k < 30; ++k)
+        {
+            term *= -x * x / ((2.0 * k - 1.0) * (2.0 * k));
+            sum += term;
+        }
+        return sum;
+    }
+
+    constexpr double expSeries(double x)
+    {
+        double term = 1.0, sum = 1.0;
+        for (int k = 1; k < 40; ++k)
+        {
+            term *= x / k;
+            sum += term;
+        }
+        return sum;
+    }
+
+    // Monomial coefficients (ascending powers of u) of the degree N-1
+    // Chebyshev interpolant of f on [lo, hi]
+    template <int N, typename Function>
+    constexpr std::array<float, N> chebyshevFit(Function f, double lo, double hi)
+    {
+        // Chebyshev coefficients from the N first-kind nodes
+        std::array<double, N> cheb {};
+        for (int j = 0; j < N; ++j)
+        {
+            double sum = 0.0;
+            for (int k = 0; k < N; ++k)
+            {
+                const double theta = pi * (k + 0.5) / N;
+                const double t = cosSeries(theta);
+                sum += f(0.5 * (hi - lo) * t + 0.5 * (hi + lo)) * cosSeries(j * theta);
+            }
+            cheb[j] = (j == 0 ? 1.0 : 2.0) * sum / N;
+        }
+
+        // Sum of c_j T_j(t) as a polynomial in t (T_j+1 = 2t T_j - T_j-1)
+        std::array<double, N> inT {};
+        std::array<double, N> tPrev {}, tCurr {}, tNext {};
+        tPrev[0] = 1.0;
+        inT[0] += cheb[0];
+        if (N > 1)
+        {
+            tCurr[1] = 1.0;
+            inT[1] += cheb[1];
+        }
+        for (int j = 2; j < N; ++j)
+        {
+            for (int p = 0; p < N; ++p)
+                tNext[p] = (p > 0 ? 2.0 * tCurr[p - 1] : 0.0) - tPrev[p];
+            for (int p = 0; p < N; ++p)
+            {
+                inT[p] += cheb[j] * tNext[p];
+                tPrev[p] = tCurr[p];
+                tCurr[p] = tNext[p];
+            }
+        }
+
+        // t = a u + b
+        const double a = 2.0 / (hi - lo);
+        const double b = -(hi + lo) / (hi - lo);
+        std::array<double, N> inU {};
+        for (int p = 0; p < N; ++p)
+        {
+            // (a u + b)^p expanded binomially
+            double binomial = 1.0;
+            for (int q = 0; q <= p; ++q)
+            {
+                double term = inT[p] * binomial;
+                for (int i = 0; i < q; ++i) term *= a;
+                for (int i = 0; i < p - q; ++i) term *= b;
+                inU[q] += term;
+                binomial = binomial * (p - q) / (q + 1);
+            }
+        }
+
+        std::array<float, N> result {};
+        for (int p = 0; p < N; ++p)
+            result[p] = static_cast<float>(inU[p]);
+        return result;
+    }
+
+    // sin(pi/2 * t) = t * P(t^2) for t in [-1, 1]
+    template <int N>
+    constexpr std::array<float, N> quarterSineCoefficients()
+    {
+        return chebyshevFit<N>([](double u)
+        {
+            const double t = sqrtConstexpr(u);
+            return sinSeries(0.5 * pi * t) / t;
+        }, 0.0, 1.0);
+    }
+
+    // e^r for r in [-ln2 / 2, ln2 / 2]
+    template <int N>
+    constexpr std::array<float, N> expCoefficients()
+    {
+        return chebyshevFit<N>([](double r) { return expSeries(r); }, -0.5 * ln2, 0.5 * ln2);
+    }
+
+    //==========================================================================
+    // Branch-free helpers the vectoriser can map to compare/select
+
+    template <size_t N>
+    inline float horner(const std::array<float, N>& c, float x) noexcept
+    {
+        float result = c[N - 1];
+        for (size_t i = N - 1; i-- > 0;)
+            result = result * x + c[i];
+        return result;
+    }
+
+    // Round to nearest for |x| < 2^22: adding 1.5 * 2^23 pushes the fraction
+    // out of the mantissa. Plain arithmetic, so it vectorises where a compare
+    // and select would not (GCC's default -ftrapping-math)
+    inline float roundNearest(float x) noexcept
+    {
+        constexpr float shifter = 12582912.0f;
+        return (x + shifter) - shifter;
+    }
+
+    inline float exp2Integer(int32_t n) noexcept
+    {
+        const int32_t bits = (n + 127) << 23;
+        float result;
+        std::memcpy(&result, &bits, sizeof(result));
+        return result;
+    }
+
+    template <int N>
+    inline float expKernel(float x) noexcept
+    {
+        static constexpr auto coefficients = expCoefficients<N>();
+
+        // Outside [-87, 88] the result is 0 or would overflow float
+        const float clamped = std::min(88.0f, std::max(-87.0f, x));
+        const float whole = roundNearest(clamped * 1.44269504088896341f);
+
+        // x - n ln2 in two steps (Cody-Waite): the high part of ln2 has few
+        // enough bits that n * ln2High is exact
+        const float reduced = (clamped - whole * 0.693145751953125f) - whole * 1.428606765330187e-6f;
+        return horner(coefficients, reduced) * exp2Integer(static_cast<int32_t>(whole));
+    }
+} // namespace detail
+
+//==============================================================================
+// Batched form shared by every kernel
+template <typename Kernel>
+struct BatchKernel
+{
+    static void process(const float* input, float* output, int numSamples) noexcept
+    {
+        for (int i = 0; i < numSamples; ++i)
+            output[i] = Kernel::evaluate(input[i]);
+    }
+};
+
+// sin(2 pi phase), phase in turns (as LookupTables::fastSin); |phase| < 2^22
+template <Tier T = Tier::Precise>
+struct Sine : BatchKernel<Sine<T>>
+{
+    static constexpr int numCoefficients = T == Tier::Fast ? 3 : 5;
+
+    static float evaluate(float phase) noexcept
+    {
+        static constexpr auto coefficients = detail::quarterSineCoefficients<numCoefficients>();
+
+        // Reduce to r in [-0.5, 0.5), fold onto the rising quarter wave
+        const float r = phase - detail::roundNearest(phase);
+        const float magnitude = std::abs(r);
+        const float t = 4.0f * std::min(magnitude, 0.5f - magnitude);
+        return std::copysign(t * detail::horner(coefficients, t * t), r);
+    }
+};
+
+// cos(2 pi phase), phase in turns (as LookupTables::fastCos); |phase| < 2^22
+template <Tier T = Tier::Precise>
+struct Cosine : BatchKernel<Cosine<T>>
+{
+    static constexpr int numCoefficients = Sine<T>::numCoefficients;
+
+    static float evaluate(float phase) noexcept
+    {
+        static constexpr auto coefficients = detail::quarterSineCoefficients<numCoefficients>();
+
+        // cos(2 pi r) = sin(2 pi (1/4 - |r|)), an odd argument in [-1, 1]
+        const float r = phase - detail::roundNearest(phase);
+        const float t = 1.0f - 4.0f * std::abs(r);
+        return t * detail::horner(coefficients, t * t);
+    }
+};
+
+// e^x; relative error as documented above, 0 below -87, clamped above 88
+template <Tier T = Tier::Precise>
+struct Exp : BatchKernel<Exp<T>>
+{
+    static constexpr int numCoefficients = T == Tier::Fast ? 4 : 6;
+
+    static float evaluate(float x) noexcept
+    {
+        return detail::expKernel<numCoefficients>(x);
+    }
+};
+
+// tanh(x) = 1 - 2 / (e^2|x| + 1) with the sign restored; the Precise tier
+// switches to its Taylor series near zero, where that form cancels
+template <Tier T = Tier::Precise>
+struct Tanh : BatchKernel<Tanh<T>>
+{
+    static float evaluate(float x) noexcept
+    {
+        const float magnitude = std::min(std::abs(x), 9.0f);
+        const float viaExp = 1.0f - 2.0f / (Exp<T>::evaluate(2.0f * magnitude) + 1.0f);
+
+        if constexpr (T == Tier::Precise)
+        {
+            const float x2 = magnitude * magnitude;
+            const float series = magnitude * (1.0f + x2 * (-1.0f / 3.0f + x2 * (2.0f / 15.0f)));
+            return std::copysign(magnitude < 0.125f ? series : viaExp, x);
+        }
+        else
+        {
+            return std::copysign(viaExp, x);
+        }
+    }
+};
+
+} // namespace MathKernels
+} // namespace DSP
@@ -3,52 +3,91 @@
 namespace DSP
 {
 
-void OctaveGenerator::prepare(const juce::dsp::ProcessSpec& spec)
+namespace
 {
-    sampleRate = spec.sampleRate;
-    maxBlockSize = static_cast<int>(spec.maximumBlockSize);
-    numChannels = static_cast<int>(spec.numChannels);
+    constexpr float squared(float a) { return a * a; }
+
+    // Hilbert pair allpass coefficients, squared: each section is
+    // y(t) = a^2 (x(t) + y(t-2)) - x(t-2)
+    constexpr std::array<float, 4> hilbertCoefficientsA {
+        squared(0.6923878f), squared(0.9360654322959f), squared(0.9882295226860f), squared(0.9987488452737f)
+    };
+    constexpr std::array<float, 4> hilbertCoefficientsB {
+        squared(0.4021921162426f), squared(0.8561710882420f), squared(0.9722909545651f), squared(0.9952884791278f)
+    };
+
+    // Section k reads node k and writes node k + 1; each node keeps its
+    // values at t-1 and t-2
+    template <size_t Sections>
+    inline float processAllpassChain(float input, const std::array<float, Sections>& coefficients,
+                                     std::array<std::array<float, 2>, Sections + 1>& nodes) noexcept
+    {
+        float x = input;
 
-    const double smoothingTime = 0.02;
-    glare.reset(sampleRate, smoothingTime);
+        for (size_t k = 0; k < Sections; ++k)
+        {
+            const float y = coefficients[k] * (x + nodes[k + 1][1]) - nodes[k][1];
+            nodes[k][1] = nodes[k][0];
+            nodes[k][0] = x;
+            x = y;
+        }
 
-    // Initialize 2x oversampling
-    oversampling.initProcessing(static_cast<size_t>(maxBlockSize));
+        nodes[Sections][1] = nodes[Sections][0];
+        nodes[Sections][0] = x;
+        return x;
+    }
+} // namespace
 
-    // Filters run at oversampled rate
-    const double osRate = sampleRate * 2.0;
-    juce::dsp::ProcessSpec osSpec;
-    osSpec.sampleRate = osRate;
-    osSpec.maximumBlockSize = spec.maximumBlockSize * 2;
-    osSpec.numChannels = spec.numChannels;
+void OctaveGenerator::prepare(const juce::dsp::ProcessSpec& spec)
+{
+    preparedEngine = engine;
+    sampleRate = spec.sampleRate > 0.0 ? spec.sampleRate : 88200.0;
+    maxBlockSize = static_cast<int>(spec.maximumBlockSize);
+    numChannels = static_cast<int>(spec.numChannels);
 
-    preEmphasisHP.prepare(osSpec);
+    preEmphasisHP.prepare(spec);
     preEmphasisHP.setType(juce::dsp::StateVariableTPTFilterType::highpass);
     preEmphasisHP.setCutoffFrequency(preHPFreq);
     preEmphasisHP.setResonance(0.707f);
 
-    preEmphasisLP.prepare(osSpec);
+    preEmphasisLP.prepare(spec);
     preEmphasisLP.setType(juce::dsp::StateVariableTPTFilterType::lowpass);
     preEmphasisLP.setCutoffFrequency(preLPFreq);
     preEmphasisLP.setResonance(0.707f);
 
-    dcBlockFilter.prepare(osSpec);
+    dcBlockFilter.prepare(spec);
     dcBlockFilter.setType(juce::dsp::StateVariableTPTFilterType::highpass);
     dcBlockFilter.setCutoffFrequency(dcBlockFreq);
     dcBlockFilter.setResonance(0.707f);
 
-    octaveBandpass.prepare(osSpec);
+    octaveBandpass.prepare(spec);
     octaveBandpass.setType(juce::dsp::StateVariableTPTFilterType::bandpass);
     octaveBandpass.setCutoffFrequency(bandpassFreq);
     octaveBandpass.setResonance(bandpassQ);
 
-    octaveHighShelf.prepare(osSpec);
+    octaveHighShelf.prepare(spec);
     octaveHighShelf.setType(juce::dsp::StateVariableTPTFilterType::highpass);
     // 150Hz: trims sub-octave rumble while passing the doubled low-E (164Hz).
     // The old 800Hz corner removed the octave fundamental for most of the neck.
     octaveHighShelf.setCutoffFrequency(emphasisHPFreq);
     octaveHighShelf.setResonance(0.5f);
 
+    using Section = FilterCascade::Section;
+    analyticPreFilter.prepare(numChannels);
+    analyticPreFilter.setNumSections(3);
+    analyticPreFilter.setSection(0, Section::highpassed(sampleRate, preHPFreq, 0.707f));
+    analyticPreFilter.setSection(1, Section::lowpassed(sampleRate, preLPFreq, 0.707f));
+    analyticPreFilter.setSection(2, Section::lowpassed(sampleRate, preLPFreq, 0.707f));
+
+    auto bandpass = Section::tuned(sampleRate, bandpassFreq, bandpassQ);
+    bandpass.bandpass = 1.0f;
+    analyticPostFilter.prepare(numChannels);
+    analyticPostFilter.setNumSections(2);
+    analyticPostFilter.setSection(0, bandpass);
+    analyticPostFilter.setSection(1, Section::highpassed(sampleRate, emphasisHPFreq, 0.5f));
+
+    hilbertChannels.assign(static_cast<size_t>(numChannels), HilbertChannel {});
+
     // Pre-allocate buffer to avoid audio thread allocation
     octaveBuffer.setSize(numChannels, maxBlockSize, false, true, true);
 
@@ -57,43 +96,104 @@ void OctaveGenerator::prepare(const juce::dsp::ProcessSpec& spec)
 
 void OctaveGenerator::reset()
 {
-    glare.reset(sampleRate, 0.02);
-
-    oversampling.reset();
     preEmphasisHP.reset();
     preEmphasisLP.reset();
     dcBlockFilter.reset();
     octaveBandpass.reset();
     octaveHighShelf.reset();
+    analyticPreFilter.reset();
+    analyticPostFilter.reset();
+    std::fill(hilbertChannels.begin(), hilbertChannels.end(), HilbertChannel {});
 
     lastOctaveLevel = 0.0f;
 }
 
-void OctaveGenerator::process(juce::AudioBuffer<float>& buffer)
+void OctaveGenerator::process(juce::dsp::AudioBlock<float>& block)
 {
-    const int numSamples = buffer.getNumSamples();
-    const int channels = buffer.getNumChannels();
+    const int numSamples = static_cast<int>(block.getNumSamples());
+    const int channels = static_cast<int>(block.getNumChannels());
 
     // Buffer pre-allocated in prepare(); never allocate on the audio thread.
     // Undersized means the host violated the prepare contract — pass through dry.
     if (octaveBuffer.getNumSamples() < numSamples || octaveBuffer.getNumChannels() < channels)
         return;
 
-    // Copy input to octave buffer
+    // Copy the fuzz output to the octave buffer
     for (int ch = 0; ch < channels; ++ch)
     {
         juce::FloatVectorOperations::copy(octaveBuffer.getWritePointer(ch),
-                                          buffer.getReadPointer(ch),
+                                          block.getChannelPointer(static_cast<size_t>(ch)),
                                           numSamples);
     }
 
-    // Create AudioBlock for oversampling
     juce::dsp::AudioBlock<float> octaveBlock(octaveBuffer.getArrayOfWritePointers(),
-                                              static_cast<size_t>(channels),
-                                              static_cast<size_t>(numSamples));
+                                             static_cast<size_t>(channels),
+                                             static_cast<size_t>(numSamples));
+
+    if (preparedEngine == Engine::Analytic)
+        renderAnalyticOctave(octaveBlock);
+    else
+        renderRectifiedOctave(octaveBlock);
+
+    // Mix octave into output - optimized with reduced branching
+    float octaveLevelSum = 0.0f;
+
+    // Static glare takes the block path
+    if (glare.isStatic())
+    {
+        const float currentGlare = glare.value;
+        // glare^1.5 curve for smoother blend progression (less abrupt than glare^2);
+        // x*sqrt(x) avoids std::pow on the audio thread
+        const float glareCurved = currentGlare * std::sqrt(currentGlare);
+        const float octaveGain = glareCurved * 1.2f;
+
+        if (octaveGain > 0.0001f)
+        {
+            for (int channel = 0; channel < channels; ++channel)
+            {
+                float* outputData = block.getChannelPointer(static_cast<size_t>(channel));
+                const float* octaveData = octaveBuffer.getReadPointer(channel);
 
-    // Upsample to 2x rate
-    auto oversampledBlock = oversampling.processSamplesUp(octaveBlock);
+                // SIMD-optimized add with gain
+                juce::FloatVectorOperations::addWithMultiply(outputData, octaveData, octaveGain, numSamples);
+
+                // Calculate level for metering
+                octaveLevelSum += juce::FloatVectorOperations::findMaximum(octaveData, numSamples) * octaveGain;
+            }
+        }
+    }
+    else
+    {
+        // Per-sample processing while ramping; native-rate values are held
+        // for the oversampling factor
+        const int hold = std::max(1, numSamples / std::max(1, glare.numSamples));
+
+        for (int sample = 0; sample < numSamples; ++sample)
+        {
+            const float currentGlare = glare[sample / hold];
+            const float glareCurved = currentGlare * std::sqrt(currentGlare);
+            const float octaveGain = glareCurved * 1.2f;
+
+            for (int channel = 0; channel < channels; ++channel)
+            {
+                float* outputData = block.getChannelPointer(static_cast<size_t>(channel));
+                const float octave = octaveBuffer.getSample(channel, sample);
+                const float octaveContribution = octave * octaveGain;
+
+                outputData[sample] += octaveContribution;
+                octaveLevelSum += std::abs(octaveContribution);
+            }
+        }
+    }
+
+    lastOctaveLevel = octaveLevelSum / static_cast<float>(numSamples * channels + 1);
+
+    // Ramp array is only valid for this call
+    glare = RampBlock::constant(glare.value);
+}
+
+void OctaveGenerator::renderRectifiedOctave(juce::dsp::AudioBlock<float>& oversampledBlock)
+{
     const auto osNumSamples = oversampledBlock.getNumSamples();
     const auto osNumChannels = oversampledBlock.getNumChannels();
 
@@ -131,64 +231,44 @@ void OctaveGenerator::process(juce::AudioBuffer<float>& buffer)
         juce::dsp::ProcessContextReplacing<float> context(oversampledBlock);
         octaveHighShelf.process(context);
     }
+}
 
-    // Downsample back to native rate
-    oversampling.processSamplesDown(octaveBlock);
-
-    // Mix octave into output - optimized with reduced branching
-    float octaveLevelSum = 0.0f;
-
-    // Check if glare is smoothing for optimized path
-    if (!glare.isSmoothing())
+void OctaveGenerator::renderAnalyticOctave(juce::dsp::AudioBlock<float>& octaveBlock)
+{
+    const int numSamples = static_cast<int>(octaveBlock.getNumSamples());
+    const int channels = std::min(static_cast<int>(octaveBlock.getNumChannels()),
+                                  static_cast<int>(hilbertChannels.size()));
+
+    analyticPreFilter.process(octaveBlock);
+
+    // With a = chain A (delayed a sample) and b = chain B in quadrature,
+    // a + jb is the analytic signal: its square holds only sums of the input
+    // frequencies, never the differences rectification folds down.
+    // Re{(a + jb)^2} = a^2 - b^2 is the doubled wave at the input's amplitude
+    // squared; dividing by |a + jb| brings it back to the input's amplitude
+    for (int channel = 0; channel < channels; ++channel)
     {
-        const float currentGlare = glare.getTargetValue();
-        // glare^1.5 curve for smoother blend progression (less abrupt than glare^2);
-        // x*sqrt(x) avoids std::pow on the audio thread
-        const float glareCurved = currentGlare * std::sqrt(currentGlare);
-        const float octaveGain = glareCurved * 1.2f;
+        auto& state = hilbertChannels[static_cast<size_t>(channel)];
+        float* octaveData = octaveBlock.getChannelPointer(static_cast<size_t>(channel));
 
-        if (octaveGain > 0.0001f)
-        {
-            for (int channel = 0; channel < channels; ++channel)
-            {
-                float* outputData = buffer.getWritePointer(channel);
-                const float* octaveData = octaveBuffer.getReadPointer(channel);
-
-                // SIMD-optimized add with gain
-                juce::FloatVectorOperations::addWithMultiply(outputData, octaveData, octaveGain, numSamples);
-
-                // Calculate level for metering
-                octaveLevelSum += juce::FloatVectorOperations::findMaximum(octaveData, numSamples) * octaveGain;
-            }
-        }
-    }
-    else
-    {
-        // Per-sample processing when smoothing
         for (int sample = 0; sample < numSamples; ++sample)
         {
-            const float currentGlare = glare.getNextValue();
-            const float glareCurved = currentGlare * std::sqrt(currentGlare);
-            const float octaveGain = glareCurved * 1.2f;
-
-            for (int channel = 0; channel < channels; ++channel)
-            {
-                const float dry = buffer.getSample(channel, sample);
-                const float octave = octaveBuffer.getSample(channel, sample);
-                const float octaveContribution = octave * octaveGain;
+            const float input = octaveData[sample];
+            const float a = state.delayedA;
+            state.delayedA = processAllpassChain(input, hilbertCoefficientsA, state.chainA);
+            const float b = processAllpassChain(input, hilbertCoefficientsB, state.chainB);
 
-                buffer.setSample(channel, sample, dry + octaveContribution);
-                octaveLevelSum += std::abs(octaveContribution);
-            }
+            const float power = a * a + b * b;
+            octaveData[sample] = analyticOctaveGain * (a * a - b * b) / std::sqrt(power + 1.0e-20f);
         }
     }
 
-    lastOctaveLevel = octaveLevelSum / static_cast<float>(numSamples * channels + 1);
+    analyticPostFilter.process(octaveBlock);
 }
 
 void OctaveGenerator::setGlare(float normalizedGlare)
 {
-    glare.setTargetValue(juce::jlimit(0.0f, 1.0f, normalizedGlare));
+    glare = RampBlock::constant(juce::jlimit(0.0f, 1.0f, normalizedGlare));
 }
 
 } // namespace DSP
@@ -1,7 +1,10 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include "FilterCascade.h"
+#include "ParameterRamp.h"
 #include <array>
+#include <vector>
 
 namespace DSP
 {
@@ -12,37 +15,80 @@ public:
     OctaveGenerator() = default;
     ~OctaveGenerator() = default;
 
+    // How the doubled-frequency component is derived
+    //   Rectifier: full-wave rectification. Runs inside the shared oversampled
+    //              domain after FuzzEngine — |x| needs the headroom
+    //   Analytic:  squares the analytic signal from an IIR Hilbert pair
+    //              (x^2 - y^2 over the magnitude), which only produces sum
+    //              frequencies, so it runs at the native rate after the domain
+    enum class Engine
+    {
+        Rectifier = 0,
+        Analytic
+    };
+
+    // Applied at the next prepare() — message thread only
+    void setEngine(Engine newEngine) { engine = newEngine; }
+    Engine getEngine() const { return engine; }
+    // Engine the stage was prepared with: Analytic processes native-rate blocks
+    bool runsAtNativeRate() const { return preparedEngine == Engine::Analytic; }
+
+    // Prepare with the spec of the rate the engine runs at (the Oversampler's
+    // for Rectifier, the native spec for Analytic) and process blocks at that
+    // rate in place
     void prepare(const juce::dsp::ProcessSpec& spec);
     void reset();
-    void process(juce::AudioBuffer<float>& buffer);
+    void process(juce::dsp::AudioBlock<float>& block);
 
     void setGlare(float normalizedGlare);
+    // Native-rate glare ramp for the next process() call (held per factor)
+    void setGlareRamp(const RampBlock& glareRamp) noexcept { glare = glareRamp; }
 
-    float getCurrentGlare() const { return glare.getTargetValue(); }
+    float getCurrentGlare() const { return glare.value; }
     float getOctaveLevel() const { return lastOctaveLevel; }
 
 private:
+    // Each writes the octave signal for the first channels of octaveBuffer
+    void renderRectifiedOctave(juce::dsp::AudioBlock<float>& octaveBlock);
+    void renderAnalyticOctave(juce::dsp::AudioBlock<float>& octaveBlock);
+
     double sampleRate = 44100.0;
     int maxBlockSize = 512;
     int numChannels = 2;
 
-    juce::SmoothedValue<float> glare { 0.3f };
+    RampBlock glare = RampBlock::constant(0.3f);
 
-    // 2x oversampling for aliasing-free rectification
-    juce::dsp::Oversampling<float> oversampling {
-        2,  // numChannels
-        1,  // order (2^1 = 2x)
-        juce::dsp::Oversampling<float>::filterHalfBandPolyphaseIIR,
-        true
-    };
+    Engine engine = Engine::Rectifier;
+    Engine preparedEngine = Engine::Rectifier;
 
-    // Filters run at oversampled rate
+    // Filters run at oversampled rate — rectification needs the headroom
     juce::dsp::StateVariableTPTFilter<float> preEmphasisHP;
     juce::dsp::StateVariableTPTFilter<float> preEmphasisLP;
     juce::dsp::StateVariableTPTFilter<float> dcBlockFilter;
     juce::dsp::StateVariableTPTFilter<float> octaveBandpass;
     juce::dsp::StateVariableTPTFilter<float> octaveHighShelf;
 
+    // Analytic engine, native rate. The same voicing as single-pass cascades;
+    // the pre-filter lowpass runs twice since content above a quarter of the
+    // sample rate doubles past Nyquist
+    FilterCascade analyticPreFilter;
+    FilterCascade analyticPostFilter;
+
+    // Niemitalo's 90-degree pair: two chains of four allpasses in z^-2
+    // (coefficients squared below). Chain A delayed one sample trails chain B
+    // by 90 degrees, to within a degree from 20Hz to 0.98 Nyquist at 44.1kHz
+    static constexpr int hilbertSections = 4;
+
+    struct HilbertChannel
+    {
+        // Per chain, the last two values at each node; node 0 is the input
+        std::array<std::array<float, 2>, hilbertSections + 1> chainA {};
+        std::array<std::array<float, 2>, hilbertSections + 1> chainB {};
+        float delayedA = 0.0f;
+    };
+
+    std::vector<HilbertChannel> hilbertChannels;
+
     // Pre-allocated buffer to avoid audio-thread allocation
     juce::AudioBuffer<float> octaveBuffer;
     float lastOctaveLevel = 0.0f;
@@ -58,6 +104,11 @@ private:
     static constexpr float bandpassQ = 0.5f;
     static constexpr float emphasisHPFreq = 150.0f;
 
+    // A sine's second harmonic after full-wave rectification is 4/(3 pi) of
+    // its amplitude; the analytic octave is scaled to match, so Glare sits
+    // at the same level in either engine
+    static constexpr float analyticOctaveGain = 0.42441318f;
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(OctaveGenerator)
 };
 
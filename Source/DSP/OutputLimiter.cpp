@@ -9,9 +9,6 @@ void OutputLimiter::prepare(const juce::dsp::ProcessSpec& spec)
     sampleRate = spec.sampleRate;
     maxBlockSize = static_cast<int>(spec.maximumBlockSize);
 
-    // Initialize lookup tables (thread-safe, only runs once)
-    LookupTables::initialize();
-
     const double smoothingTime = 0.02;
     outputLevel.reset(sampleRate, smoothingTime);
     gainReduction.reset(sampleRate, 0.005);
@@ -22,6 +19,21 @@ void OutputLimiter::prepare(const juce::dsp::ProcessSpec& spec)
     envelope = 0.0f;
     lastGainReduction = 0.0f;
 
+    dynamics.prepare(maxBlockSize);
+
+    // The look-ahead has to outlast the true-peak detector's own delay
+    lookaheadSamples = lookaheadMs > 0.0f
+        ? juce::jmax(TruePeakDetector::latency + 1, juce::roundToInt(lookaheadMs * 0.001 * sampleRate))
+        : 0;
+    lookaheadWindow = lookaheadSamples > 0 ? lookaheadSamples - TruePeakDetector::latency + 1 : 0;
+    delayChannels = static_cast<int>(spec.numChannels);
+    truePeak.prepare(delayChannels);
+    delayBuffer.assign(static_cast<size_t>(delayChannels * lookaheadSamples), 0.0f);
+    holdGains.assign(static_cast<size_t>(lookaheadWindow), 1.0f);
+    holdIndices.assign(static_cast<size_t>(lookaheadWindow), 0);
+    attackRing.assign(static_cast<size_t>(lookaheadWindow), 1.0f);
+    resetLookahead();
+
     dcBlockFilter.prepare(spec);
     dcBlockFilter.setType(juce::dsp::StateVariableTPTFilterType::highpass);
     dcBlockFilter.setCutoffFrequency(dcBlockFreq);
@@ -38,27 +50,46 @@ void OutputLimiter::reset()
     envelope = 0.0f;
     lastGainReduction = 0.0f;
     dcBlockFilter.reset();
+    resetLookahead();
 }
 
-float OutputLimiter::processSaturation(float sample, float drive) const
+void OutputLimiter::resetLookahead() noexcept
 {
-    const float absInput = std::abs(sample);
-    const float sign = sample >= 0.0f ? 1.0f : -1.0f;
+    truePeak.reset();
+    std::fill(delayBuffer.begin(), delayBuffer.end(), 0.0f);
+    delayPosition = 0;
+    holdHead = 0;
+    holdSize = 0;
+    detectorIndex = 0;
+    releaseGain = 1.0f;
+    std::fill(attackRing.begin(), attackRing.end(), 1.0f);
+    attackPosition = 0;
+    attackSum = static_cast<double>(lookaheadWindow);
+}
 
-    if (absInput <= saturationKnee)
-    {
-        return sample;
-    }
-    else
-    {
-        const float overKnee = absInput - saturationKnee;
-        const float headroomAboveKnee = 1.0f - saturationKnee;
+void OutputLimiter::setLookahead(float milliseconds)
+{
+    lookaheadMs = clampLookahead(milliseconds);
+}
 
-        // Use fast tanh approximation
-        const float saturated = saturationKnee + headroomAboveKnee * LookupTables::fastTanhPoly(overKnee * drive / headroomAboveKnee);
+float OutputLimiter::clampLookahead(float milliseconds) noexcept
+{
+    return milliseconds > 0.0f ? juce::jlimit(minLookaheadMs, maxLookaheadMs, milliseconds) : 0.0f;
+}
 
-        return sign * saturated;
-    }
+float OutputLimiter::processSaturation(float sample, float drive) const noexcept
+{
+    // Branch-free so the per-channel loop vectorises: below the knee the
+    // overshoot is 0, the tanh term vanishes and the sample passes unchanged
+    const float absInput = std::abs(sample);
+    const float headroomAboveKnee = 1.0f - saturationKnee;
+    const float overKnee = std::max(0.0f, absInput - saturationKnee);
+
+    // Use fast tanh approximation
+    const float saturated = std::min(absInput, saturationKnee)
+                            + headroomAboveKnee * LookupTables::fastTanhPoly(overKnee * drive / headroomAboveKnee);
+
+    return std::copysign(saturated, sample);
 }
 
 void OutputLimiter::process(juce::AudioBuffer<float>& buffer)
@@ -73,131 +104,165 @@ void OutputLimiter::process(juce::AudioBuffer<float>& buffer)
         dcBlockFilter.process(context);
     }
 
-    // Check if level is smoothing for optimized path
-    if (!outputLevel.isSmoothing())
+    float* const* channelData = buffer.getArrayOfWritePointers();
+    const int sliceSize = dynamics.getMaxBlockSize();
+    if (sliceSize == 0)
     {
-        const float level = outputLevel.getTargetValue();
+        jassertfalse;  // process() before prepare()
+        return;
+    }
+
+    // Detect from the louder of smoothed envelope and instantaneous peak:
+    // the envelope alone lags transients by its attack time, letting
+    // full-amplitude peaks through with no reduction
+    const auto followEnvelope = [this](float peak)
+    {
+        const float coeff = peak > envelope ? attackCoeff : releaseCoeff;
+        envelope = envelope * coeff + peak * (1.0f - coeff);
+        return std::max(envelope, peak);
+    };
+
+    // Branch-free curve: up to 30% compression across the headroom band,
+    // then ceiling / level above the ceiling
+    const float maxOver = ceiling - headroom;
+    const float compressionScale = maxOver > 0.0f ? 0.3f : 0.0f;
+    const float safeMaxOver = maxOver > 0.0f ? maxOver : 1.0f;
+    const auto gainCurve = [this, compressionScale, safeMaxOver](float level)
+    {
+        const float compressionAmount = std::min(1.0f, std::max(0.0f, level - headroom) / safeMaxOver);
+        const float compressed = 1.0f - compressionAmount * compressionScale;
+        return level > ceiling ? ceiling / level : compressed;
+    };
 
-        // Apply gain to entire buffer using SIMD
-        if (std::abs(level - 1.0f) > 0.0001f)
+    for (int start = 0; start < numSamples; start += sliceSize)
+    {
+        const int length = std::min(sliceSize, numSamples - start);
+        float* gains = dynamics.getGains();
+
+        // Output level: one vector multiply per channel, through the gain
+        // array while the level is smoothing
+        if (outputLevel.isSmoothing())
         {
-            for (int channel = 0; channel < numChannels; ++channel)
-            {
-                juce::FloatVectorOperations::multiply(buffer.getWritePointer(channel), level, numSamples);
-            }
+            for (int i = 0; i < length; ++i)
+                gains[i] = outputLevel.getNextValue();
+            dynamics.applyGain(channelData, numChannels, start, length);
         }
-
-        // Process limiting
-        for (int sample = 0; sample < numSamples; ++sample)
+        else
         {
-            float maxAbsLevel = 0.0f;
-            for (int channel = 0; channel < numChannels; ++channel)
+            const float level = outputLevel.getTargetValue();
+            if (std::abs(level - 1.0f) > 0.0001f)
             {
-                maxAbsLevel = std::max(maxAbsLevel, std::abs(buffer.getSample(channel, sample)));
+                for (int channel = 0; channel < numChannels; ++channel)
+                    juce::FloatVectorOperations::multiply(channelData[channel] + start, level, length);
             }
+        }
 
-            const float coeff = maxAbsLevel > envelope ? attackCoeff : releaseCoeff;
-            envelope = envelope * coeff + maxAbsLevel * (1.0f - coeff);
-
-            // Detect from the louder of smoothed envelope and instantaneous peak:
-            // the envelope alone lags transients by its attack time, letting
-            // full-amplitude peaks through with no reduction
-            const float detectLevel = std::max(envelope, maxAbsLevel);
-
-            float targetGainReduction = 1.0f;
+        if (lookaheadSamples > 0)
+        {
+            processLookahead(channelData, numChannels, start, length);
+            continue;
+        }
 
-            if (detectLevel > headroom)
-            {
-                const float overHeadroom = detectLevel - headroom;
-                const float maxOver = ceiling - headroom;
-
-                if (maxOver > 0.0f)
-                {
-                    const float compressionAmount = std::min(1.0f, overHeadroom / maxOver);
-                    targetGainReduction = 1.0f - compressionAmount * 0.3f;
-                }
-            }
+        dynamics.detect(channelData, numChannels, start, length);
 
-            if (detectLevel > ceiling)
-            {
-                targetGainReduction = ceiling / detectLevel;
-            }
+        // Instant attack, smoothed release: reductions apply immediately
+        // (true peak limiting), recoveries ride the 5ms smoother
+        dynamics.computeGains(length, followEnvelope, gainCurve, gainReduction, true);
+        lastGainReduction = 1.0f - gains[length - 1];
 
-            gainReduction.setTargetValue(targetGainReduction);
-            // Instant attack, smoothed release: reductions apply immediately
-            // (true peak limiting), recoveries ride the 5ms smoother
-            const float currentGainReduction = std::min(gainReduction.getNextValue(), targetGainReduction);
-            lastGainReduction = 1.0f - currentGainReduction;
+        dynamics.applyGain(channelData, numChannels, start, length);
 
-            for (int channel = 0; channel < numChannels; ++channel)
-            {
-                float inputSample = buffer.getSample(channel, sample);
-                inputSample *= currentGainReduction;
-                const float saturated = processSaturation(inputSample, 1.5f);
-                const float limited = juce::jlimit(-ceiling, ceiling, saturated);
-                buffer.setSample(channel, sample, limited);
-            }
+        for (int channel = 0; channel < numChannels; ++channel)
+        {
+            float* data = channelData[channel] + start;
+            for (int i = 0; i < length; ++i)
+                data[i] = juce::jlimit(-ceiling, ceiling, processSaturation(data[i], 1.5f));
         }
     }
-    else
+}
+
+float OutputLimiter::nextLookaheadGain(float level) noexcept
+{
+    // Scale the reading up to the true peak it may be hiding, so the
+    // ceiling holds between the detector's points too
+    const float peak = level * truePeakMargin;
+    const float required = peak > ceiling ? ceiling / peak : 1.0f;
+    const int capacity = lookaheadWindow;
+
+    // Hold: minimum required gain over the last lookaheadWindow detector
+    // samples. Expire the front, drop every entry the new one undercuts
+    if (holdSize > 0 && holdIndices[static_cast<size_t>(holdHead)] <= detectorIndex - capacity)
     {
-        // Per-sample processing when level is smoothing
-        for (int sample = 0; sample < numSamples; ++sample)
-        {
-            const float level = outputLevel.getNextValue();
+        holdHead = holdHead + 1 == capacity ? 0 : holdHead + 1;
+        --holdSize;
+    }
 
-            float maxAbsLevel = 0.0f;
-            for (int channel = 0; channel < numChannels; ++channel)
-            {
-                float inputSample = buffer.getSample(channel, sample);
-                inputSample *= level;
-                buffer.setSample(channel, sample, inputSample);
-                maxAbsLevel = std::max(maxAbsLevel, std::abs(inputSample));
-            }
+    while (holdSize > 0)
+    {
+        const int back = (holdHead + holdSize - 1) % capacity;
+        if (holdGains[static_cast<size_t>(back)] < required)
+            break;
+        --holdSize;
+    }
 
-            const float coeff = maxAbsLevel > envelope ? attackCoeff : releaseCoeff;
-            envelope = envelope * coeff + maxAbsLevel * (1.0f - coeff);
+    const int slot = (holdHead + holdSize) % capacity;
+    holdGains[static_cast<size_t>(slot)] = required;
+    holdIndices[static_cast<size_t>(slot)] = detectorIndex++;
+    ++holdSize;
 
-            // Detect from the louder of smoothed envelope and instantaneous peak:
-            // the envelope alone lags transients by its attack time, letting
-            // full-amplitude peaks through with no reduction
-            const float detectLevel = std::max(envelope, maxAbsLevel);
+    const float held = holdGains[static_cast<size_t>(holdHead)];
 
-            float targetGainReduction = 1.0f;
+    // Reductions land at once, recoveries ride the release
+    releaseGain = held < releaseGain ? held : held + (releaseGain - held) * releaseCoeff;
 
-            if (detectLevel > headroom)
-            {
-                const float overHeadroom = detectLevel - headroom;
-                const float maxOver = ceiling - headroom;
-
-                if (maxOver > 0.0f)
-                {
-                    const float compressionAmount = std::min(1.0f, overHeadroom / maxOver);
-                    targetGainReduction = 1.0f - compressionAmount * 0.3f;
-                }
-            }
+    // Averaging over the window reaches the held gain exactly as the peak
+    // leaves the delay line, since every averaged value is at or below it
+    attackSum += static_cast<double>(releaseGain - attackRing[static_cast<size_t>(attackPosition)]);
+    attackRing[static_cast<size_t>(attackPosition)] = releaseGain;
+    attackPosition = attackPosition + 1 == capacity ? 0 : attackPosition + 1;
 
-            if (detectLevel > ceiling)
-            {
-                targetGainReduction = ceiling / detectLevel;
-            }
+    return static_cast<float>(attackSum / capacity);
+}
+
+void OutputLimiter::processLookahead(float* const* channels, int numChannels, int startSample, int numSamples) noexcept
+{
+    jassert(numChannels <= delayChannels);
+    numChannels = std::min(numChannels, delayChannels);
 
-            gainReduction.setTargetValue(targetGainReduction);
-            // Instant attack, smoothed release: reductions apply immediately
-            // (true peak limiting), recoveries ride the 5ms smoother
-            const float currentGainReduction = std::min(gainReduction.getNextValue(), targetGainReduction);
-            lastGainReduction = 1.0f - currentGainReduction;
+    float* levels = dynamics.getDetector();
+    float* gains = dynamics.getGains();
 
-            for (int channel = 0; channel < numChannels; ++channel)
-            {
-                float inputSample = buffer.getSample(channel, sample);
-                inputSample *= currentGainReduction;
-                const float saturated = processSaturation(inputSample, 1.5f);
-                const float limited = juce::jlimit(-ceiling, ceiling, saturated);
-                buffer.setSample(channel, sample, limited);
-            }
+    truePeak.process(channels, numChannels, startSample, numSamples, levels);
+
+    for (int i = 0; i < numSamples; ++i)
+        gains[i] = nextLookaheadGain(levels[i]);
+    lastGainReduction = 1.0f - gains[numSamples - 1];
+
+    // Delay the audio to meet the gain computed for it
+    for (int channel = 0; channel < numChannels; ++channel)
+    {
+        float* data = channels[channel] + startSample;
+        float* line = delayLine(channel);
+        int position = delayPosition;
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const float delayed = line[position];
+            line[position] = data[i];
+            data[i] = delayed;
+            position = position + 1 == lookaheadSamples ? 0 : position + 1;
         }
     }
+    delayPosition = (delayPosition + numSamples) % lookaheadSamples;
+
+    dynamics.applyGain(channels, numChannels, startSample, numSamples);
+
+    // The ramp already holds the ceiling; the clamp only catches rounding
+    for (int channel = 0; channel < numChannels; ++channel)
+    {
+        float* data = channels[channel] + startSample;
+        juce::FloatVectorOperations::clip(data, data, -ceiling, ceiling, numSamples);
+    }
 }
 
 void OutputLimiter::setOutputLevel(float normalizedLevel)
@@ -1,6 +1,9 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include "LinkedDynamics.h"
+#include "TruePeakDetector.h"
+#include <vector>
 
 namespace DSP
 {
@@ -23,8 +26,26 @@ public:
     float getCeilingDb() const { return juce::Decibels::gainToDecibels(ceiling); }
     float getGainReduction() const { return lastGainReduction; }
 
+    // Look-ahead true-peak mode. 0 keeps the default instant-attack sample-peak
+    // limiter with soft saturation; otherwise minLookaheadMs..maxLookaheadMs
+    // of delay lets the gain ramp down ahead of each 4x-oversampled peak so
+    // the ceiling holds without clipping. Applied by prepare() — message
+    // thread only
+    static constexpr float minLookaheadMs = 0.5f;
+    static constexpr float maxLookaheadMs = 5.0f;
+    void setLookahead(float milliseconds);
+    // The look-ahead setLookahead() would store for a request
+    static float clampLookahead(float milliseconds) noexcept;
+    float getLookaheadMs() const noexcept { return lookaheadMs; }
+    // Delay added by the look-ahead as prepared, 0 when off
+    int getLatencySamples() const noexcept { return lookaheadSamples; }
+
 private:
-    float processSaturation(float sample, float drive) const;
+    float processSaturation(float sample, float drive) const noexcept;
+    void processLookahead(float* const* channels, int numChannels, int startSample, int numSamples) noexcept;
+    float nextLookaheadGain(float level) noexcept;
+    void resetLookahead() noexcept;
+    float* delayLine(int channel) noexcept { return delayBuffer.data() + channel * lookaheadSamples; }
 
     double sampleRate = 44100.0;
     int maxBlockSize = 512;
@@ -43,12 +64,41 @@ private:
 
     float lastGainReduction = 0.0f;
 
+    LinkedDynamics dynamics;
+
+    // Look-ahead state, sized by prepare(). A peak reaches the gain computer
+    // TruePeakDetector::latency samples late, so the hold window and attack
+    // ramp both span the remaining lookaheadWindow samples
+    float lookaheadMs = 0.0f;
+    int lookaheadSamples = 0;
+    int lookaheadWindow = 0;
+    TruePeakDetector truePeak;
+    std::vector<float> delayBuffer;             // [channel][lookaheadSamples]
+    int delayChannels = 0;
+    int delayPosition = 0;
+
+    // Sliding minimum of the required gain: monotonic deque in a ring,
+    // amortised O(1) per sample
+    std::vector<float> holdGains;
+    std::vector<juce::int64> holdIndices;
+    int holdHead = 0;
+    int holdSize = 0;
+    juce::int64 detectorIndex = 0;
+
+    float releaseGain = 1.0f;
+
+    // Attack ramp: moving average of the held gain
+    std::vector<float> attackRing;
+    int attackPosition = 0;
+    double attackSum = 0.0;
+
     juce::dsp::StateVariableTPTFilter<float> dcBlockFilter;
 
     static constexpr float dcBlockFreq = 5.0f;
     static constexpr float attackTimeMs = 0.5f;
     static constexpr float releaseTimeMs = 100.0f;
     static constexpr float saturationKnee = 0.7f;
+    static constexpr float truePeakMargin = 1.0f / TruePeakDetector::worstCaseReading;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(OutputLimiter)
 };
@@ -0,0 +1,139 @@
+#include "Oversampler.h"
+
+namespace DSP
+{
+
+Oversampler::Config Oversampler::sanitise(Config c)
+{
+    // Nearest supported power of two in [1, 8]
+    if (c.factor >= 6)      c.factor = 8;
+    else if (c.factor >= 3) c.factor = 4;
+    else if (c.factor >= 2) c.factor = 2;
+    else                    c.factor = 1;
+    return c;
+}
+
+int Oversampler::factorToOrder(int factor)
+{
+    int order = 0;
+    while ((1 << order) < factor)
+        ++order;
+    return order;
+}
+
+void Oversampler::prepare(const juce::dsp::ProcessSpec& spec, const Config& newConfig, int stageLatency)
+{
+    jassert(stageLatency >= 0);
+    stageLatencySamples = juce::jmax(0, stageLatency);
+
+    const auto sanitised = sanitise(newConfig);
+    const auto channels = std::max<juce::uint32>(1, spec.numChannels);
+
+    sampleRate = spec.sampleRate > 0.0 ? spec.sampleRate : 44100.0;
+    maxBlockSize = std::max<juce::uint32>(1, spec.maximumBlockSize);
+
+    if (oversampling == nullptr || sanitised != config || channels != numChannels)
+    {
+        config = sanitised;
+        numChannels = channels;
+
+        const auto type = config.filter == FilterType::LinearPhaseFIR
+            ? juce::dsp::Oversampling<float>::filterHalfBandFIREquiripple
+            : juce::dsp::Oversampling<float>::filterHalfBandPolyphaseIIR;
+
+        // Order 0 is a pass-through stage, so 1x keeps the same call pattern.
+        // Integer latency: the dry path and host PDC can then match it exactly.
+        oversampling = std::make_unique<juce::dsp::Oversampling<float>>(
+            static_cast<size_t>(numChannels), static_cast<size_t>(factorToOrder(config.factor)), type, true, true);
+    }
+
+    oversampling->initProcessing(static_cast<size_t>(maxBlockSize));
+
+    matchDelayLength = juce::roundToInt(getLatencySamples());
+    matchDelay.assign(numChannels, std::vector<float>(static_cast<size_t>(std::max(1, matchDelayLength)), 0.0f));
+
+    reset();
+}
+
+void Oversampler::reset()
+{
+    if (oversampling != nullptr)
+        oversampling->reset();
+
+    for (auto& line : matchDelay)
+        std::fill(line.begin(), line.end(), 0.0f);
+    matchDelayPos = 0;
+}
+
+juce::dsp::AudioBlock<float> Oversampler::processUp(const juce::dsp::AudioBlock<float>& block)
+{
+    jassert(oversampling != nullptr);
+    return oversampling->processSamplesUp(block);
+}
+
+void Oversampler::processDown(juce::dsp::AudioBlock<float>& block)
+{
+    jassert(oversampling != nullptr);
+    oversampling->processSamplesDown(block);
+}
+
+void Oversampler::delayToMatch(const juce::dsp::AudioBlock<const float>& input, juce::dsp::AudioBlock<float>& output)
+{
+    jassert(input.getNumSamples() == output.getNumSamples());
+    jassert(input.getNumChannels() >= output.getNumChannels());
+
+    const int numSamples = static_cast<int>(std::min(input.getNumSamples(), output.getNumSamples()));
+    const int numChannels = static_cast<int>(std::min(input.getNumChannels(), output.getNumChannels()));
+
+    // Channels without a delay line (or no latency to match) pass straight
+    const int channels = matchDelayLength > 0 ? std::min(numChannels, static_cast<int>(matchDelay.size())) : 0;
+    for (int ch = channels; ch < numChannels; ++ch)
+    {
+        const float* in = input.getChannelPointer(static_cast<size_t>(ch));
+        float* out = output.getChannelPointer(static_cast<size_t>(ch));
+        if (in != out)
+            juce::FloatVectorOperations::copy(out, in, numSamples);
+    }
+
+    if (channels == 0)
+        return;
+
+    int pos = matchDelayPos;
+
+    for (int ch = 0; ch < channels; ++ch)
+    {
+        const float* in = input.getChannelPointer(static_cast<size_t>(ch));
+        float* out = output.getChannelPointer(static_cast<size_t>(ch));
+        float* line = matchDelay[static_cast<size_t>(ch)].data();
+        pos = matchDelayPos;
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const float delayed = line[pos];
+            line[pos] = in[i];
+            out[i] = delayed;
+
+            if (++pos == matchDelayLength)
+                pos = 0;
+        }
+    }
+
+    matchDelayPos = pos;
+}
+
+juce::dsp::ProcessSpec Oversampler::getOversampledSpec() const
+{
+    juce::dsp::ProcessSpec spec;
+    spec.sampleRate = getOversampledRate();
+    spec.maximumBlockSize = maxBlockSize * static_cast<juce::uint32>(config.factor);
+    spec.numChannels = numChannels;
+    return spec;
+}
+
+float Oversampler::getLatencySamples() const
+{
+    const float roundTrip = oversampling != nullptr ? static_cast<float>(oversampling->getLatencyInSamples()) : 0.0f;
+    return roundTrip + static_cast<float>(stageLatencySamples);
+}
+
+} // namespace DSP
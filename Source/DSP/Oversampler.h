@@ -0,0 +1,84 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <memory>
+#include <vector>
+
+namespace DSP
+{
+
+/**
+ * Shared oversampling domain for the nonlinear stages.
+ *
+ * FuzzEngine and OctaveGenerator both run between one processUp() and one
+ * processDown(), so the chain pays a single conversion pair. Factor and
+ * filter type are fixed per prepare(); changing them rebuilds the filters
+ * and must happen off the audio thread.
+ */
+class Oversampler
+{
+public:
+    enum class FilterType
+    {
+        MinimumPhaseIIR,  // Polyphase half-band IIR: low latency, live use
+        LinearPhaseFIR    // Equiripple half-band FIR: phase-linear, mixing/bounce
+    };
+
+    struct Config
+    {
+        int factor = 2;                              // 1, 2, 4 or 8
+        FilterType filter = FilterType::MinimumPhaseIIR;
+
+        bool operator==(const Config& other) const { return factor == other.factor && filter == other.filter; }
+        bool operator!=(const Config& other) const { return !(*this == other); }
+    };
+
+    Oversampler() = default;
+    ~Oversampler() = default;
+
+    // stageLatency: whole native-rate samples the stages inside the domain
+    // delay the signal by, matched on the dry path and reported with the
+    // round trip
+    void prepare(const juce::dsp::ProcessSpec& spec, const Config& newConfig, int stageLatency = 0);
+    void reset();
+
+    // Upsamples into internal storage and returns the oversampled view
+    juce::dsp::AudioBlock<float> processUp(const juce::dsp::AudioBlock<float>& block);
+    // Downsamples the last processUp() result back into block
+    void processDown(juce::dsp::AudioBlock<float>& block);
+    // Delays a parallel (dry) path by the round-trip latency so it stays
+    // phase-aligned with the oversampled path when the two are blended.
+    // Out of place, so capturing the dry path and delaying it is one pass;
+    // input and output may be the same block
+    void delayToMatch(const juce::dsp::AudioBlock<const float>& input, juce::dsp::AudioBlock<float>& output);
+
+    const Config& getConfig() const { return config; }
+    int getFactor() const { return config.factor; }
+    double getOversampledRate() const { return sampleRate * config.factor; }
+    // Spec the oversampled stages should be prepared with
+    juce::dsp::ProcessSpec getOversampledSpec() const;
+    // Round-trip filter latency plus the stage latency, at the native rate
+    float getLatencySamples() const;
+
+    static Config sanitise(Config c);
+
+private:
+    static int factorToOrder(int factor);
+
+    double sampleRate = 44100.0;
+    juce::uint32 maxBlockSize = 512;
+    juce::uint32 numChannels = 2;
+
+    Config config;
+    std::unique_ptr<juce::dsp::Oversampling<float>> oversampling;
+    int stageLatencySamples = 0;
+
+    // Latency-matching delay: one ring per channel, latency samples long
+    std::vector<std::vector<float>> matchDelay;
+    int matchDelayLength = 0;
+    int matchDelayPos = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(Oversampler)
+};
+
+} // namespace DSP
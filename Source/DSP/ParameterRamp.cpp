@@ -0,0 +1,72 @@
+#include "ParameterRamp.h"
+#include <cmath>
+
+namespace DSP
+{
+
+void ParameterRamp::prepare(double sampleRate, double rampLengthSeconds, int maxBlockSize)
+{
+    stepsToTarget = static_cast<int>(std::floor(rampLengthSeconds * (sampleRate > 0.0 ? sampleRate : 44100.0)));
+    values.assign(static_cast<size_t>(std::max(1, maxBlockSize)), 0.0f);
+
+    setCurrentAndTargetValue(targetValue);
+}
+
+void ParameterRamp::setCurrentAndTargetValue(float newValue) noexcept
+{
+    currentValue = targetValue = newValue;
+    countdown = 0;
+}
+
+void ParameterRamp::setTargetValue(float newValue) noexcept
+{
+    if (newValue == targetValue)
+        return;
+
+    if (stepsToTarget <= 0)
+    {
+        setCurrentAndTargetValue(newValue);
+        return;
+    }
+
+    targetValue = newValue;
+    countdown = stepsToTarget;
+
+    step = (targetValue - currentValue) / static_cast<float>(countdown);
+}
+
+RampBlock ParameterRamp::process(int numSamples) noexcept
+{
+    if (countdown <= 0 || numSamples <= 0)
+        return RampBlock::constant(targetValue);
+
+    // Host violated prepareToPlay: no storage for this block, snap to target
+    if (numSamples > static_cast<int>(values.size()))
+    {
+        jassertfalse;
+        setCurrentAndTargetValue(targetValue);
+        return RampBlock::constant(targetValue);
+    }
+
+    float* out = values.data();
+    const int rampSamples = std::min(numSamples, countdown);
+
+    // Closed form per sample (no running sum), so the loop vectorises
+    const float start = currentValue;
+    for (int i = 0; i < rampSamples; ++i)
+        out[i] = start + step * static_cast<float>(i + 1);
+
+    countdown -= rampSamples;
+
+    if (countdown == 0)
+    {
+        // Land exactly on the target: the ramp's rounding never leaks past it
+        out[rampSamples - 1] = targetValue;
+        juce::FloatVectorOperations::fill(out + rampSamples, targetValue, numSamples - rampSamples);
+    }
+
+    currentValue = out[rampSamples - 1];
+    return { out, out[numSamples - 1], numSamples };
+}
+
+} // namespace DSP
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <vector>
+
+namespace DSP
+{
+
+/**
+ * One block of a smoothed parameter, as handed to a DSP stage.
+ *
+ * Static blocks carry no array: the parameter holds `value` for the whole
+ * block, so the stage can take its constant-gain path. Ramping blocks point
+ * at numSamples contiguous values owned by the ParameterRamp that rendered
+ * them, valid until that ramp's next process() call.
+ */
+struct RampBlock
+{
+    const float* values = nullptr;
+    float value = 0.0f;    // Held value when static, last value of the ramp otherwise
+    int numSamples = 0;
+
+    static RampBlock constant(float v) noexcept { return { nullptr, v, 0 }; }
+
+    bool isStatic() const noexcept { return values == nullptr; }
+    float operator[](int i) const noexcept { return values != nullptr ? values[i] : value; }
+};
+
+/**
+ * Block-rate replacement for juce::SmoothedValue.
+ *
+ * Instead of getNextValue() per sample in every consumer, the ramp is
+ * rendered once per block into a contiguous array. Once the target is
+ * reached, process() returns a static block and costs nothing.
+ */
+class ParameterRamp
+{
+public:
+    explicit ParameterRamp(float initialValue = 0.0f) noexcept
+        : currentValue(initialValue), targetValue(initialValue) {}
+
+    // Allocates the block storage — call from prepareToPlay only
+    void prepare(double sampleRate, double rampLengthSeconds, int maxBlockSize);
+
+    void setCurrentAndTargetValue(float newValue) noexcept;
+    void setTargetValue(float newValue) noexcept;
+
+    // Audio thread: renders the next numSamples values (if still ramping)
+    RampBlock process(int numSamples) noexcept;
+
+    bool isSmoothing() const noexcept { return countdown > 0; }
+    float getCurrentValue() const noexcept { return currentValue; }
+    float getTargetValue() const noexcept { return targetValue; }
+
+private:
+    std::vector<float> values;
+
+    float currentValue = 0.0f;
+    float targetValue = 0.0f;
+    float step = 0.0f;          // Increment per sample
+    int stepsToTarget = 0;
+    int countdown = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ParameterRamp)
+};
+
+} // namespace DSP
@@ -1,5 +1,5 @@
 #include "PitchShifter.h"
-#include "LookupTables.h"
+#include "MathKernels.h"
 #include <cmath>
 
 namespace DSP
@@ -9,18 +9,15 @@ void PitchShifter::prepare(const juce::dsp::ProcessSpec& spec)
 {
     sampleRate = spec.sampleRate;
     maxBlockSize = static_cast<int>(spec.maximumBlockSize);
+    numChannels = std::max(1, static_cast<int>(spec.numChannels));
 
     if (sampleRate <= 0.0)
         sampleRate = 44100.0;
 
-    LookupTables::initialize();
-
-    chaos.reset(sampleRate, 0.02);
-    panic.reset(sampleRate, 0.02);
-
     // Buffer must hold >= 4x the max window at this sample rate
     const int maxWindowSamples = static_cast<int>(maxWindowMs * 0.001 * sampleRate);
     delayBufferSize = juce::nextPowerOfTwo(std::max(8192, maxWindowSamples * 4));
+    delayBufferMask = delayBufferSize - 1;
 
     windowSizeSamples = static_cast<int>(defaultWindowMs * 0.001 * sampleRate);
     windowSizeSamples = juce::jlimit(256, delayBufferSize / 4, windowSizeSamples);
@@ -30,8 +27,26 @@ void PitchShifter::prepare(const juce::dsp::ProcessSpec& spec)
     envelopeAttackCoeff = static_cast<float>(1.0 - std::exp(-1.0 / (sampleRate * envelopeAttackMs * 0.001)));
     envelopeReleaseCoeff = static_cast<float>(1.0 - std::exp(-1.0 / (sampleRate * envelopeReleaseMs * 0.001)));
 
-    for (int ch = 0; ch < maxChannels; ++ch)
-        delayBuffer[ch].assign(static_cast<size_t>(delayBufferSize), 0.0f);
+    const auto channels = static_cast<size_t>(numChannels);
+    delayBuffer.assign(channels * static_cast<size_t>(delayBufferSize), 0.0f);
+    feedbackSamples.assign(channels, 0.0f);
+    dryEnvelope.assign(channels, 0.0f);
+    wetEnvelope.assign(channels, 0.0f);
+    channelPointers.assign(channels, nullptr);
+    wetScratch.assign(channels, 0.0f);
+
+    buildSincTable();
+
+    const auto controlSize = static_cast<size_t>(std::max(1, maxBlockSize));
+    for (int h = 0; h < numHeads; ++h)
+    {
+        headPositions[h].assign(controlSize, 0.0f);
+        headGains[h].assign(controlSize, 0.0f);
+    }
+    mainHeadNorms.assign(controlSize, 1.0f);
+    feedbackAmounts.assign(controlSize, 0.0f);
+    wetMixes.assign(controlSize, 0.0f);
+    ringModGains.assign(controlSize, 1.0f);
 
     writePosition = 0;
 
@@ -49,13 +64,10 @@ void PitchShifter::prepare(const juce::dsp::ProcessSpec& spec)
     mixSmoothState = 0.0f;
     currentPitchRatio = 1.0f;
     currentMix = 0.0f;
-    feedbackSamples.fill(0.0f);
     ringModPhase = 0.0f;
     ringModFreq = 0.0f;
     ringModMix = 0.0f;
     panicAmount = 0.0f;
-    dryEnvelope.fill(0.0f);
-    wetEnvelope.fill(0.0f);
     transitionActive = false;
 
     prevOctaveOneActive = false;
@@ -66,8 +78,7 @@ void PitchShifter::prepare(const juce::dsp::ProcessSpec& spec)
 
 void PitchShifter::reset()
 {
-    for (int ch = 0; ch < maxChannels; ++ch)
-        std::fill(delayBuffer[ch].begin(), delayBuffer[ch].end(), 0.0f);
+    std::fill(delayBuffer.begin(), delayBuffer.end(), 0.0f);
 
     writePosition = 0;
 
@@ -79,49 +90,16 @@ void PitchShifter::reset()
     mixSmoothState = 0.0f;
     currentPitchRatio = 1.0f;
     currentMix = 0.0f;
-    feedbackSamples.fill(0.0f);
+    std::fill(feedbackSamples.begin(), feedbackSamples.end(), 0.0f);
     ringModPhase = 0.0f;
-    dryEnvelope.fill(0.0f);
-    wetEnvelope.fill(0.0f);
+    std::fill(dryEnvelope.begin(), dryEnvelope.end(), 0.0f);
+    std::fill(wetEnvelope.begin(), wetEnvelope.end(), 0.0f);
     transitionActive = false;
 
     prevOctaveOneActive = false;
     prevOctaveTwoActive = false;
 }
 
-float PitchShifter::readFromBuffer(int channel, float position) const
-{
-    channel = juce::jlimit(0, maxChannels - 1, channel);
-
-    // NaN/Inf must be rejected BEFORE the wrap loops — they never terminate on NaN
-    if (!std::isfinite(position))
-        return 0.0f;
-
-    // Wrap position to buffer size
-    const float bufSize = static_cast<float>(delayBufferSize);
-    position -= bufSize * std::floor(position / bufSize);
-    if (position >= bufSize) position = 0.0f;
-
-    // 4-point Hermite cubic interpolation
-    const int idx0 = static_cast<int>(position);
-    const int idxM1 = (idx0 - 1 + delayBufferSize) % delayBufferSize;
-    const int idx1 = (idx0 + 1) % delayBufferSize;
-    const int idx2 = (idx0 + 2) % delayBufferSize;
-    const float frac = position - static_cast<float>(idx0);
-
-    const float y0 = delayBuffer[channel][idxM1];
-    const float y1 = delayBuffer[channel][idx0];
-    const float y2 = delayBuffer[channel][idx1];
-    const float y3 = delayBuffer[channel][idx2];
-
-    const float c0 = y1;
-    const float c1 = 0.5f * (y2 - y0);
-    const float c2 = y0 - 2.5f * y1 + 2.0f * y2 - 0.5f * y3;
-    const float c3 = 0.5f * (y3 - y0) + 1.5f * (y1 - y2);
-
-    return ((c3 * frac + c2) * frac + c1) * frac + c0;
-}
-
 void PitchShifter::resetHeadsForTransition()
 {
     const float bufSize = static_cast<float>(delayBufferSize);
@@ -143,15 +121,38 @@ void PitchShifter::resetHeadsForTransition()
     detuneHeads[1].ramp = 0.75f;
 }
 
+void PitchShifter::writeIdleBlock(const juce::AudioBuffer<float>& buffer, int channelsToWrite, int numSamples)
+{
+    // Idle implies zero feedback, so the line is a plain (sanitised) copy of
+    // the input, written as at most two contiguous runs around the wrap point
+    const int firstRun = std::min(numSamples, delayBufferSize - writePosition);
+
+    for (int ch = 0; ch < channelsToWrite; ++ch)
+    {
+        const float* input = buffer.getReadPointer(ch);
+        float* line = delayLine(ch);
+
+        for (int i = 0; i < firstRun; ++i)
+            line[writePosition + i] = std::isfinite(input[i]) ? input[i] : 0.0f;
+
+        for (int i = firstRun; i < numSamples; ++i)
+            line[(writePosition + i) & delayBufferMask] = std::isfinite(input[i]) ? input[i] : 0.0f;
+    }
+
+    writePosition = (writePosition + numSamples) & delayBufferMask;
+}
+
 void PitchShifter::process(juce::AudioBuffer<float>& buffer)
 {
     const int numSamples = buffer.getNumSamples();
-    const int numChannels = buffer.getNumChannels();
+    const int bufferChannels = buffer.getNumChannels();
 
-    if (numSamples <= 0 || numChannels <= 0)
+    if (numSamples <= 0 || bufferChannels <= 0)
         return;
 
-    const int processChannels = std::min(numChannels, maxChannels);
+    // Channels beyond the prepared count have no delay line
+    jassert(bufferChannels <= static_cast<int>(channelPointers.size()));
+    const int processChannels = std::min(bufferChannels, static_cast<int>(channelPointers.size()));
 
     const bool oct1Active = octaveOneActive.load(std::memory_order_relaxed);
     const bool oct2Active = octaveTwoActive.load(std::memory_order_relaxed);
@@ -184,46 +185,89 @@ void PitchShifter::process(juce::AudioBuffer<float>& buffer)
     prevOctaveOneActive = oct1Active;
     prevOctaveTwoActive = oct2Active;
 
+    // Bypass: nothing to render, keep the delay line current for the next engage
+    if (!anyOctaveActive && mixSmoothState <= 0.0f)
+    {
+        writeIdleBlock(buffer, processChannels, numSamples);
+        chaos = RampBlock::constant(chaos.value);
+        panic = RampBlock::constant(panic.value);
+        chaosMix = RampBlock::constant(chaosMix.value);
+        return;
+    }
+
+    float** channelData = channelPointers.data();
+
+    // Control arrays hold maxBlockSize samples; larger host blocks run in slices
+    const int sliceSize = std::max(1, maxBlockSize);
+    for (int start = 0; start < numSamples; start += sliceSize)
+    {
+        const int sliceSamples = std::min(sliceSize, numSamples - start);
+
+        for (int ch = 0; ch < processChannels; ++ch)
+            channelData[ch] = buffer.getWritePointer(ch) + start;
+
+        const int activeSamples = computeHeadTrajectories(start, sliceSamples, targetPitchRatio,
+                                                          targetMix, anyOctaveActive);
+        renderBlock(channelData, processChannels, start, sliceSamples, activeSamples);
+    }
+
+    // Ramp arrays are only valid for this call
+    chaos = RampBlock::constant(chaos.value);
+    panic = RampBlock::constant(panic.value);
+    chaosMix = RampBlock::constant(chaosMix.value);
+}
+
+int PitchShifter::computeHeadTrajectories(int startSample, int numSamples, float targetPitchRatio,
+                                          float targetMix, bool anyOctaveActive)
+{
     const float safeRiseCoeff = (riseCoeff > 0.0f && std::isfinite(riseCoeff)) ? riseCoeff : 0.002f;
     const float safeFallCoeff = (fallCoeff > 0.0f && std::isfinite(fallCoeff)) ? fallCoeff : 0.002f;
 
     const float bufSize = static_cast<float>(delayBufferSize);
 
-    float* channelData[maxChannels] = {};
-    for (int ch = 0; ch < processChannels; ++ch)
-        channelData[ch] = buffer.getWritePointer(ch);
-
     const bool hasModBuffers = (pitchModBuffer != nullptr && grainModBuffer != nullptr
                                 && timingModBuffer != nullptr);
 
+    // Local write cursor: resets are placed relative to where the audio pass
+    // will be writing at that sample
+    int writePos = writePosition;
+    int activeSamples = 0;
+    detuneHeadsActive = false;
+    clearFeedbackAfterActive = false;
+
     for (int sample = 0; sample < numSamples; ++sample)
     {
-        const float chaosVal = chaos.getNextValue();
-        const float panicVal = panic.getNextValue();
+        const float chaosVal = chaos[startSample + sample];
+        const float panicVal = panic[startSample + sample];
 
         if (hasModBuffers)
         {
-            pitchModulation = pitchModBuffer[sample];
-            grainSizeModulation = grainModBuffer[sample];
-            timingModulation = timingModBuffer[sample];
+            pitchModulation = pitchModBuffer[startSample + sample];
+            grainSizeModulation = grainModBuffer[startSample + sample];
+            timingModulation = timingModBuffer[startSample + sample];
         }
 
-        // Write input to delay buffer with feedback
-        for (int ch = 0; ch < processChannels; ++ch)
-        {
-            float inputSample = channelData[ch][sample];
-            if (!std::isfinite(inputSample)) inputSample = 0.0f;
-
-            const float feedbackAmount = chaosVal * 0.4f;
-            const float feedbackInput = inputSample + std::tanh(feedbackSamples[ch] * feedbackAmount) * feedbackAmount;
-            delayBuffer[ch][writePosition] = feedbackInput;
-        }
+        feedbackAmounts[sample] = chaosVal * 0.4f;
 
+        // Once idle, nothing below re-arms within the block — active samples
+        // are always a prefix
         const bool needsProcessing = anyOctaveActive || mixSmoothState > 0.0001f;
 
         if (!needsProcessing)
         {
-            writePosition = (writePosition + 1) % delayBufferSize;
+            // Fully decayed: settle into the idle state so following blocks
+            // take the bypass path. Feedback is cleared after the last active
+            // sample, otherwise its stale value keeps leaking into the line.
+            if (mixSmoothState > 0.0f || transitionActive)
+            {
+                mixSmoothState = 0.0f;
+                currentPitchRatio = 1.0f;
+                currentMix = 0.0f;
+                transitionActive = false;
+                clearFeedbackAfterActive = true;
+            }
+
+            writePos = (writePos + 1) & delayBufferMask;
             continue;
         }
 
@@ -237,6 +281,7 @@ void PitchShifter::process(juce::AudioBuffer<float>& buffer)
         // Smoothstep S-curve for mix
         const float mx = mixSmoothState;
         const float effectiveMix = mx * mx * (3.0f - 2.0f * mx);
+        wetMixes[sample] = effectiveMix;
 
         // Apply chaos modulation to pitch ratio
         const float pitchMod = pitchModulation * chaosVal * 0.4f;
@@ -265,111 +310,68 @@ void PitchShifter::process(juce::AudioBuffer<float>& buffer)
         const float detuneUp = 1.0f + panicVal * 0.15f;
         const float detuneDown = 1.0f - panicVal * 0.15f;
 
-        for (int ch = 0; ch < processChannels; ++ch)
+        // Main head gains from ramp position
+        for (int h = 0; h < numMainHeads; ++h)
         {
-            const float dryInput = channelData[ch][sample];
-            float wetSum = 0.0f;
-
-            // Process main heads
-            for (int h = 0; h < numMainHeads; ++h)
+            // Hann-like envelope: gain = 0.5 - 0.5 * cos(2*PI*ramp)
+            float gain;
+            const float ramp = mainHeads[h].ramp;
+            if (harshness < 0.001f)
             {
-                // Compute crossfade gain from ramp position
-                // Hann-like envelope: gain = 0.5 - 0.5 * cos(2*PI*ramp)
-                float gain;
-                const float ramp = mainHeads[h].ramp;
-                if (harshness < 0.001f)
-                {
-                    // Pure cosine crossfade
-                    gain = 0.5f - 0.5f * LookupTables::fastCos(ramp);
-                }
-                else
-                {
-                    // Blend between cosine and rectangular based on harshness
-                    const float cosGain = 0.5f - 0.5f * LookupTables::fastCos(ramp);
-                    // Rectangular: 1.0 in middle, 0.0 at edges.
-                    // Floor of 0.02 keeps a minimal fade even at max harshness so
-                    // grain boundaries never hard-discontinue
-                    const float edgeFade = 0.05f * (1.0f - harshness) + 0.02f;
-                    float rectGain = 1.0f;
-                    if (ramp < edgeFade)
-                        rectGain = ramp / edgeFade;
-                    else if (ramp > 1.0f - edgeFade)
-                        rectGain = (1.0f - ramp) / edgeFade;
-                    gain = cosGain * (1.0f - harshness) + rectGain * harshness;
-                }
-
-                wetSum += readFromBuffer(ch, mainHeads[h].readPosition) * gain;
+                // Pure cosine crossfade
+                gain = 0.5f - 0.5f * MathKernels::Cosine<>::evaluate(ramp);
             }
-
-            // Two 180° offset Hann windows sum to exactly 1.0; rectangular
-            // windows sum toward 2.0, so renormalize as harshness blends in
-            wetSum /= (1.0f + harshness);
-
-            // PANIC detuned heads
-            if (panicVal > 0.001f)
+            else
             {
-                for (int h = 0; h < numDetuneHeads; ++h)
-                {
-                    const float ramp = detuneHeads[h].ramp;
-                    const float gain = 0.5f - 0.5f * LookupTables::fastCos(ramp);
-                    wetSum += readFromBuffer(ch, detuneHeads[h].readPosition) * gain * panicVal;
-                }
+                // Blend between cosine and rectangular based on harshness
+                const float cosGain = 0.5f - 0.5f * MathKernels::Cosine<>::evaluate(ramp);
+                // Rectangular: 1.0 in middle, 0.0 at edges.
+                // Floor of 0.02 keeps a minimal fade even at max harshness so
+                // grain boundaries never hard-discontinue
+                const float edgeFade = 0.05f * (1.0f - harshness) + 0.02f;
+                float rectGain = 1.0f;
+                if (ramp < edgeFade)
+                    rectGain = ramp / edgeFade;
+                else if (ramp > 1.0f - edgeFade)
+                    rectGain = (1.0f - ramp) / edgeFade;
+                gain = cosGain * (1.0f - harshness) + rectGain * harshness;
             }
 
-            // PANIC adds on top of normalized main heads, scaled by panicVal
-            float wetOutput = wetSum;
-
-            if (!std::isfinite(wetOutput))
-                wetOutput = dryInput;
-
-            // Ring modulation (post-pitch, pre-mix)
-            if (ringModMix > 0.001f)
-            {
-                const float ringModSine = LookupTables::fastSin(ringModPhase);
-                wetOutput = wetOutput * (1.0f - ringModMix) + wetOutput * ringModSine * ringModMix;
-            }
-
-            // Gain compensation: match wet level to dry level (per channel)
-            {
-                const float dryAbs = std::abs(dryInput);
-                const float wetAbs = std::abs(wetOutput);
-
-                const float dryCoeff = (dryAbs > dryEnvelope[ch]) ? envelopeAttackCoeff : envelopeReleaseCoeff;
-                dryEnvelope[ch] += dryCoeff * (dryAbs - dryEnvelope[ch]);
-
-                const float wetCoeff = (wetAbs > wetEnvelope[ch]) ? envelopeAttackCoeff : envelopeReleaseCoeff;
-                wetEnvelope[ch] += wetCoeff * (wetAbs - wetEnvelope[ch]);
+            headPositions[h][sample] = mainHeads[h].readPosition;
+            headGains[h][sample] = gain;
+        }
 
-                if (wetEnvelope[ch] > 0.0001f && dryEnvelope[ch] > 0.0001f)
-                {
-                    const float gainComp = dryEnvelope[ch] / wetEnvelope[ch];
-                    wetOutput *= juce::jlimit(0.5f, 4.0f, gainComp);
-                }
-                else if (wetAbs < 0.0001f && dryAbs > 0.001f)
-                {
-                    wetOutput = dryInput;
-                }
-            }
+        // Two 180° offset Hann windows sum to exactly 1.0; rectangular
+        // windows sum toward 2.0, so renormalize as harshness blends in
+        mainHeadNorms[sample] = 1.0f / (1.0f + harshness);
 
-            const float outputSample = dryInput * (1.0f - effectiveMix) + wetOutput * effectiveMix;
-            float finalOutput = outputSample;
-            if (!std::isfinite(finalOutput))
-                finalOutput = dryInput;
+        // PANIC detuned heads add on top of the normalized main heads
+        for (int h = 0; h < numDetuneHeads; ++h)
+        {
+            const float gain = panicVal > 0.001f
+                ? (0.5f - 0.5f * MathKernels::Cosine<>::evaluate(detuneHeads[h].ramp)) * panicVal
+                : 0.0f;
 
-            channelData[ch][sample] = finalOutput;
-            feedbackSamples[ch] = std::tanh(wetOutput);
+            headPositions[numMainHeads + h][sample] = detuneHeads[h].readPosition;
+            headGains[numMainHeads + h][sample] = gain;
         }
+        detuneHeadsActive = detuneHeadsActive || panicVal > 0.001f;
+
+        // Ring modulation (post-pitch, pre-mix) folded into one gain
+        ringModGains[sample] = ringModMix > 0.001f
+            ? (1.0f - ringModMix) + MathKernels::Sine<>::evaluate(ringModPhase) * ringModMix
+            : 1.0f;
 
-        // Advance main heads
+        // Advance main heads. Steps are bounded (pitch <= 8, window <= size/4),
+        // so a single wrap is enough in each direction
         for (int h = 0; h < numMainHeads; ++h)
         {
             mainHeads[h].ramp += rampInc;
             mainHeads[h].readPosition += modulatedPitch;
 
-            // Wrap read position
-            while (mainHeads[h].readPosition >= bufSize)
+            if (mainHeads[h].readPosition >= bufSize)
                 mainHeads[h].readPosition -= bufSize;
-            while (mainHeads[h].readPosition < 0.0f)
+            if (mainHeads[h].readPosition < 0.0f)
                 mainHeads[h].readPosition += bufSize;
 
             // When ramp completes (either direction — rampInc is negative when
@@ -378,10 +380,10 @@ void PitchShifter::process(juce::AudioBuffer<float>& buffer)
             {
                 mainHeads[h].ramp -= std::floor(mainHeads[h].ramp);
                 // -4: interpolation guard, sweep ends before reaching the write head
-                float resetPos = static_cast<float>(writePosition) - static_cast<float>(modWindowSize) - 4.0f;
+                float resetPos = static_cast<float>(writePos) - static_cast<float>(modWindowSize) - 4.0f;
                 resetPos -= std::abs(resetJitter * (random.nextFloat() * 2.0f - 1.0f));
-                while (resetPos < 0.0f) resetPos += bufSize;
-                while (resetPos >= bufSize) resetPos -= bufSize;
+                if (resetPos < 0.0f) resetPos += bufSize;
+                if (resetPos >= bufSize) resetPos -= bufSize;
                 mainHeads[h].readPosition = resetPos;
             }
         }
@@ -389,31 +391,22 @@ void PitchShifter::process(juce::AudioBuffer<float>& buffer)
         // Advance detune heads (PANIC)
         if (panicVal > 0.001f)
         {
-            const float detuneRampIncUp = (modulatedPitch * detuneUp - 1.0f) / static_cast<float>(modWindowSize);
-            const float detuneRampIncDown = (modulatedPitch * detuneDown - 1.0f) / static_cast<float>(modWindowSize);
-
-            detuneHeads[0].ramp += detuneRampIncUp;
-            detuneHeads[0].readPosition += modulatedPitch * detuneUp;
-            while (detuneHeads[0].readPosition >= bufSize) detuneHeads[0].readPosition -= bufSize;
-            while (detuneHeads[0].readPosition < 0.0f) detuneHeads[0].readPosition += bufSize;
-            if (detuneHeads[0].ramp >= 1.0f || detuneHeads[0].ramp < 0.0f)
-            {
-                detuneHeads[0].ramp -= std::floor(detuneHeads[0].ramp);
-                float resetPos = static_cast<float>(writePosition) - static_cast<float>(modWindowSize) - 4.0f;
-                while (resetPos < 0.0f) resetPos += bufSize;
-                detuneHeads[0].readPosition = resetPos;
-            }
+            const float detuneRatios[numDetuneHeads] = { detuneUp, detuneDown };
 
-            detuneHeads[1].ramp += detuneRampIncDown;
-            detuneHeads[1].readPosition += modulatedPitch * detuneDown;
-            while (detuneHeads[1].readPosition >= bufSize) detuneHeads[1].readPosition -= bufSize;
-            while (detuneHeads[1].readPosition < 0.0f) detuneHeads[1].readPosition += bufSize;
-            if (detuneHeads[1].ramp >= 1.0f || detuneHeads[1].ramp < 0.0f)
+            for (int h = 0; h < numDetuneHeads; ++h)
             {
-                detuneHeads[1].ramp -= std::floor(detuneHeads[1].ramp);
-                float resetPos = static_cast<float>(writePosition) - static_cast<float>(modWindowSize) - 4.0f;
-                while (resetPos < 0.0f) resetPos += bufSize;
-                detuneHeads[1].readPosition = resetPos;
+                auto& head = detuneHeads[h];
+                head.ramp += (modulatedPitch * detuneRatios[h] - 1.0f) / static_cast<float>(modWindowSize);
+                head.readPosition += modulatedPitch * detuneRatios[h];
+                if (head.readPosition >= bufSize) head.readPosition -= bufSize;
+                if (head.readPosition < 0.0f) head.readPosition += bufSize;
+                if (head.ramp >= 1.0f || head.ramp < 0.0f)
+                {
+                    head.ramp -= std::floor(head.ramp);
+                    float resetPos = static_cast<float>(writePos) - static_cast<float>(modWindowSize) - 4.0f;
+                    if (resetPos < 0.0f) resetPos += bufSize;
+                    head.readPosition = resetPos;
+                }
             }
         }
 
@@ -424,8 +417,9 @@ void PitchShifter::process(juce::AudioBuffer<float>& buffer)
             if (ringModPhase >= 1.0f) ringModPhase -= 1.0f;
         }
 
-        writePosition = (writePosition + 1) % delayBufferSize;
+        writePos = (writePos + 1) & delayBufferMask;
         currentMix = effectiveMix;
+        activeSamples = sample + 1;
 
         if (transitionActive && std::abs(targetMix - mixSmoothState) < 0.001f)
         {
@@ -434,10 +428,259 @@ void PitchShifter::process(juce::AudioBuffer<float>& buffer)
             {
                 mixSmoothState = 0.0f;
                 currentPitchRatio = 1.0f;
-                feedbackSamples.fill(0.0f);
+                clearFeedbackAfterActive = true;
             }
         }
     }
+
+    return activeSamples;
+}
+
+void PitchShifter::renderBlock(float* const* channelData, int channelsToRender, int startSample, int numSamples,
+                               int activeSamples)
+{
+    jassert(chaosMix.isStatic() || chaosMix.numSamples >= startSample + numSamples);
+
+    // Per-channel state as plain arrays: the channel loops below index lanes
+    float* feedback = feedbackSamples.data();
+    float* dryEnv = dryEnvelope.data();
+    float* wetEnv = wetEnvelope.data();
+    float* wetPerChannel = wetScratch.data();
+
+    for (int sample = 0; sample < numSamples; ++sample)
+    {
+        // Wet path finished inside this block: nothing feeds back from here on
+        if (sample == activeSamples && clearFeedbackAfterActive)
+            std::fill(feedbackSamples.begin(), feedbackSamples.end(), 0.0f);
+
+        // Write input to delay buffer with feedback
+        const float feedbackAmount = feedbackAmounts[sample];
+        for (int ch = 0; ch < channelsToRender; ++ch)
+        {
+            float inputSample = channelData[ch][sample];
+            if (!std::isfinite(inputSample)) inputSample = 0.0f;
+
+            if (feedbackAmount > 0.0f)
+                inputSample += std::tanh(feedback[ch] * feedbackAmount) * feedbackAmount;
+
+            delayLine(ch)[writePosition] = inputSample;
+        }
+
+        if (sample < activeSamples)
+        {
+            if (interpolation == Interpolation::Sinc)
+                readHeadsSinc(sample, channelsToRender, wetPerChannel);
+            else
+                readHeads(sample, channelsToRender, wetPerChannel);
+
+            const float effectiveMix = wetMixes[sample];
+            const float sectionMix = chaosMix[startSample + sample];
+
+            for (int ch = 0; ch < channelsToRender; ++ch)
+            {
+                const float dryInput = channelData[ch][sample];
+                float wetOutput = wetPerChannel[ch];
+
+                if (!std::isfinite(wetOutput))
+                    wetOutput = dryInput;
+
+                wetOutput *= ringModGains[sample];
+
+                // Gain compensation: match wet level to dry level (per channel)
+                {
+                    const float dryAbs = std::abs(dryInput);
+                    const float wetAbs = std::abs(wetOutput);
+
+                    const float dryCoeff = (dryAbs > dryEnv[ch]) ? envelopeAttackCoeff : envelopeReleaseCoeff;
+                    dryEnv[ch] += dryCoeff * (dryAbs - dryEnv[ch]);
+
+                    const float wetCoeff = (wetAbs > wetEnv[ch]) ? envelopeAttackCoeff : envelopeReleaseCoeff;
+                    wetEnv[ch] += wetCoeff * (wetAbs - wetEnv[ch]);
+
+                    if (wetEnv[ch] > 0.0001f && dryEnv[ch] > 0.0001f)
+                    {
+                        const float gainComp = dryEnv[ch] / wetEnv[ch];
+                        wetOutput *= juce::jlimit(0.5f, 4.0f, gainComp);
+                    }
+                    else if (wetAbs < 0.0001f && dryAbs > 0.001f)
+                    {
+                        wetOutput = dryInput;
+                    }
+                }
+
+                const float outputSample = dryInput * (1.0f - effectiveMix) + wetOutput * effectiveMix;
+                float finalOutput = outputSample;
+                if (!std::isfinite(finalOutput))
+                    finalOutput = dryInput;
+
+                // Chaos Mix against the shifter input. Past activeSamples the
+                // output already equals the input, so those samples need nothing
+                channelData[ch][sample] = dryInput + sectionMix * (finalOutput - dryInput);
+                feedback[ch] = std::tanh(wetOutput);
+            }
+        }
+
+        writePosition = (writePosition + 1) & delayBufferMask;
+    }
+}
+
+void PitchShifter::readHeads(int sample, int channelsToRead, float* wetPerChannel) const noexcept
+{
+    // One lane per (channel, head) for each pair of channels: ch0 heads 0-3,
+    // then ch1 heads 0-3. Taps are gathered with power-of-two masks
+    // (positions are already wrapped to [0, size) by the control pass), then
+    // all lanes run the 4-point Hermite polynomial together.
+    struct alignas(32) Lanes
+    {
+        float ym1[numLanes], y0[numLanes], y1[numLanes], y2[numLanes];
+        float frac[numLanes], gain[numLanes], out[numLanes];
+    };
+
+    const int headsToRead = detuneHeadsActive ? numHeads : numMainHeads;
+
+    for (int firstChannel = 0; firstChannel < channelsToRead; firstChannel += laneChannels)
+    {
+        const int groupChannels = std::min(laneChannels, channelsToRead - firstChannel);
+        Lanes lanes {};
+
+        for (int ch = 0; ch < groupChannels; ++ch)
+        {
+            const float* delay = delayLine(firstChannel + ch);
+
+            for (int h = 0; h < headsToRead; ++h)
+            {
+                const int lane = ch * numHeads + h;
+                const float position = headPositions[h][sample];
+                const int idx = static_cast<int>(position);
+
+                lanes.frac[lane] = position - static_cast<float>(idx);
+                lanes.gain[lane] = headGains[h][sample];
+                lanes.ym1[lane] = delay[(idx - 1) & delayBufferMask];
+                lanes.y0[lane] = delay[idx & delayBufferMask];
+                lanes.y1[lane] = delay[(idx + 1) & delayBufferMask];
+                lanes.y2[lane] = delay[(idx + 2) & delayBufferMask];
+            }
+        }
+
+       #if JUCE_USE_SIMD
+        using Vec = juce::dsp::SIMDRegister<float>;
+        static_assert(numLanes % Vec::SIMDNumElements == 0, "Lane count must fill whole SIMD registers");
+
+        for (size_t i = 0; i < static_cast<size_t>(numLanes); i += Vec::SIMDNumElements)
+        {
+            const auto ym1 = Vec::fromRawArray(lanes.ym1 + i);
+            const auto y0 = Vec::fromRawArray(lanes.y0 + i);
+            const auto y1 = Vec::fromRawArray(lanes.y1 + i);
+            const auto y2 = Vec::fromRawArray(lanes.y2 + i);
+            const auto frac = Vec::fromRawArray(lanes.frac + i);
+
+            const auto c1 = (y1 - ym1) * 0.5f;
+            const auto c2 = ym1 - y0 * 2.5f + y1 * 2.0f - y2 * 0.5f;
+            const auto c3 = (y2 - ym1) * 0.5f + (y0 - y1) * 1.5f;
+
+            const auto out = (((c3 * frac + c2) * frac + c1) * frac + y0) * Vec::fromRawArray(lanes.gain + i);
+            out.copyToRawArray(lanes.out + i);
+        }
+       #else
+        for (int i = 0; i < numLanes; ++i)
+        {
+            const float c1 = 0.5f * (lanes.y1[i] - lanes.ym1[i]);
+            const float c2 = lanes.ym1[i] - 2.5f * lanes.y0[i] + 2.0f * lanes.y1[i] - 0.5f * lanes.y2[i];
+            const float c3 = 0.5f * (lanes.y2[i] - lanes.ym1[i]) + 1.5f * (lanes.y0[i] - lanes.y1[i]);
+            const float f = lanes.frac[i];
+            lanes.out[i] = (((c3 * f + c2) * f + c1) * f + lanes.y0[i]) * lanes.gain[i];
+        }
+       #endif
+
+        for (int ch = 0; ch < groupChannels; ++ch)
+        {
+            const float* out = lanes.out + ch * numHeads;
+            wetPerChannel[firstChannel + ch] = (out[0] + out[1]) * mainHeadNorms[static_cast<size_t>(sample)]
+                                               + out[2] + out[3];
+        }
+    }
+}
+
+void PitchShifter::readHeadsSinc(int sample, int channelsToRead, float* wetPerChannel) const noexcept
+{
+    // Offline path: same head layout as readHeads(), 8-tap kernel per head
+    // blended between the two nearest table phases
+    const int headsToRead = detuneHeadsActive ? numHeads : numMainHeads;
+    const float* table = sincTable.data();
+
+    for (int ch = 0; ch < channelsToRead; ++ch)
+    {
+        const float* delay = delayLine(ch);
+        float out[numHeads] = {};
+
+        for (int h = 0; h < headsToRead; ++h)
+        {
+            const float position = headPositions[h][sample];
+            const int idx = static_cast<int>(position);
+            const float phase = (position - static_cast<float>(idx)) * static_cast<float>(sincPhases);
+            const int row = std::min(static_cast<int>(phase), sincPhases - 1);
+            const float blend = phase - static_cast<float>(row);
+
+            const float* k0 = table + row * sincTaps;
+            const float* k1 = k0 + sincTaps;
+
+            float acc = 0.0f;
+            for (int t = 0; t < sincTaps; ++t)
+            {
+                const float coeff = k0[t] + blend * (k1[t] - k0[t]);
+                acc += coeff * delay[(idx + t - (sincTaps / 2 - 1)) & delayBufferMask];
+            }
+
+            out[h] = acc * headGains[h][sample];
+        }
+
+        wetPerChannel[ch] = (out[0] + out[1]) * mainHeadNorms[static_cast<size_t>(sample)]
+                            + out[2] + out[3];
+    }
+}
+
+void PitchShifter::buildSincTable()
+{
+    // Kaiser-windowed sinc (beta 6: ~-60dB sidelobes over 8 taps), each
+    // phase normalised to unity DC gain so the kernel never tilts level
+    constexpr double beta = 6.0;
+    constexpr double halfWidth = sincTaps / 2;
+
+    const auto besselI0 = [](double x)
+    {
+        double sum = 1.0, term = 1.0;
+        for (int k = 1; k < 32; ++k)
+        {
+            term *= (x / (2.0 * k)) * (x / (2.0 * k));
+            sum += term;
+        }
+        return sum;
+    };
+
+    const double windowNorm = besselI0(beta);
+    sincTable.assign(static_cast<size_t>((sincPhases + 1) * sincTaps), 0.0f);
+
+    for (int p = 0; p <= sincPhases; ++p)
+    {
+        const double frac = static_cast<double>(p) / sincPhases;
+        double taps[sincTaps];
+        double sum = 0.0;
+
+        for (int t = 0; t < sincTaps; ++t)
+        {
+            const double x = static_cast<double>(t - (sincTaps / 2 - 1)) - frac;
+            const double px = juce::MathConstants<double>::pi * x;
+            const double sinc = std::abs(x) < 1.0e-9 ? 1.0 : std::sin(px) / px;
+            const double r = x / halfWidth;
+            const double window = std::abs(r) < 1.0 ? besselI0(beta * std::sqrt(1.0 - r * r)) / windowNorm : 0.0;
+
+            taps[t] = sinc * window;
+            sum += taps[t];
+        }
+
+        for (int t = 0; t < sincTaps; ++t)
+            sincTable[static_cast<size_t>(p * sincTaps + t)] = static_cast<float>(taps[t] / sum);
+    }
 }
 
 void PitchShifter::setOctaveOneActive(bool active)
@@ -472,7 +715,13 @@ void PitchShifter::setRiseTime(float riseMs)
 
 void PitchShifter::setChaosAmount(float normalizedChaos)
 {
-    chaos.setTargetValue(juce::jlimit(0.0f, 1.0f, normalizedChaos));
+    chaos = RampBlock::constant(juce::jlimit(0.0f, 1.0f, normalizedChaos));
+}
+
+void PitchShifter::setParameterRamps(const RampBlock& chaosRamp, const RampBlock& panicRamp) noexcept
+{
+    chaos = chaosRamp;
+    panic = panicRamp;
 }
 
 void PitchShifter::setPitchModulation(float mod)
@@ -499,7 +748,7 @@ void PitchShifter::setModulationBuffers(const float* pitchMod, const float* grai
 
 void PitchShifter::setPanic(float normalizedPanic)
 {
-    panic.setTargetValue(juce::jlimit(0.0f, 1.0f, normalizedPanic));
+    panic = RampBlock::constant(juce::jlimit(0.0f, 1.0f, normalizedPanic));
 }
 
 void PitchShifter::setRingModSpeed(float normalizedSpeed)
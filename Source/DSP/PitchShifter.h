@@ -1,6 +1,7 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include "ParameterRamp.h"
 #include <array>
 #include <atomic>
 #include <vector>
@@ -11,6 +12,14 @@ namespace DSP
 class PitchShifter
 {
 public:
+    // Fractional-delay read kernel. Hermite is the realtime default; Sinc is
+    // the 8-tap windowed-sinc used for offline renders (cleaner highs, ~3x CPU)
+    enum class Interpolation
+    {
+        Hermite,
+        Sinc
+    };
+
     PitchShifter() = default;
     ~PitchShifter() = default;
 
@@ -33,12 +42,28 @@ public:
     // Pointers must remain valid for the duration of the next process() call
     // and hold at least numSamples values. Pass nullptr to fall back to scalars.
     void setModulationBuffers(const float* pitchMod, const float* grainMod, const float* timingMod);
+    // Chaos/PANIC ramps for the next process() call, same lifetime rules
+    void setParameterRamps(const RampBlock& chaosRamp, const RampBlock& panicRamp) noexcept;
+    // Chaos Mix (dry/wet of the whole pitch section against the shifter's
+    // input) for the next process() call, same lifetime rules. Applied as
+    // the output is written, so the caller keeps no pre-pitch copy
+    void setChaosMixRamp(const RampBlock& chaosMixRamp) noexcept { chaosMix = chaosMixRamp; }
+
+    // Allocation-free, safe to switch between blocks
+    void setInterpolation(Interpolation newInterpolation) noexcept { interpolation = newInterpolation; }
+    Interpolation getInterpolation() const noexcept { return interpolation; }
+    // Seeds the grain-reset jitter so renders are repeatable
+    void setSeed(unsigned int seed) { random.setSeed(static_cast<juce::int64>(seed)); }
 
     bool isOctaveOneActive() const { return octaveOneActive.load(std::memory_order_relaxed); }
     bool isOctaveTwoActive() const { return octaveTwoActive.load(std::memory_order_relaxed); }
     float getCurrentPitchRatio() const { return currentPitchRatio; }
     float getCurrentMix() const { return currentMix; }
     bool isTransitioning() const { return transitionActive; }
+    // Idle: no octave requested and the wet path has fully decayed. process()
+    // then only feeds the delay line and leaves the buffer untouched, so the
+    // caller can skip modulation generation.
+    bool isIdle() const noexcept { return !isOctaveOneActive() && !isOctaveTwoActive() && mixSmoothState <= 0.0f; }
     // Dry path through the shifter is undelayed and wet delay sweeps window->0,
     // so this is a pitch-glide effect delay, not reportable PDC latency.
     int getLatencySamples() const { return 0; }
@@ -51,11 +76,27 @@ private:
         float ramp = 0.0f;       // Sawtooth ramp [0, 1) — sweep progress
     };
 
-    float readFromBuffer(int channel, float position) const;
     void resetHeadsForTransition();
+    void writeIdleBlock(const juce::AudioBuffer<float>& buffer, int numChannels, int numSamples);
+
+    // Block engine: head trajectories and gains are precomputed for the block
+    // (control pass), then the audio pass reads every head of every channel
+    // with one SIMD Hermite kernel per sample. Returns the number of leading
+    // samples that need the wet path; the rest only feed the delay line.
+    int computeHeadTrajectories(int startSample, int numSamples, float targetPitchRatio,
+                                float targetMix, bool anyOctaveActive);
+    void renderBlock(float* const* channelData, int channelsToRender, int startSample, int numSamples,
+                     int activeSamples);
+    void readHeads(int sample, int channelsToRead, float* wetPerChannel) const noexcept;
+    void readHeadsSinc(int sample, int channelsToRead, float* wetPerChannel) const noexcept;
+    void buildSincTable();
+
+    float* delayLine(int channel) noexcept { return delayBuffer.data() + static_cast<size_t>(channel * delayBufferSize); }
+    const float* delayLine(int channel) const noexcept { return delayBuffer.data() + static_cast<size_t>(channel * delayBufferSize); }
 
     double sampleRate = 44100.0;
     int maxBlockSize = 512;
+    int numChannels = 2;
 
     std::atomic<bool> octaveOneActive { false };
     std::atomic<bool> octaveTwoActive { false };
@@ -77,8 +118,9 @@ private:
 
     bool transitionActive = false;
 
-    juce::SmoothedValue<float> chaos { 0.0f };
-    juce::SmoothedValue<float> panic { 0.0f };
+    RampBlock chaos = RampBlock::constant(0.0f);
+    RampBlock panic = RampBlock::constant(0.0f);
+    RampBlock chaosMix = RampBlock::constant(1.0f);
 
     float pitchModulation = 0.0f;
     float grainSizeModulation = 0.0f;  // Reused: modulates window size
@@ -96,12 +138,13 @@ private:
     float ringModFreq = 0.0f;
     float ringModMix = 0.0f;
 
+    // Per-channel state, one array per field sized in prepare()
     // Feedback (per channel — shared scalar collapses stereo to mono)
-    std::array<float, 2> feedbackSamples {};
+    std::vector<float> feedbackSamples;
 
     // Gain compensation envelopes (per channel — shared state skews stereo)
-    std::array<float, 2> dryEnvelope {};
-    std::array<float, 2> wetEnvelope {};
+    std::vector<float> dryEnvelope;
+    std::vector<float> wetEnvelope;
     // Time constants match legacy 0.01/0.001 per-sample coeffs at 44.1kHz;
     // actual coefficients derived in prepare() so behavior is SR-invariant
     static constexpr float envelopeAttackMs = 2.27f;
@@ -110,18 +153,48 @@ private:
     float envelopeReleaseCoeff = 0.001f;
 
     // Dual-head delay line
-    static constexpr int maxChannels = 2;
     static constexpr int numMainHeads = 2;
     static constexpr int numDetuneHeads = 2;  // For PANIC
 
-    // Sized in prepare(): >= 4x max window at current sample rate, power of two
+    // Hermite lanes: every head of laneChannels channels per pass (8 lanes =
+    // two SSE/NEON or one AVX register), repeated for each channel pair
+    static constexpr int numHeads = numMainHeads + numDetuneHeads;
+    static constexpr int laneChannels = 2;
+    static constexpr int numLanes = numHeads * laneChannels;
+
+    // Sized in prepare(): >= 4x max window at current sample rate, power of
+    // two. One allocation, channel lines back to back (see delayLine())
     int delayBufferSize = 8192;
-    std::array<std::vector<float>, maxChannels> delayBuffer;
+    int delayBufferMask = 8191;
+    std::vector<float> delayBuffer;
     int writePosition = 0;
 
+    // Audio-thread scratch, one entry per channel
+    std::vector<float*> channelPointers;
+    std::vector<float> wetScratch;
+
+    // Windowed-sinc kernel: sincTaps taps centred on the read position
+    // (offsets -3..+4), one row per fractional phase plus a guard row so
+    // rows p and p+1 can be blended without wrapping
+    static constexpr int sincTaps = 8;
+    static constexpr int sincPhases = 256;
+    std::vector<float> sincTable;
+    Interpolation interpolation = Interpolation::Hermite;
+
     std::array<DelayHead, numMainHeads> mainHeads;
     std::array<DelayHead, numDetuneHeads> detuneHeads;
 
+    // Per-block control data (sized to maxBlockSize in prepare). Heads are
+    // ordered main0, main1, detune0, detune1; detune gains include PANIC.
+    std::array<std::vector<float>, numHeads> headPositions;
+    std::array<std::vector<float>, numHeads> headGains;
+    std::vector<float> mainHeadNorms;
+    std::vector<float> feedbackAmounts;
+    std::vector<float> wetMixes;
+    std::vector<float> ringModGains;
+    bool detuneHeadsActive = false;
+    bool clearFeedbackAfterActive = false;
+
     // Window/crossfade parameters
     int windowSizeSamples = 1024;
     static constexpr float minWindowMs = 10.0f;
@@ -0,0 +1,206 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include <atomic>
+#include <limits>
+
+// Per-stage timing inside processBlock. Off by default: with the flag at 0 the
+// BLACKHEART_PROFILE_STAGE macro expands to nothing, so plugin builds carry
+// no timer reads. Benchmarks enable it with -DBLACKHEART_PROFILE_STAGES=1.
+#ifndef BLACKHEART_PROFILE_STAGES
+ #define BLACKHEART_PROFILE_STAGES 0
+#endif
+
+namespace DSP
+{
+
+/**
+ * Lock-free per-stage timing accumulator.
+ *
+ * The audio thread is the only writer (record / ScopedStage); any other
+ * thread may call getStats() or requestReset() at any time. Fields are
+ * individually atomic, so a snapshot taken mid-update can mix two calls'
+ * worth of data but never tears a value.
+ */
+class StageProfiler
+{
+public:
+    enum Stage
+    {
+        inputConditioner = 0,
+        oversampleUp,
+        fuzzEngine,
+        octaveGenerator,
+        oversampleDown,
+        interstageProtection,
+        dynamicGate,
+        blendMixer,
+        chaosModulator,
+        pitchShifter,
+        outputLimiter,
+        numStages
+    };
+
+    // Log2 buckets of call duration: bucket 0 is < 128ns, bucket k covers
+    // [2^(k+6), 2^(k+7)) ns, the last bucket collects everything >= ~2ms
+    static constexpr int numHistogramBuckets = 16;
+    static constexpr int histogramFirstBit = 7;
+
+    struct StageStats
+    {
+        juce::uint64 calls = 0;
+        double minNs = 0.0;
+        double meanNs = 0.0;
+        double maxNs = 0.0;
+        double nsPerSample = 0.0;
+        std::array<juce::uint64, numHistogramBuckets> histogram {};
+    };
+
+    StageProfiler() = default;
+
+    static constexpr bool isEnabled() noexcept { return BLACKHEART_PROFILE_STAGES != 0; }
+
+    static const char* getStageName(int stage) noexcept
+    {
+        static constexpr const char* names[numStages] = {
+            "InputConditioner", "OversampleUp", "FuzzEngine", "OctaveGenerator", "OversampleDown",
+            "InterstageProtection",
+            "DynamicGate", "BlendMixer", "ChaosModulator", "PitchShifter", "OutputLimiter"
+        };
+        return stage >= 0 && stage < numStages ? names[stage] : "";
+    }
+
+    static float getHistogramBucketStartNs(int bucket) noexcept
+    {
+        return bucket <= 0 ? 0.0f : static_cast<float>(1 << (bucket + histogramFirstBit - 1));
+    }
+
+    // Audio thread only
+    void record(Stage stage, juce::int64 ticks, int numSamples) noexcept
+    {
+        if (resetPending.exchange(false, std::memory_order_acquire))
+            clear();
+
+        auto& s = stages[static_cast<size_t>(stage)];
+        const auto ns = static_cast<juce::uint64>(juce::jmax(juce::int64 { 0 }, ticks))
+                        * nanosPerSecond / ticksPerSecond;
+
+        s.calls.store(s.calls.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        s.totalNs.store(s.totalNs.load(std::memory_order_relaxed) + ns, std::memory_order_relaxed);
+        s.totalSamples.store(s.totalSamples.load(std::memory_order_relaxed) + static_cast<juce::uint64>(numSamples),
+                             std::memory_order_relaxed);
+
+        if (ns < s.minNs.load(std::memory_order_relaxed))
+            s.minNs.store(ns, std::memory_order_relaxed);
+        if (ns > s.maxNs.load(std::memory_order_relaxed))
+            s.maxNs.store(ns, std::memory_order_relaxed);
+
+        auto& bucket = s.histogram[static_cast<size_t>(getBucket(ns))];
+        bucket.store(bucket.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    // Any thread
+    StageStats getStats(Stage stage) const noexcept
+    {
+        const auto& s = stages[static_cast<size_t>(stage)];
+        StageStats out;
+
+        out.calls = s.calls.load(std::memory_order_relaxed);
+        if (out.calls == 0)
+            return out;
+
+        const auto totalNs = static_cast<double>(s.totalNs.load(std::memory_order_relaxed));
+        const auto totalSamples = s.totalSamples.load(std::memory_order_relaxed);
+
+        out.minNs = static_cast<double>(s.minNs.load(std::memory_order_relaxed));
+        out.maxNs = static_cast<double>(s.maxNs.load(std::memory_order_relaxed));
+        out.meanNs = totalNs / static_cast<double>(out.calls);
+        out.nsPerSample = totalSamples > 0 ? totalNs / static_cast<double>(totalSamples) : 0.0;
+
+        for (size_t b = 0; b < out.histogram.size(); ++b)
+            out.histogram[b] = s.histogram[b].load(std::memory_order_relaxed);
+
+        return out;
+    }
+
+    // Any thread: the audio thread clears on its next record()
+    void requestReset() noexcept { resetPending.store(true, std::memory_order_release); }
+
+    // Only while the audio thread is stopped (prepareToPlay)
+    void reset() noexcept
+    {
+        resetPending.store(false, std::memory_order_relaxed);
+        clear();
+    }
+
+    class ScopedStage
+    {
+    public:
+        ScopedStage(StageProfiler& p, Stage s, int n) noexcept
+            : profiler(p), stage(s), numSamples(n), start(juce::Time::getHighResolutionTicks()) {}
+
+        ~ScopedStage() noexcept
+        {
+            profiler.record(stage, juce::Time::getHighResolutionTicks() - start, numSamples);
+        }
+
+    private:
+        StageProfiler& profiler;
+        const Stage stage;
+        const int numSamples;
+        const juce::int64 start;
+
+        JUCE_DECLARE_NON_COPYABLE(ScopedStage)
+    };
+
+private:
+    struct Accumulator
+    {
+        std::atomic<juce::uint64> calls { 0 };
+        std::atomic<juce::uint64> totalNs { 0 };
+        std::atomic<juce::uint64> totalSamples { 0 };
+        std::atomic<juce::uint64> minNs { std::numeric_limits<juce::uint64>::max() };
+        std::atomic<juce::uint64> maxNs { 0 };
+        std::array<std::atomic<juce::uint64>, numHistogramBuckets> histogram {};
+    };
+
+    static int getBucket(juce::uint64 ns) noexcept
+    {
+        int bit = 0;
+        while (ns >> (bit + 1) != 0 && bit < 63)
+            ++bit;
+        return ns == 0 ? 0 : juce::jlimit(0, numHistogramBuckets - 1, bit - histogramFirstBit + 1);
+    }
+
+    void clear() noexcept
+    {
+        for (auto& s : stages)
+        {
+            s.calls.store(0, std::memory_order_relaxed);
+            s.totalNs.store(0, std::memory_order_relaxed);
+            s.totalSamples.store(0, std::memory_order_relaxed);
+            s.minNs.store(std::numeric_limits<juce::uint64>::max(), std::memory_order_relaxed);
+            s.maxNs.store(0, std::memory_order_relaxed);
+            for (auto& b : s.histogram)
+                b.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    static constexpr juce::uint64 nanosPerSecond = 1000000000;
+    const juce::uint64 ticksPerSecond = static_cast<juce::uint64>(juce::Time::getHighResolutionTicksPerSecond());
+
+    std::array<Accumulator, numStages> stages;
+    std::atomic<bool> resetPending { false };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(StageProfiler)
+};
+
+} // namespace DSP
+
+#if BLACKHEART_PROFILE_STAGES
+ #define BLACKHEART_PROFILE_STAGE(profiler, stage, numSamples) \
+     const DSP::StageProfiler::ScopedStage profileScope_##stage ((profiler), DSP::StageProfiler::stage, (numSamples))
+#else
+ #define BLACKHEART_PROFILE_STAGE(profiler, stage, numSamples)
+#endif
@@ -0,0 +1,104 @@
+#include "TruePeakDetector.h"
+#include <cmath>
+
+namespace DSP
+{
+
+TruePeakDetector::TruePeakDetector()
+{
+    // Kaiser-windowed sinc (beta 6, as the pitch shifter's read kernel), each
+    // phase normalised to unity DC gain. Window tap t is input sample
+    // m - (latency - 1) + t, so phase k lands at m + k / oversampling
+    constexpr double beta = 6.0;
+    constexpr double halfWidth = tapsPerPhase / 2;
+
+    const auto besselI0 = [](double x)
+    {
+        double sum = 1.0, term = 1.0;
+        for (int k = 1; k < 32; ++k)
+        {
+            term *= (x / (2.0 * k)) * (x / (2.0 * k));
+            sum += term;
+        }
+        return sum;
+    };
+
+    const double windowNorm = besselI0(beta);
+
+    for (int phase = 1; phase < oversampling; ++phase)
+    {
+        const double frac = static_cast<double>(phase) / oversampling;
+        double taps[tapsPerPhase];
+        double sum = 0.0;
+
+        for (int t = 0; t < tapsPerPhase; ++t)
+        {
+            const double x = static_cast<double>(t - (latency - 1)) - frac;
+            const double px = juce::MathConstants<double>::pi * x;
+            const double sinc = std::sin(px) / px;
+            const double r = x / halfWidth;
+            const double window = std::abs(r) < 1.0 ? besselI0(beta * std::sqrt(1.0 - r * r)) / windowNorm : 0.0;
+
+            taps[t] = sinc * window;
+            sum += taps[t];
+        }
+
+        for (int t = 0; t < tapsPerPhase; ++t)
+            kernels[static_cast<size_t>(phase - 1)][static_cast<size_t>(t)] = static_cast<float>(taps[t] / sum);
+    }
+}
+
+void TruePeakDetector::prepare(int channels)
+{
+    jassert(channels >= 0);
+    numChannels = juce::jmax(0, channels);
+    history.assign(static_cast<size_t>(numChannels * 2 * tapsPerPhase), 0.0f);
+    historyPosition = 0;
+}
+
+void TruePeakDetector::reset() noexcept
+{
+    std::fill(history.begin(), history.end(), 0.0f);
+    historyPosition = 0;
+}
+
+void TruePeakDetector::process(const float* const* channels, int channelsToRead, int startSample, int numSamples,
+                               float* levels) noexcept
+{
+    juce::FloatVectorOperations::clear(levels, numSamples);
+
+    jassert(channelsToRead <= numChannels);
+    channelsToRead = std::min(channelsToRead, numChannels);
+
+    for (int ch = 0; ch < channelsToRead; ++ch)
+    {
+        const float* input = channels[ch] + startSample;
+        float* line = history.data() + ch * 2 * tapsPerPhase;
+        int position = historyPosition;
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            line[position] = input[i];
+            line[position + tapsPerPhase] = input[i];
+            position = position + 1 == tapsPerPhase ? 0 : position + 1;
+
+            // Oldest to newest: the window ends on the sample just written
+            const float* window = line + position;
+            float peak = std::abs(window[latency - 1]);
+
+            for (const auto& kernel : kernels)
+            {
+                float acc = 0.0f;
+                for (int t = 0; t < tapsPerPhase; ++t)
+                    acc += kernel[static_cast<size_t>(t)] * window[t];
+                peak = std::max(peak, std::abs(acc));
+            }
+
+            levels[i] = std::max(levels[i], peak);
+        }
+    }
+
+    historyPosition = (historyPosition + numSamples) % tapsPerPhase;
+}
+
+} // namespace DSP
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+// MIDI control of the performance targets: held notes gate the octave
+// momentaries, controllers set PANIC and the fuzz mode. Events are applied
+// at their sample position inside the block.
+namespace MidiMapping
+{
+
+struct Assignments
+{
+    int channel = 0;            // 1-16, 0 = omni
+    int octaveOneNote = 60;     // C4: +1 OCT while held
+    int octaveTwoNote = 62;     // D4: +2 OCT while held
+    int panicController = 1;    // Mod wheel: PANIC 0..1
+    int modeController = 3;     // Thirds of the range: Scream / OD / Doom
+
+    bool operator== (const Assignments& other) const noexcept
+    {
+        return channel == other.channel && octaveOneNote == other.octaveOneNote
+            && octaveTwoNote == other.octaveTwoNote && panicController == other.panicController
+            && modeController == other.modeController;
+    }
+    bool operator!= (const Assignments& other) const noexcept { return ! (*this == other); }
+};
+
+enum class Target
+{
+    none,
+    octaveOne,
+    octaveTwo,
+    panic,
+    mode
+};
+
+struct Event
+{
+    Target target = Target::none;
+    float value = 0.0f;         // Gate 0/1, PANIC 0..1 or mode index 0..2
+};
+
+inline Event map(const juce::MidiMessage& message, const Assignments& assignments) noexcept
+{
+    if (assignments.channel != 0 && message.getChannel() != assignments.channel)
+        return {};
+
+    if (message.isNoteOn() || message.isNoteOff())
+    {
+        const float gate = message.isNoteOn() ? 1.0f : 0.0f;
+        if (message.getNoteNumber() == assignments.octaveOneNote)
+            return { Target::octaveOne, gate };
+        if (message.getNoteNumber() == assignments.octaveTwoNote)
+            return { Target::octaveTwo, gate };
+        return {};
+    }
+
+    if (message.isController())
+    {
+        const int value = message.getControllerValue();
+        if (message.getControllerNumber() == assignments.panicController)
+            return { Target::panic, static_cast<float>(value) / 127.0f };
+        if (message.getControllerNumber() == assignments.modeController)
+            return { Target::mode, static_cast<float>(juce::jmin(2, value * 3 / 128)) };
+    }
+
+    return {};
+}
+
+} // namespace MidiMapping
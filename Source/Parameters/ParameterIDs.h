@@ -18,6 +18,9 @@ inline constexpr auto mode     { "mode" };
 inline constexpr auto shape    { "shape" };
 inline constexpr auto panic    { "panic" };
 inline constexpr auto chaosMix { "chaosMix" };
+inline constexpr auto quality  { "quality" };
+inline constexpr auto limiterLookahead { "limiterLookahead" };
+inline constexpr auto octaveEngine { "octaveEngine" };
 
 namespace Defaults
 {
@@ -34,6 +37,9 @@ namespace Defaults
     inline constexpr float shape   = 0.5f;
     inline constexpr float panic   = 0.0f;
     inline constexpr float chaosMix = 0.7f;
+    inline constexpr float quality = 1.0f;   // 0=Low CPU, 1=Live, 2=Efficient
+    inline constexpr float limiterLookahead = 0.0f;   // ms, 0=Off
+    inline constexpr float octaveEngine = 0.0f;   // 0=Rectifier, 1=Analytic
 }
 
 namespace Ranges
@@ -92,6 +98,21 @@ namespace Ranges
     inline constexpr float chaosMixMax  = 1.0f;
     inline constexpr float chaosMixStep = 0.01f;
     inline constexpr float chaosMixSkew = 1.0f;
+
+    inline constexpr float qualityMin  = 0.0f;
+    inline constexpr float qualityMax  = 2.0f;
+    inline constexpr float qualityStep = 1.0f;
+    inline constexpr float qualitySkew = 1.0f;
+
+    inline constexpr float limiterLookaheadMin  = 0.0f;
+    inline constexpr float limiterLookaheadMax  = 5.0f;
+    inline constexpr float limiterLookaheadStep = 0.1f;
+    inline constexpr float limiterLookaheadSkew = 1.0f;
+
+    inline constexpr float octaveEngineMin  = 0.0f;
+    inline constexpr float octaveEngineMax  = 1.0f;
+    inline constexpr float octaveEngineStep = 1.0f;
+    inline constexpr float octaveEngineSkew = 1.0f;
 }
 
 namespace Smoothing
@@ -108,6 +129,8 @@ namespace Smoothing
     inline constexpr double panicRampSec  = 0.02;
     inline constexpr double chaosMixRampSec = 0.03;
     // MODE has no smoothing — discrete switch, instant change
+    // QUALITY, LOOK-AHEAD and OCTAVE ENGINE are applied by re-preparing the
+    // chain, never ramped
 }
 
 namespace Labels
@@ -125,6 +148,9 @@ namespace Labels
     inline const juce::String shape   { "Shape" };
     inline const juce::String panic   { "Panic" };
     inline const juce::String chaosMix { "Chaos Mix" };
+    inline const juce::String quality { "Quality" };
+    inline const juce::String limiterLookahead { "Look-Ahead" };
+    inline const juce::String octaveEngine { "Octave Engine" };
 }
 
 namespace Units
@@ -195,4 +221,21 @@ inline juce::NormalisableRange<float> chaosMixRange()
     return makeRange(Ranges::chaosMixMin, Ranges::chaosMixMax, Ranges::chaosMixStep, Ranges::chaosMixSkew);
 }
 
+inline juce::NormalisableRange<float> qualityRange()
+{
+    return makeRange(Ranges::qualityMin, Ranges::qualityMax, Ranges::qualityStep, Ranges::qualitySkew);
+}
+
+inline juce::NormalisableRange<float> limiterLookaheadRange()
+{
+    return makeRange(Ranges::limiterLookaheadMin, Ranges::limiterLookaheadMax,
+                     Ranges::limiterLookaheadStep, Ranges::limiterLookaheadSkew);
+}
+
+inline juce::NormalisableRange<float> octaveEngineRange()
+{
+    return makeRange(Ranges::octaveEngineMin, Ranges::octaveEngineMax,
+                     Ranges::octaveEngineStep, Ranges::octaveEngineSkew);
+}
+
 } // namespace ParameterIDs
@@ -45,7 +45,7 @@ BlackheartAudioProcessorEditor::BlackheartAudioProcessorEditor(BlackheartAudioPr
 
     oscilloscope.setProcessor(&audioProcessor);
 
-    startTimerHz(30);
+    startTimerHz(visibleRefreshHz);
 
     // Resizable, aspect-locked to default 760x580.
     setResizable(true, true);
@@ -159,21 +159,37 @@ void BlackheartAudioProcessorEditor::updateVisualizers()
     if (oct1 && oct2) momentary = juce::String::fromUTF8("+1+2OCT\xC2\xB7HOLD");
     oscilloscope.setOsdMomentary(momentary);
 
-    // Waveform samples from processor FIFO (lock-free).
-    auto& fifo = audioProcessor.getWaveformFifo();
-    float sample;
-    std::array<float, 64> samples;
-    int sampleCount = 0;
+    // Output probe from the analysis bus (lock-free), one point per frame:
+    // whichever extreme is larger, so peaks survive the decimation.
+    auto& bus = audioProcessor.getAnalysisBus();
+    bus.discardAllBut(maxScopeFramesPerTick);
+    const int numFrames = bus.read(analysisFrames.data(), maxScopeFramesPerTick);
 
-    while (fifo.pull(sample) && sampleCount < 64)
-        samples[static_cast<size_t>(sampleCount++)] = sample;
+    for (int i = 0; i < numFrames; ++i)
+    {
+        const auto& frame = analysisFrames[static_cast<size_t>(i)];
+        const float low = frame.minimum[DSP::AnalysisBus::output];
+        const float high = frame.maximum[DSP::AnalysisBus::output];
+        scopeSamples[static_cast<size_t>(i)] = std::abs(high) >= std::abs(low) ? high : low;
+    }
 
-    if (sampleCount > 0)
-        oscilloscope.pushSamples(samples.data(), sampleCount);
+    if (numFrames > 0)
+        oscilloscope.pushSamples(scopeSamples.data(), numFrames);
 }
 
 void BlackheartAudioProcessorEditor::timerCallback()
 {
+    // Hidden or minimised windows idle at a slow tick and draw nothing
+    const bool showing = isShowing();
+    if (showing != refreshingVisible)
+    {
+        refreshingVisible = showing;
+        startTimerHz(showing ? visibleRefreshHz : hiddenRefreshHz);
+    }
+
+    if (! showing)
+        return;
+
     updateVisualizers();
 
     const double sr = audioProcessor.getSampleRate();
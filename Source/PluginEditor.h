@@ -53,6 +53,16 @@ private:
     // CRT scope (owns IN/OUT meters + OSD)
     Scope oscilloscope;
 
+    // The one GUI timer: drives meters, OSD and the scope
+    static constexpr int visibleRefreshHz = 30;
+    static constexpr int hiddenRefreshHz = 4;
+    bool refreshingVisible = true;
+
+    // Analysis frames drained per timer tick; older backlog is discarded
+    static constexpr int maxScopeFramesPerTick = 512;
+    std::array<DSP::AnalysisBus::Frame, maxScopeFramesPerTick> analysisFrames;
+    std::array<float, maxScopeFramesPerTick> scopeSamples {};
+
     HeaderStrip headerStrip;
     StatusStrip statusStrip;
 
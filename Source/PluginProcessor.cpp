@@ -1,5 +1,8 @@
 #include "PluginProcessor.h"
-#include "PluginEditor.h"
+
+#if ! BLACKHEART_HEADLESS
+ #include "PluginEditor.h"
+#endif
 
 BlackheartAudioProcessor::BlackheartAudioProcessor()
 #ifndef JucePlugin_PreferredChannelConfigurations
@@ -29,10 +32,21 @@ BlackheartAudioProcessor::BlackheartAudioProcessor()
     shapeParam = apvts.getRawParameterValue(ParameterIDs::shape);
     panicParam = apvts.getRawParameterValue(ParameterIDs::panic);
     chaosMixParam = apvts.getRawParameterValue(ParameterIDs::chaosMix);
+    qualityParam = apvts.getRawParameterValue(ParameterIDs::quality);
+    limiterLookaheadParam = apvts.getRawParameterValue(ParameterIDs::limiterLookahead);
+    octaveEngineParam = apvts.getRawParameterValue(ParameterIDs::octaveEngine);
+
+    apvts.addParameterListener(ParameterIDs::quality, this);
+    apvts.addParameterListener(ParameterIDs::limiterLookahead, this);
+    apvts.addParameterListener(ParameterIDs::octaveEngine, this);
 }
 
 BlackheartAudioProcessor::~BlackheartAudioProcessor()
 {
+    apvts.removeParameterListener(ParameterIDs::quality, this);
+    apvts.removeParameterListener(ParameterIDs::limiterLookahead, this);
+    apvts.removeParameterListener(ParameterIDs::octaveEngine, this);
+    cancelPendingUpdate();
 }
 
 juce::AudioProcessorValueTreeState::ParameterLayout BlackheartAudioProcessor::createParameterLayout()
@@ -204,6 +218,62 @@ juce::AudioProcessorValueTreeState::ParameterLayout BlackheartAudioProcessor::cr
             .withStringFromValueFunction(percentFormat)
             .withValueFromStringFunction(percentParse)));
 
+    // QUALITY: realtime tier (0=Low CPU, 1=Live, 2=Efficient). Offline
+    // renders switch to the Render tier on their own. Changing it re-prepares
+    // the chain and its latency, so hosts must not automate it
+    layout.add(std::make_unique<juce::AudioParameterFloat>(
+        juce::ParameterID { ParameterIDs::quality, 1 },
+        ParameterIDs::Labels::quality,
+        ParameterIDs::qualityRange(),
+        ParameterIDs::Defaults::quality,
+        juce::AudioParameterFloatAttributes()
+            .withAutomatable(false)
+            .withStringFromValueFunction([](float value, int) {
+                int v = static_cast<int>(value + 0.5f);
+                if (v == 0) return juce::String("Low CPU");
+                if (v == 2) return juce::String("Efficient");
+                return juce::String("Live");
+            })
+            .withValueFromStringFunction([](const juce::String& text) {
+                if (text.containsIgnoreCase("low")) return 0.0f;
+                if (text.containsIgnoreCase("eff")) return 2.0f;
+                return 1.0f;
+            })));
+
+    // LOOK-AHEAD: true-peak limiter look-ahead, 0 = off (instant-attack
+    // limiter). Adds latency, so it re-prepares like QUALITY
+    layout.add(std::make_unique<juce::AudioParameterFloat>(
+        juce::ParameterID { ParameterIDs::limiterLookahead, 1 },
+        ParameterIDs::Labels::limiterLookahead,
+        ParameterIDs::limiterLookaheadRange(),
+        ParameterIDs::Defaults::limiterLookahead,
+        juce::AudioParameterFloatAttributes()
+            .withAutomatable(false)
+            .withStringFromValueFunction([msFormat](float value, int maximumLength) {
+                const float ms = DSP::OutputLimiter::clampLookahead(value);
+                return ms > 0.0f ? msFormat(ms, maximumLength) : juce::String("Off");
+            })
+            .withValueFromStringFunction([msParse](const juce::String& text) {
+                return text.containsIgnoreCase("off") ? 0.0f : msParse(text);
+            })));
+
+    // OCTAVE ENGINE: 0=Rectifier (oversampled, original voicing),
+    // 1=Analytic (native rate). Moves the stage across the oversampling
+    // boundary, so it re-prepares like QUALITY
+    layout.add(std::make_unique<juce::AudioParameterFloat>(
+        juce::ParameterID { ParameterIDs::octaveEngine, 1 },
+        ParameterIDs::Labels::octaveEngine,
+        ParameterIDs::octaveEngineRange(),
+        ParameterIDs::Defaults::octaveEngine,
+        juce::AudioParameterFloatAttributes()
+            .withAutomatable(false)
+            .withStringFromValueFunction([](float value, int) {
+                return value > 0.5f ? juce::String("Analytic") : juce::String("Rectifier");
+            })
+            .withValueFromStringFunction([](const juce::String& text) {
+                return text.containsIgnoreCase("analytic") ? 1.0f : 0.0f;
+            })));
+
     return layout;
 }
 
@@ -278,6 +348,10 @@ void BlackheartAudioProcessor::prepareToPlay(double sampleRate, int samplesPerBl
     isFirstBlock = true;
     stabilityError = false;
     consecutiveHighLevelBlocks = 0;
+    stageProfiler.reset();
+    midiAssignments = pendingMidiAssignments;
+    midiControl = MidiControlState();
+    analysisBus.prepare(sampleRate, samplesPerBlock);
 
     juce::dsp::ProcessSpec spec;
     spec.sampleRate = sampleRate;
@@ -285,8 +359,8 @@ void BlackheartAudioProcessor::prepareToPlay(double sampleRate, int samplesPerBl
     spec.numChannels = static_cast<juce::uint32>(
         std::max(getTotalNumInputChannels(), getTotalNumOutputChannels()));
 
-    // Initialize parameter smoothing
-    smoothedParams.prepare(sampleRate);
+    // Block-rate parameter ramps (arrays sized for the largest block)
+    parameterRamps.prepare(sampleRate, samplesPerBlock);
 
     //==========================================================================
     // SIGNAL CHAIN PREPARATION (in processing order)
@@ -297,11 +371,26 @@ void BlackheartAudioProcessor::prepareToPlay(double sampleRate, int samplesPerBl
     inputConditioner.setDCBlockEnabled(true);
     inputConditioner.setAntiAliasingEnabled(true);
 
+    // Stages 2-3 share one oversampled domain: a single up/down pair around
+    // both nonlinear stages instead of one per stage. Factor follows the
+    // quality tier — hosts flag offline renders before preparing for them
+    preparedQuality = isNonRealtime() ? QualityTier::Render : getLiveQuality();
+    const auto oversamplingConfig = getRequestedOversamplingConfig(preparedQuality);
+
+    // Antiderivative shaping only runs at 1x, where its one-sample delay is
+    // a whole native sample the dry path and host PDC can match
+    fuzzEngine.setAntiderivativeShaping(preparedQuality == QualityTier::Efficient && oversamplingConfig.factor == 1);
+    jassert(fuzzEngine.getLatencySamples() % oversamplingConfig.factor == 0);
+    oversampler.prepare(spec, oversamplingConfig, fuzzEngine.getLatencySamples() / oversamplingConfig.factor);
+    const auto oversampledSpec = oversampler.getOversampledSpec();
+
     // Stage 2: Fuzz Engine
-    fuzzEngine.prepare(spec);
+    fuzzEngine.prepare(oversampledSpec);
 
-    // Stage 3: Octave Generator
-    octaveGenerator.prepare(spec);
+    // Stage 3: Octave Generator — the Analytic engine runs after the domain
+    octaveGenerator.setEngine(getOctaveEngine());
+    octaveGenerator.prepare(octaveGenerator.getEngine() == DSP::OctaveGenerator::Engine::Analytic
+                                ? spec : oversampledSpec);
 
     // Stage 4: Dynamic Gate
     dynamicGate.prepare(spec);
@@ -323,7 +412,16 @@ void BlackheartAudioProcessor::prepareToPlay(double sampleRate, int samplesPerBl
     chaosModulator.setEnvelopeAttack(3.0f);
     chaosModulator.setEnvelopeRelease(100.0f);
 
+    if (pinnedRandomSeed.has_value())
+    {
+        chaosModulator.setSeed(*pinnedRandomSeed);
+        pitchShifter.setSeed(*pinnedRandomSeed);
+    }
+
+    applyBlockQuality(isNonRealtime());
+
     // Stage 8: Output Limiter
+    outputLimiter.setLookahead(limiterLookaheadParam->load());
     outputLimiter.prepare(spec);
     outputLimiter.setCeiling(-0.3f);
     outputLimiter.setHeadroom(-1.0f);
@@ -348,8 +446,6 @@ void BlackheartAudioProcessor::prepareToPlay(double sampleRate, int samplesPerBl
 
     const int numChannels = static_cast<int>(spec.numChannels);
     dryBuffer.setSize(numChannels, samplesPerBlock);
-    stagingBuffer.setSize(numChannels, samplesPerBlock);
-    prePitchDryBuffer.setSize(numChannels, samplesPerBlock);
 
     pitchModBuffer.assign(static_cast<size_t>(samplesPerBlock), 0.0f);
     grainModBuffer.assign(static_cast<size_t>(samplesPerBlock), 0.0f);
@@ -360,19 +456,150 @@ void BlackheartAudioProcessor::prepareToPlay(double sampleRate, int samplesPerBl
     // LATENCY CALCULATION
     //==========================================================================
 
+    // Oversampled-domain latency (round trip plus the fuzz's own) is integer
+    // by construction and the dry path is delayed to match, so it adds
+    // straight onto the wet chain. The limiter
+    // look-ahead delays the summed output, dry and wet alike
+    oversamplingLatency = juce::roundToInt(oversampler.getLatencySamples());
     pitchShifterLatency = pitchShifter.getLatencySamples();
-    totalLatencySamples = pitchShifterLatency;
+    limiterLatency = outputLimiter.getLatencySamples();
+    totalLatencySamples = oversamplingLatency + pitchShifterLatency + limiterLatency;
     setLatencySamples(totalLatencySamples);
 
     // Reset meters
     signalMeters.reset();
     inputEnvelope = 0.0f;
     chaosEnvelope = 0.0f;
+
+    isPrepared = true;
+}
+
+DSP::Oversampler::Config BlackheartAudioProcessor::getOversamplingConfigFor(QualityTier tier)
+{
+    switch (tier)
+    {
+        case QualityTier::Efficient:
+        case QualityTier::LowCpu: return { 1, DSP::Oversampler::FilterType::MinimumPhaseIIR };
+        case QualityTier::Render: return { 8, DSP::Oversampler::FilterType::LinearPhaseFIR };
+        case QualityTier::Live:
+        default:                  return { 2, DSP::Oversampler::FilterType::MinimumPhaseIIR };
+    }
+}
+
+DSP::Oversampler::Config BlackheartAudioProcessor::getRequestedOversamplingConfig(QualityTier tier) const
+{
+    if (tier != QualityTier::Render && oversamplingOverride.has_value())
+        return *oversamplingOverride;
+
+    return getOversamplingConfigFor(tier);
+}
+
+void BlackheartAudioProcessor::setLiveQuality(QualityTier tier)
+{
+    // Render is reserved for offline renders
+    const float value = tier == QualityTier::LowCpu ? 0.0f : tier == QualityTier::Efficient ? 2.0f : 1.0f;
+
+    if (auto* param = apvts.getParameter(ParameterIDs::quality))
+        param->setValueNotifyingHost(param->convertTo0to1(value));
+}
+
+BlackheartAudioProcessor::QualityTier BlackheartAudioProcessor::getLiveQuality() const
+{
+    switch (static_cast<int>(qualityParam->load() + 0.5f))
+    {
+        case 0:  return QualityTier::LowCpu;
+        case 2:  return QualityTier::Efficient;
+        default: return QualityTier::Live;
+    }
+}
+
+void BlackheartAudioProcessor::setOversamplingConfig(const DSP::Oversampler::Config& config)
+{
+    oversamplingOverride = DSP::Oversampler::sanitise(config);
+    if (isPrepared)
+        triggerAsyncUpdate();
+}
+
+void BlackheartAudioProcessor::resetOversamplingConfig()
+{
+    oversamplingOverride.reset();
+    if (isPrepared)
+        triggerAsyncUpdate();
+}
+
+void BlackheartAudioProcessor::setLimiterLookahead(float milliseconds)
+{
+    if (auto* param = apvts.getParameter(ParameterIDs::limiterLookahead))
+        param->setValueNotifyingHost(param->convertTo0to1(juce::jmax(0.0f, milliseconds)));
+}
+
+void BlackheartAudioProcessor::setOctaveEngine(DSP::OctaveGenerator::Engine engine)
+{
+    if (auto* param = apvts.getParameter(ParameterIDs::octaveEngine))
+        param->setValueNotifyingHost(engine == DSP::OctaveGenerator::Engine::Analytic ? 1.0f : 0.0f);
+}
+
+DSP::OctaveGenerator::Engine BlackheartAudioProcessor::getOctaveEngine() const
+{
+    return octaveEngineParam->load() > 0.5f ? DSP::OctaveGenerator::Engine::Analytic
+                                            : DSP::OctaveGenerator::Engine::Rectifier;
+}
+
+void BlackheartAudioProcessor::parameterChanged(const juce::String& parameterID, float newValue)
+{
+    juce::ignoreUnused(parameterID, newValue);
+
+    // Any thread: the re-prepare itself waits for the message thread
+    if (isPrepared)
+        triggerAsyncUpdate();
+}
+
+void BlackheartAudioProcessor::setMidiAssignments(const MidiMapping::Assignments& newAssignments)
+{
+    pendingMidiAssignments = newAssignments;
+
+    // Restored sessions included: the mapping is live without waiting for
+    // the host's next prepareToPlay
+    if (isPrepared)
+        triggerAsyncUpdate();
+}
+
+bool BlackheartAudioProcessor::needsReconfiguration() const
+{
+    const auto tier = isNonRealtime() ? QualityTier::Render : getLiveQuality();
+    return tier != preparedQuality || getRequestedOversamplingConfig(tier) != oversampler.getConfig()
+           || getLimiterLookahead() != outputLimiter.getLookaheadMs()
+           || getOctaveEngine() != getPreparedOctaveEngine()
+           || pendingMidiAssignments != midiAssignments;
+}
+
+void BlackheartAudioProcessor::handleAsyncUpdate()
+{
+    if (! isPrepared || ! needsReconfiguration())
+        return;
+
+    // Suspending waits out the current block and keeps the host from
+    // calling processBlock mid-prepare; prepareToPlay reports the new latency
+    suspendProcessing(true);
+    prepareToPlay(currentSampleRate, currentBlockSize);
+    suspendProcessing(false);
+}
+
+void BlackheartAudioProcessor::applyBlockQuality(bool renderingOffline)
+{
+    fuzzEngine.setExactWaveshaping(renderingOffline);
+    pitchShifter.setInterpolation(renderingOffline ? DSP::PitchShifter::Interpolation::Sinc
+                                                   : DSP::PitchShifter::Interpolation::Hermite);
+    // Offline renders step the chaos generators every sample
+    chaosModulator.setControlInterval(renderingOffline ? 1 : DSP::ChaosModulator::defaultControlInterval);
 }
 
 void BlackheartAudioProcessor::releaseResources()
 {
+    isPrepared = false;
+
     inputConditioner.reset();
+    oversampler.reset();
     fuzzEngine.reset();
     octaveGenerator.reset();
     dynamicGate.reset();
@@ -393,8 +620,9 @@ bool BlackheartAudioProcessor::isBusesLayoutSupported(const BusesLayout& layouts
     juce::ignoreUnused(layouts);
     return true;
 #else
-    if (layouts.getMainOutputChannelSet() != juce::AudioChannelSet::mono()
-        && layouts.getMainOutputChannelSet() != juce::AudioChannelSet::stereo())
+    // Any channel count: every DSP stage sizes its per-channel state in
+    // prepareToPlay (multi-mic and surround re-amps run in one instance)
+    if (layouts.getMainOutputChannelSet().isDisabled())
         return false;
 
 #if ! JucePlugin_IsSynth
@@ -512,53 +740,88 @@ void BlackheartAudioProcessor::fetchParameterValues()
     currentShape = shapeParam->load();
     currentPanic = panicParam->load();
     currentChaosMix = chaosMixParam->load();
+
+    currentOctave1 = currentOctave1 || midiControl.octaveOneHeld;
+    currentOctave2 = currentOctave2 || midiControl.octaveTwoHeld;
+
+    if (midiControl.panic.has_value())
+    {
+        if (currentPanic != midiControl.panicParameterAtOverride)
+            midiControl.panic.reset();
+        else
+            currentPanic = *midiControl.panic;
+    }
+
+    if (midiControl.mode.has_value())
+    {
+        if (modeParam->load() != midiControl.modeParameterAtOverride)
+            midiControl.mode.reset();
+        else
+            currentMode = *midiControl.mode;
+    }
+}
+
+void BlackheartAudioProcessor::applyMidiEvent(const MidiMapping::Event& event)
+{
+    switch (event.target)
+    {
+        case MidiMapping::Target::octaveOne:
+            midiControl.octaveOneHeld = event.value > 0.5f;
+            break;
+
+        case MidiMapping::Target::octaveTwo:
+            midiControl.octaveTwoHeld = event.value > 0.5f;
+            break;
+
+        case MidiMapping::Target::panic:
+            midiControl.panic = event.value;
+            midiControl.panicParameterAtOverride = panicParam->load();
+            break;
+
+        case MidiMapping::Target::mode:
+            midiControl.mode = static_cast<int>(event.value);
+            midiControl.modeParameterAtOverride = modeParam->load();
+            break;
+
+        case MidiMapping::Target::none:
+        default:
+            break;
+    }
 }
 
 void BlackheartAudioProcessor::updateDSPParameters()
 {
-    // Raw block-rate values: every consumer below runs its own per-sample
-    // SmoothedValue, so an outer smoothing layer only added a skipped-to-target
-    // snapshot on top of the real ramp (double smoothing, no benefit)
-    const float smoothedGain   = currentGain;
-    const float smoothedGlare  = currentGlare;
-    const float smoothedBlend  = currentBlend;
-    const float smoothedLevel  = currentLevel;
-    const float smoothedSpeed  = currentSpeed;
-    const float smoothedChaos  = currentChaos;
-    const float smoothedRise   = currentRise;
-    const float smoothedShape  = currentShape;
-    // Note: octave1/octave2 SmoothedValues intentionally not read here.
-    // Octave buttons use raw booleans (currentOctave1/2) for instant response.
+    // Continuous parameters arrive as this block's rendered ramps; static
+    // ones are flagged so stages take their constant-gain paths. Block-rate
+    // consumers (gate influence, rise, ring mod) read the raw targets.
+    const auto& ramps = parameterRamps;
 
     // Fuzz Engine parameters
-    fuzzEngine.setGain(smoothedGain);
-    fuzzEngine.setLevel(smoothedLevel);
+    fuzzEngine.setParameterRamps(ramps.gainBlock, ramps.levelBlock, ramps.shapeBlock);
     fuzzEngine.setMode(currentMode);
-    fuzzEngine.setShape(smoothedShape);
 
     // Octave Generator parameters
-    octaveGenerator.setGlare(smoothedGlare);
+    octaveGenerator.setGlareRamp(ramps.glareBlock);
 
     // Dynamic Gate parameters (influenced by gain and glare for spitty behavior)
-    dynamicGate.setGainInfluence(smoothedGain);
-    dynamicGate.setGlareInfluence(smoothedGlare);
+    dynamicGate.setGainInfluence(currentGain);
+    dynamicGate.setGlareInfluence(currentGlare);
 
     // Blend Mixer parameters
-    blendMixer.setBlend(smoothedBlend);
+    blendMixer.setBlendRamp(ramps.blendBlock);
 
     // Pitch Shifter parameters — use raw booleans, not smoothed values.
     // Octave buttons are momentary and need instant activation.
     // The PitchShifter handles its own Rise-based smoothing internally.
     pitchShifter.setOctaveOneActive(currentOctave1);
     pitchShifter.setOctaveTwoActive(currentOctave2);
-    pitchShifter.setRiseTime(smoothedRise);
-    pitchShifter.setChaosAmount(smoothedChaos);
-    pitchShifter.setPanic(currentPanic);
-    pitchShifter.setRingModSpeed(smoothedSpeed);
+    pitchShifter.setRiseTime(currentRise);
+    pitchShifter.setParameterRamps(ramps.chaosBlock, ramps.panicBlock);
+    pitchShifter.setChaosMixRamp(ramps.chaosMixBlock);
+    pitchShifter.setRingModSpeed(currentSpeed);
 
     // Chaos Modulator parameters
-    chaosModulator.setSpeed(smoothedSpeed);
-    chaosModulator.setChaos(smoothedChaos);
+    chaosModulator.setParameterRamps(ramps.speedBlock, ramps.chaosBlock);
 }
 
 void BlackheartAudioProcessor::setOctave1(bool active)
@@ -579,7 +842,6 @@ void BlackheartAudioProcessor::setOctave2(bool active)
 
 void BlackheartAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
 {
-    juce::ignoreUnused(midiMessages);
     juce::ScopedNoDenormals noDenormals;
 
     const auto cpuStartTicks = juce::Time::getHighResolutionTicks();
@@ -596,51 +858,128 @@ void BlackheartAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, ju
 
     // Host violated prepareToPlay contract — never allocate on audio thread
     if (dryBuffer.getNumSamples() < numSamples || dryBuffer.getNumChannels() < numChannels
-        || stagingBuffer.getNumSamples() < numSamples || stagingBuffer.getNumChannels() < numChannels
-        || prePitchDryBuffer.getNumSamples() < numSamples || prePitchDryBuffer.getNumChannels() < numChannels
         || pitchModBuffer.size() < static_cast<size_t>(numSamples)
         || grainModBuffer.size() < static_cast<size_t>(numSamples)
         || timingModBuffer.size() < static_cast<size_t>(numSamples))
     {
         buffer.clear();
-        smoothedParams.chaosMix.skip(numSamples);
         return;
     }
 
+    // Kernel choices follow the render state per block; only the oversampling
+    // factor waits for prepareToPlay
+    applyBlockQuality(isNonRealtime());
+
+    //==========================================================================
+    // STAGE 0: INPUT METERING
+    //==========================================================================
+
+    const float inputLevel = measurePeakLevel(buffer);
+    signalMeters.inputLevel.store(inputLevel);
+    checkAndReportClipping(inputLevel, true, false);
+
+    const bool testMode = testModeEnabled.load(std::memory_order_relaxed);
+
+    // Mapped MIDI events land on their exact sample: the chain runs up to
+    // each event, the event is applied, and processing resumes from there
+    int segmentStart = 0;
+    for (const auto metadata : midiMessages)
+    {
+        const auto event = MidiMapping::map(metadata.getMessage(), midiAssignments);
+        if (event.target == MidiMapping::Target::none)
+            continue;
+
+        const int position = juce::jlimit(segmentStart, numSamples, metadata.samplePosition);
+        if (position > segmentStart)
+        {
+            processSegment(buffer, segmentStart, position - segmentStart, testMode);
+            segmentStart = position;
+        }
+
+        applyMidiEvent(event);
+    }
+
+    if (segmentStart < numSamples)
+        processSegment(buffer, segmentStart, numSamples - segmentStart, testMode);
+
+    if (testMode)
+        return;
+
+    float outputLevel = measurePeakLevel(buffer);
+    signalMeters.outputLevel.store(outputLevel);
+    checkAndReportClipping(outputLevel, false, true);
+
+    // CPU load: elapsed processing time / block duration. EMA smoothed.
+    {
+        const auto cpuEndTicks = juce::Time::getHighResolutionTicks();
+        const double elapsedSec = juce::Time::highResolutionTicksToSeconds(cpuEndTicks - cpuStartTicks);
+        const double blockSec = currentSampleRate > 0.0
+            ? static_cast<double>(numSamples) / currentSampleRate
+            : 0.0;
+        const float instant = blockSec > 0.0 ? juce::jlimit(0.0f, 1.0f, static_cast<float>(elapsedSec / blockSec)) : 0.0f;
+        constexpr float alpha = 0.1f;
+        const float prev = cpuLoad.load(std::memory_order_relaxed);
+        cpuLoad.store(prev + alpha * (instant - prev), std::memory_order_relaxed);
+    }
+}
+
+void BlackheartAudioProcessor::processSegment(juce::AudioBuffer<float>& buffer, int start, int length, bool testMode)
+{
+    // Sub-block automation runs the whole chain per chunk, re-reading the
+    // parameters each time; the chunks reference the host buffer in place
+    const int chunkSize = automationMode.load(std::memory_order_relaxed) == AutomationMode::SubBlock
+                          ? automationSubBlockSize
+                          : length;
+
+    for (int offset = start; offset < start + length; offset += chunkSize)
+    {
+        const int chunkSamples = juce::jmin(chunkSize, start + length - offset);
+
+        if (offset == 0 && chunkSamples == buffer.getNumSamples())
+        {
+            processChain(buffer, testMode);
+        }
+        else
+        {
+            juce::AudioBuffer<float> chunk(buffer.getArrayOfWritePointers(), buffer.getNumChannels(),
+                                           offset, chunkSamples);
+            processChain(chunk, testMode);
+        }
+    }
+}
+
+void BlackheartAudioProcessor::processChain(juce::AudioBuffer<float>& buffer, bool testMode)
+{
+    const int numSamples = buffer.getNumSamples();
+    const int numChannels = buffer.getNumChannels();
+
     //==========================================================================
     // PARAMETER FETCH AND SMOOTHING
     //==========================================================================
 
     fetchParameterValues();
 
-    const float oct1Float = currentOctave1 ? 1.0f : 0.0f;
-    const float oct2Float = currentOctave2 ? 1.0f : 0.0f;
-
     if (isFirstBlock)
     {
-        smoothedParams.setCurrentAndTargetValue(
+        parameterRamps.setCurrentAndTargetValue(
             currentGain, currentGlare, currentBlend, currentLevel,
-            currentSpeed, currentChaos, currentRise, oct1Float, oct2Float, currentShape, currentPanic, currentChaosMix);
+            currentSpeed, currentChaos, currentShape, currentPanic, currentChaosMix);
         isFirstBlock = false;
     }
     else
     {
-        smoothedParams.updateTargets(
+        parameterRamps.updateTargets(
             currentGain, currentGlare, currentBlend, currentLevel,
-            currentSpeed, currentChaos, currentRise, oct1Float, oct2Float, currentShape, currentPanic, currentChaosMix);
+            currentSpeed, currentChaos, currentShape, currentPanic, currentChaosMix);
     }
 
-    // Module parameters are smoothed inside each DSP class; only chaosMix is
-    // consumed per-sample from smoothedParams (in the chaos mix loop below)
+    // Every ramp advances once per block, whichever path runs below; stages
+    // receive the rendered arrays (or static flags) in updateDSPParameters()
+    parameterRamps.process(numSamples);
     updateDSPParameters();
 
-    //==========================================================================
-    // STAGE 0: INPUT METERING
-    //==========================================================================
-
-    const float inputLevel = measurePeakLevel(buffer);
-    signalMeters.inputLevel.store(inputLevel);
-    checkAndReportClipping(inputLevel, true, false);
+    analysisBus.beginBlock(numSamples);
+    analysisBus.capture(DSP::AnalysisBus::input, buffer.getReadPointer(0));
 
     // Track input envelope for UI and internal use
     inputEnvelope = inputEnvelopeFollower.processBlock(buffer);
@@ -649,10 +988,10 @@ void BlackheartAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, ju
     // TEST MODE: Early exit after input conditioning
     //==========================================================================
 
-    if (testModeEnabled.load(std::memory_order_relaxed))
+    if (testMode)
     {
         inputConditioner.process(buffer);
-        smoothedParams.chaosMix.skip(numSamples);
+        analysisBus.endBlock();
         return;
     }
 
@@ -661,7 +1000,10 @@ void BlackheartAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, ju
     // - DC blocking, anti-aliasing, level normalization
     //==========================================================================
 
-    inputConditioner.process(buffer);
+    {
+        BLACKHEART_PROFILE_STAGE(stageProfiler, inputConditioner, numSamples);
+        inputConditioner.process(buffer);
+    }
 
     //==========================================================================
     // STAGE 2: PRESERVE DRY SIGNAL FOR BLEND
@@ -669,8 +1011,23 @@ void BlackheartAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, ju
     // path against a conditioned wet path beats and skews the mix
     //==========================================================================
 
-    for (int ch = 0; ch < numChannels; ++ch)
-        dryBuffer.copyFrom(ch, 0, buffer, ch, 0, numSamples);
+    // Buffer routing: dryBuffer is the chain's only scratch buffer. Every
+    // other stage runs in place on `buffer`; the two crossfades against a
+    // saved signal mix as they write (BlendMixer in place against dryBuffer,
+    // Chaos Mix inside the pitch shifter against its own input), so no stage
+    // needs a staging copy.
+    //
+    // The dry capture goes through the oversampling round-trip delay on its
+    // way into dryBuffer, so it arrives phase-aligned in a single pass
+    {
+        const juce::dsp::AudioBlock<const float> conditionedBlock(buffer.getArrayOfReadPointers(),
+                                                                  static_cast<size_t>(numChannels),
+                                                                  static_cast<size_t>(numSamples));
+        juce::dsp::AudioBlock<float> dryBlock(dryBuffer.getArrayOfWritePointers(),
+                                              static_cast<size_t>(numChannels),
+                                              static_cast<size_t>(numSamples));
+        oversampler.delayToMatch(conditionedBlock, dryBlock);
+    }
 
     // Track chaos envelope from the conditioned, pre-fuzz signal — post-blend
     // the fuzz has compressed dynamics flat, leaving envelope-responsive chaos
@@ -678,26 +1035,71 @@ void BlackheartAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, ju
     chaosEnvelope = chaosEnvelopeFollower.processBlock(buffer);
     chaosModulator.setEnvelopeValue(chaosEnvelope);
 
+    //==========================================================================
+    // OVERSAMPLED DOMAIN (stages 3-4)
+    // Fuzz and the rectifier octave both run on the upsampled block; one
+    // conversion pair. The analytic octave runs after it at the native rate
+    //==========================================================================
+
+    juce::dsp::AudioBlock<float> nativeBlock(buffer.getArrayOfWritePointers(),
+                                             static_cast<size_t>(numChannels),
+                                             static_cast<size_t>(numSamples));
+    juce::dsp::AudioBlock<float> oversampledBlock;
+
+    {
+        BLACKHEART_PROFILE_STAGE(stageProfiler, oversampleUp, numSamples);
+        oversampledBlock = oversampler.processUp(nativeBlock);
+    }
+
     //==========================================================================
     // STAGE 3: FUZZ ENGINE
     // - Nonlinear waveshaping, compression, saturation
     // - Gain and Level parameters control intensity
     //==========================================================================
 
-    fuzzEngine.process(buffer);
+    {
+        BLACKHEART_PROFILE_STAGE(stageProfiler, fuzzEngine, numSamples);
+        fuzzEngine.process(oversampledBlock);
+    }
+
+    analysisBus.capture(DSP::AnalysisBus::postFuzz, oversampledBlock.getChannelPointer(0),
+                        static_cast<int>(oversampledBlock.getNumSamples()) / numSamples);
 
     //==========================================================================
     // STAGE 4: OCTAVE GENERATOR
-    // - Full-wave rectification for octave-up harmonics
+    // - Full-wave rectification (oversampled) or analytic-signal squaring
+    //   (native rate) for octave-up harmonics
     // - Glare parameter controls octave blend
     //==========================================================================
 
-    octaveGenerator.process(buffer);
+    const bool nativeRateOctave = octaveGenerator.runsAtNativeRate();
+
+    if (! nativeRateOctave)
+    {
+        BLACKHEART_PROFILE_STAGE(stageProfiler, octaveGenerator, numSamples);
+        octaveGenerator.process(oversampledBlock);
+    }
+
+    {
+        BLACKHEART_PROFILE_STAGE(stageProfiler, oversampleDown, numSamples);
+        oversampler.processDown(nativeBlock);
+    }
+
+    if (nativeRateOctave)
+    {
+        BLACKHEART_PROFILE_STAGE(stageProfiler, octaveGenerator, numSamples);
+        octaveGenerator.process(nativeBlock);
+    }
+
+    analysisBus.capture(DSP::AnalysisBus::postOctave, buffer.getReadPointer(0));
 
     // Single interstage protection point: fuzz output is self-bounded (1.2x)
     // and the octave contribution is capped, so post-octave is the only spot
     // where summed level can still exceed the internal budget
-    applyInterstageProtection(buffer);
+    {
+        BLACKHEART_PROFILE_STAGE(stageProfiler, interstageProtection, numSamples);
+        applyInterstageProtection(buffer);
+    }
 
     //==========================================================================
     // STAGE 5: DYNAMIC GATE
@@ -705,76 +1107,85 @@ void BlackheartAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, ju
     // - Threshold influenced by Gain and Glare settings
     //==========================================================================
 
-    dynamicGate.process(buffer);
+    {
+        BLACKHEART_PROFILE_STAGE(stageProfiler, dynamicGate, numSamples);
+        dynamicGate.process(buffer);
+    }
+
+    analysisBus.captureValue(DSP::AnalysisBus::gateGain, dynamicGate.getCurrentGateGain());
 
     //==========================================================================
     // STAGE 6: BLEND MIXER
-    // - Equal-power crossfade between dry and wet signals
+    // - Equal-power crossfade between dry and wet signals, in place
     // - Blend: 0% = full dry, 100% = full wet
     //==========================================================================
 
-    // Copy wet signal to staging buffer
-    for (int ch = 0; ch < numChannels; ++ch)
-        stagingBuffer.copyFrom(ch, 0, buffer, ch, 0, numSamples);
-
-    blendMixer.process(dryBuffer, stagingBuffer, buffer);
+    {
+        BLACKHEART_PROFILE_STAGE(stageProfiler, blendMixer, numSamples);
+        blendMixer.process(dryBuffer, buffer);
+    }
 
     //==========================================================================
     // STAGE 7: CHAOS MODULATOR + PITCH SHIFTER
     // - Envelope-responsive modulation system
     // - Granular pitch shifting with +1/+2 octave modes
+    // - Chaos Mix (dry/wet of the pitch section) applied by the shifter
     //==========================================================================
 
-    // Generate per-sample modulation into pre-allocated buffers — the pitch
-    // shifter reads these per sample (block-rate consumption aliased the LFO)
-    chaosModulator.processToBuffers(pitchModBuffer.data(), grainModBuffer.data(),
-                                    timingModBuffer.data(), numSamples);
-    const auto chaosMod = chaosModulator.getModulation();
-
-    // Store chaos modulation for visualization (lock-free)
-    chaosModValue.store(chaosMod.combinedMod, std::memory_order_relaxed);
-
-    // Save pre-pitch dry signal for chaos mix (pre-allocated in prepareToPlay)
-    for (int ch = 0; ch < numChannels; ++ch)
-        prePitchDryBuffer.copyFrom(ch, 0, buffer, ch, 0, numSamples);
-
-    // Process pitch shifting
-    pitchShifter.process(buffer);
+    // Idle fast path: with no octave held and the wet path fully decayed the
+    // shifter output equals its input, so modulation generation is skipped
+    // (and Chaos Mix has nothing to mix). The shifter still feeds its delay
+    // line so the next engage starts from real history.
+    if (pitchShifter.isIdle())
+    {
+        {
+            BLACKHEART_PROFILE_STAGE(stageProfiler, chaosModulator, numSamples);
+            chaosModulator.skip(numSamples);
+        }
+        chaosModValue.store(0.0f, std::memory_order_relaxed);
+        analysisBus.captureValue(DSP::AnalysisBus::chaosMod, 0.0f);
 
-    // Apply chaos mix (dry/wet blend for pitch section), ramped per sample
+        {
+            BLACKHEART_PROFILE_STAGE(stageProfiler, pitchShifter, numSamples);
+            pitchShifter.process(buffer);
+        }
+    }
+    else
     {
-        const int mixChannels = buffer.getNumChannels();
-        float* wetPtrs[8] = {};
-        const float* dryPtrs[8] = {};
-        const int clampedChannels = std::min(mixChannels, 8);
-        for (int ch = 0; ch < clampedChannels; ++ch)
+        // Generate per-sample modulation into pre-allocated buffers — the pitch
+        // shifter reads these per sample (block-rate consumption aliased the LFO)
         {
-            wetPtrs[ch] = buffer.getWritePointer(ch);
-            dryPtrs[ch] = prePitchDryBuffer.getReadPointer(ch);
+            BLACKHEART_PROFILE_STAGE(stageProfiler, chaosModulator, numSamples);
+            chaosModulator.processToBuffers(pitchModBuffer.data(), grainModBuffer.data(),
+                                            timingModBuffer.data(), numSamples);
         }
-        for (int i = 0; i < numSamples; ++i)
+        const auto chaosMod = chaosModulator.getModulation();
+
+        // Store chaos modulation for visualization (lock-free)
+        chaosModValue.store(chaosMod.combinedMod, std::memory_order_relaxed);
+        analysisBus.capture(DSP::AnalysisBus::chaosMod, pitchModBuffer.data());
+
+        // Process pitch shifting
         {
-            const float mix = smoothedParams.chaosMix.getNextValue();
-            for (int ch = 0; ch < clampedChannels; ++ch)
-                wetPtrs[ch][i] = dryPtrs[ch][i] + mix * (wetPtrs[ch][i] - dryPtrs[ch][i]);
+            BLACKHEART_PROFILE_STAGE(stageProfiler, pitchShifter, numSamples);
+            pitchShifter.process(buffer);
         }
     }
 
     //==========================================================================
     // STAGE 8: OUTPUT LIMITER
-    // - Soft clipping with tanh saturation
+    // - Soft clipping with tanh saturation, or look-ahead true-peak limiting
     // - DC blocking and headroom management
     //==========================================================================
 
-    outputLimiter.process(buffer);
-
-    float outputLevel = measurePeakLevel(buffer);
-    signalMeters.outputLevel.store(outputLevel);
-    checkAndReportClipping(outputLevel, false, true);
+    {
+        BLACKHEART_PROFILE_STAGE(stageProfiler, outputLimiter, numSamples);
+        outputLimiter.process(buffer);
+    }
 
-    // Push waveform data for visualization (lock-free, downsampled)
-    if (buffer.getNumChannels() > 0)
-        waveformFifo.pushBlock(buffer.getReadPointer(0), numSamples);
+    // Publish this block's completed analysis frames (lock-free, bulk copy)
+    analysisBus.capture(DSP::AnalysisBus::output, buffer.getReadPointer(0));
+    analysisBus.endBlock();
 
     // Safety check: if we've had too many consecutive high-level blocks, apply gradual reduction
     // instead of sudden halving which causes audible volume drops
@@ -785,19 +1196,6 @@ void BlackheartAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, ju
         consecutiveHighLevelBlocks = 0;
         stabilityError = true;
     }
-
-    // CPU load: elapsed processing time / block duration. EMA smoothed.
-    {
-        const auto cpuEndTicks = juce::Time::getHighResolutionTicks();
-        const double elapsedSec = juce::Time::highResolutionTicksToSeconds(cpuEndTicks - cpuStartTicks);
-        const double blockSec = currentSampleRate > 0.0
-            ? static_cast<double>(numSamples) / currentSampleRate
-            : 0.0;
-        const float instant = blockSec > 0.0 ? juce::jlimit(0.0f, 1.0f, static_cast<float>(elapsedSec / blockSec)) : 0.0f;
-        constexpr float alpha = 0.1f;
-        const float prev = cpuLoad.load(std::memory_order_relaxed);
-        cpuLoad.store(prev + alpha * (instant - prev), std::memory_order_relaxed);
-    }
 }
 
 //==============================================================================
@@ -806,12 +1204,20 @@ void BlackheartAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, ju
 
 bool BlackheartAudioProcessor::hasEditor() const
 {
+#if BLACKHEART_HEADLESS
+    return false;
+#else
     return true;
+#endif
 }
 
 juce::AudioProcessorEditor* BlackheartAudioProcessor::createEditor()
 {
+#if BLACKHEART_HEADLESS
+    return nullptr;
+#else
     return new BlackheartAudioProcessorEditor(*this);
+#endif
 }
 
 //==============================================================================
@@ -826,6 +1232,12 @@ void BlackheartAudioProcessor::getStateInformation(juce::MemoryBlock& destData)
     if (xml != nullptr)
     {
         xml->setAttribute("pluginVersion", JucePlugin_VersionString);
+        xml->setAttribute("automationMode", static_cast<int>(getAutomationMode()));
+        xml->setAttribute("midiChannel", pendingMidiAssignments.channel);
+        xml->setAttribute("midiOctave1Note", pendingMidiAssignments.octaveOneNote);
+        xml->setAttribute("midiOctave2Note", pendingMidiAssignments.octaveTwoNote);
+        xml->setAttribute("midiPanicController", pendingMidiAssignments.panicController);
+        xml->setAttribute("midiModeController", pendingMidiAssignments.modeController);
         copyXmlToBinary(*xml, destData);
     }
 }
@@ -838,16 +1250,23 @@ void BlackheartAudioProcessor::setStateInformation(const void* data, int sizeInB
     {
         if (xmlState->hasTagName(apvts.state.getType()))
         {
-            apvts.replaceState(juce::ValueTree::fromXml(*xmlState));
+            setAutomationMode(xmlState->getIntAttribute("automationMode", 0) == static_cast<int>(AutomationMode::SubBlock)
+                                  ? AutomationMode::SubBlock : AutomationMode::Block);
+
+            const MidiMapping::Assignments defaults;
+            MidiMapping::Assignments midi;
+            midi.channel = juce::jlimit(0, 16, xmlState->getIntAttribute("midiChannel", defaults.channel));
+            midi.octaveOneNote = juce::jlimit(0, 127, xmlState->getIntAttribute("midiOctave1Note", defaults.octaveOneNote));
+            midi.octaveTwoNote = juce::jlimit(0, 127, xmlState->getIntAttribute("midiOctave2Note", defaults.octaveTwoNote));
+            midi.panicController = juce::jlimit(0, 127, xmlState->getIntAttribute("midiPanicController", defaults.panicController));
+            midi.modeController = juce::jlimit(0, 127, xmlState->getIntAttribute("midiModeController", defaults.modeController));
+            setMidiAssignments(midi);
 
-            fetchParameterValues();
-
-            const float oct1Float = currentOctave1 ? 1.0f : 0.0f;
-            const float oct2Float = currentOctave2 ? 1.0f : 0.0f;
+            apvts.replaceState(juce::ValueTree::fromXml(*xmlState));
 
-        smoothedParams.setCurrentAndTargetValue(
-            currentGain, currentGlare, currentBlend, currentLevel,
-            currentSpeed, currentChaos, currentRise, oct1Float, oct2Float, currentShape, currentPanic, currentChaosMix);
+            // Snap (not ramp) to the restored values on the next block; the
+            // ramps themselves belong to the audio thread
+            isFirstBlock = true;
         }
     }
 }
@@ -2,68 +2,27 @@
 
 #include <JuceHeader.h>
 #include "Parameters/ParameterIDs.h"
+#include "Parameters/MidiMapping.h"
 #include "DSP/InputConditioner.h"
 #include "DSP/FuzzEngine.h"
 #include "DSP/OctaveGenerator.h"
+#include "DSP/Oversampler.h"
 #include "DSP/DynamicGate.h"
 #include "DSP/BlendMixer.h"
 #include "DSP/PitchShifter.h"
 #include "DSP/ChaosModulator.h"
 #include "DSP/EnvelopeFollower.h"
 #include "DSP/OutputLimiter.h"
-
-//==============================================================================
-// Lock-free FIFO for waveform visualization
-template <typename T, int Size>
-class LockFreeFifo
-{
-public:
-    void push(T value) noexcept
-    {
-        const int currentWrite = writeIndex.load(std::memory_order_relaxed);
-        buffer[static_cast<size_t>(currentWrite)] = value;
-        writeIndex.store((currentWrite + 1) % Size, std::memory_order_release);
-    }
-
-    void pushBlock(const T* data, int numSamples) noexcept
-    {
-        // Downsample to avoid overwhelming the FIFO
-        const int skip = std::max(1, numSamples / 64);
-        for (int i = 0; i < numSamples; i += skip)
-            push(data[i]);
-    }
-
-    bool pull(T& value) noexcept
-    {
-        const int currentRead = readIndex.load(std::memory_order_relaxed);
-        const int currentWrite = writeIndex.load(std::memory_order_acquire);
-
-        if (currentRead == currentWrite)
-            return false;
-
-        value = buffer[static_cast<size_t>(currentRead)];
-        readIndex.store((currentRead + 1) % Size, std::memory_order_release);
-        return true;
-    }
-
-    int getNumAvailable() const noexcept
-    {
-        const int w = writeIndex.load(std::memory_order_acquire);
-        const int r = readIndex.load(std::memory_order_acquire);
-        return (w - r + Size) % Size;
-    }
-
-    void reset() noexcept
-    {
-        readIndex.store(0, std::memory_order_relaxed);
-        writeIndex.store(0, std::memory_order_relaxed);
-    }
-
-private:
-    std::array<T, Size> buffer{};
-    std::atomic<int> writeIndex{0};
-    std::atomic<int> readIndex{0};
-};
+#include "DSP/StageProfiler.h"
+#include "DSP/ParameterRamp.h"
+#include "DSP/AnalysisBus.h"
+#include <optional>
+
+// Console tools (benchmarks, offline renderers) build the processor without
+// the editor, UI sources or font BinaryData
+#ifndef BLACKHEART_HEADLESS
+ #define BLACKHEART_HEADLESS 0
+#endif
 
 //==============================================================================
 // Signal chain metering for gain staging verification
@@ -86,40 +45,41 @@ struct SignalMeters
     }
 };
 
-struct SmoothedParameters
+// Central block-rate ramp service: each continuous parameter is rendered
+// once per block into a contiguous array (or flagged static), and the
+// resulting RampBlocks are handed to the stages that consume them
+struct ParameterRamps
 {
-    juce::SmoothedValue<float> gain;
-    juce::SmoothedValue<float> glare;
-    juce::SmoothedValue<float> blend;
-    juce::SmoothedValue<float> level;
-    juce::SmoothedValue<float> speed;
-    juce::SmoothedValue<float> chaos;
-    juce::SmoothedValue<float> rise;
-    juce::SmoothedValue<float> octave1;
-    juce::SmoothedValue<float> octave2;
-    juce::SmoothedValue<float> shape;
-    juce::SmoothedValue<float> panic;
-    juce::SmoothedValue<float> chaosMix;
-
-    void prepare(double sampleRate)
+    DSP::ParameterRamp gain;
+    DSP::ParameterRamp glare;
+    DSP::ParameterRamp blend;
+    DSP::ParameterRamp level;
+    DSP::ParameterRamp speed;
+    DSP::ParameterRamp chaos;
+    DSP::ParameterRamp shape;
+    DSP::ParameterRamp panic;
+    DSP::ParameterRamp chaosMix;
+
+    // Rendered by process(); arrays valid until the next process() call
+    DSP::RampBlock gainBlock, glareBlock, blendBlock, levelBlock, speedBlock,
+                   chaosBlock, shapeBlock, panicBlock, chaosMixBlock;
+
+    void prepare(double sampleRate, int maxBlockSize)
     {
-        gain.reset(sampleRate, ParameterIDs::Smoothing::gainRampSec);
-        glare.reset(sampleRate, ParameterIDs::Smoothing::glareRampSec);
-        blend.reset(sampleRate, ParameterIDs::Smoothing::blendRampSec);
-        level.reset(sampleRate, ParameterIDs::Smoothing::levelRampSec);
-        speed.reset(sampleRate, ParameterIDs::Smoothing::speedRampSec);
-        chaos.reset(sampleRate, ParameterIDs::Smoothing::chaosRampSec);
-        rise.reset(sampleRate, ParameterIDs::Smoothing::riseRampSec);
-        octave1.reset(sampleRate, ParameterIDs::Smoothing::octaveRampSec);
-        octave2.reset(sampleRate, ParameterIDs::Smoothing::octaveRampSec);
-        shape.reset(sampleRate, ParameterIDs::Smoothing::shapeRampSec);
-        panic.reset(sampleRate, ParameterIDs::Smoothing::panicRampSec);
-        chaosMix.reset(sampleRate, ParameterIDs::Smoothing::chaosMixRampSec);
+        gain.prepare(sampleRate, ParameterIDs::Smoothing::gainRampSec, maxBlockSize);
+        glare.prepare(sampleRate, ParameterIDs::Smoothing::glareRampSec, maxBlockSize);
+        blend.prepare(sampleRate, ParameterIDs::Smoothing::blendRampSec, maxBlockSize);
+        level.prepare(sampleRate, ParameterIDs::Smoothing::levelRampSec, maxBlockSize);
+        speed.prepare(sampleRate, ParameterIDs::Smoothing::speedRampSec, maxBlockSize);
+        chaos.prepare(sampleRate, ParameterIDs::Smoothing::chaosRampSec, maxBlockSize);
+        shape.prepare(sampleRate, ParameterIDs::Smoothing::shapeRampSec, maxBlockSize);
+        panic.prepare(sampleRate, ParameterIDs::Smoothing::panicRampSec, maxBlockSize);
+        chaosMix.prepare(sampleRate, ParameterIDs::Smoothing::chaosMixRampSec, maxBlockSize);
     }
 
     void setCurrentAndTargetValue(float gainVal, float glareVal, float blendVal,
-                                   float levelVal, float speedVal, float chaosVal,
-                                   float riseVal, float oct1Val, float oct2Val, float shapeVal, float panicVal, float chaosMixVal)
+                                  float levelVal, float speedVal, float chaosVal,
+                                  float shapeVal, float panicVal, float chaosMixVal)
     {
         gain.setCurrentAndTargetValue(gainVal);
         glare.setCurrentAndTargetValue(glareVal);
@@ -127,9 +87,6 @@ struct SmoothedParameters
         level.setCurrentAndTargetValue(levelVal);
         speed.setCurrentAndTargetValue(speedVal);
         chaos.setCurrentAndTargetValue(chaosVal);
-        rise.setCurrentAndTargetValue(riseVal);
-        octave1.setCurrentAndTargetValue(oct1Val);
-        octave2.setCurrentAndTargetValue(oct2Val);
         shape.setCurrentAndTargetValue(shapeVal);
         panic.setCurrentAndTargetValue(panicVal);
         chaosMix.setCurrentAndTargetValue(chaosMixVal);
@@ -137,7 +94,7 @@ struct SmoothedParameters
 
     void updateTargets(float gainVal, float glareVal, float blendVal,
                        float levelVal, float speedVal, float chaosVal,
-                       float riseVal, float oct1Val, float oct2Val, float shapeVal, float panicVal, float chaosMixVal)
+                       float shapeVal, float panicVal, float chaosMixVal)
     {
         gain.setTargetValue(gainVal);
         glare.setTargetValue(glareVal);
@@ -145,42 +102,55 @@ struct SmoothedParameters
         level.setTargetValue(levelVal);
         speed.setTargetValue(speedVal);
         chaos.setTargetValue(chaosVal);
-        rise.setTargetValue(riseVal);
-        octave1.setTargetValue(oct1Val);
-        octave2.setTargetValue(oct2Val);
         shape.setTargetValue(shapeVal);
         panic.setTargetValue(panicVal);
         chaosMix.setTargetValue(chaosMixVal);
     }
 
-    // chaosMix excluded: consumed per-sample via getNextValue() in processBlock
-    void skip(int numSamples)
+    // Audio thread: static parameters cost a branch each
+    void process(int numSamples) noexcept
     {
-        gain.skip(numSamples);
-        glare.skip(numSamples);
-        blend.skip(numSamples);
-        level.skip(numSamples);
-        speed.skip(numSamples);
-        chaos.skip(numSamples);
-        rise.skip(numSamples);
-        octave1.skip(numSamples);
-        octave2.skip(numSamples);
-        shape.skip(numSamples);
-        panic.skip(numSamples);
+        gainBlock = gain.process(numSamples);
+        glareBlock = glare.process(numSamples);
+        blendBlock = blend.process(numSamples);
+        levelBlock = level.process(numSamples);
+        speedBlock = speed.process(numSamples);
+        chaosBlock = chaos.process(numSamples);
+        shapeBlock = shape.process(numSamples);
+        panicBlock = panic.process(numSamples);
+        chaosMixBlock = chaosMix.process(numSamples);
     }
 
     bool isSmoothing() const
     {
         return gain.isSmoothing() || glare.isSmoothing() || blend.isSmoothing() ||
                level.isSmoothing() || speed.isSmoothing() || chaos.isSmoothing() ||
-               rise.isSmoothing() || octave1.isSmoothing() || octave2.isSmoothing() ||
                shape.isSmoothing() || panic.isSmoothing() || chaosMix.isSmoothing();
     }
 };
 
-class BlackheartAudioProcessor : public juce::AudioProcessor
+class BlackheartAudioProcessor : public juce::AudioProcessor,
+                                 private juce::AudioProcessorValueTreeState::Listener,
+                                 private juce::AsyncUpdater
 {
 public:
+    // Processing quality. Render is selected automatically while the host
+    // renders offline; LowCpu/Efficient/Live are the user's choice for
+    // realtime use (the QUALITY parameter). Values are stored in the plugin
+    // state, so new tiers are appended.
+    //   LowCpu:    no oversampling, table tanh, Hermite pitch reads
+    //   Live:      2x min-phase IIR, table tanh, Hermite pitch reads (default)
+    //   Render:    8x linear-phase FIR, exact tanh, windowed-sinc pitch reads
+    //   Efficient: no oversampling, antiderivative anti-aliased fuzz (one
+    //              sample of latency), Hermite pitch reads
+    enum class QualityTier
+    {
+        LowCpu = 0,
+        Live,
+        Render,
+        Efficient
+    };
+
     BlackheartAudioProcessor();
     ~BlackheartAudioProcessor() override;
 
@@ -248,24 +218,103 @@ public:
     // Latency reporting
     int getLatencyInSamples() const { return totalLatencySamples; }
 
+    // Realtime quality tier (LowCpu, Efficient or Live; Render is offline-only),
+    // through the QUALITY parameter. A prepared processor re-prepares itself
+    // on the message thread when it changes
+    void setLiveQuality(QualityTier tier);
+    QualityTier getLiveQuality() const;
+    // Tier the oversampling domain was prepared with
+    QualityTier getPreparedQuality() const { return preparedQuality; }
+    static DSP::Oversampler::Config getOversamplingConfigFor(QualityTier tier);
+
+    // Oversampling for the fuzz/octave domain in realtime use. Without an
+    // explicit config the live tier supplies it; offline renders always use
+    // the Render tier's. Re-prepares like a tier change — message thread only
+    void setOversamplingConfig(const DSP::Oversampler::Config& config);
+    void resetOversamplingConfig();
+    // Config the domain was prepared with
+    const DSP::Oversampler::Config& getOversamplingConfig() const { return oversampler.getConfig(); }
+
+    // Message thread: re-prepares now if a prepare-time setting changed since
+    // the last prepareToPlay. Normally runs asynchronously after the change
+    void applyPendingReconfiguration() { handleUpdateNowIfNeeded(); }
+
+    // Output limiter look-ahead in ms (the LOOK-AHEAD parameter): 0 = off,
+    // otherwise 0.5-5ms of true-peak look-ahead, reported as latency. A
+    // prepared processor re-prepares itself on the message thread
+    void setLimiterLookahead(float milliseconds);
+    float getLimiterLookahead() const { return DSP::OutputLimiter::clampLookahead(limiterLookaheadParam->load()); }
+
+    // Octave-up engine (the OCTAVE ENGINE parameter): Rectifier (in the
+    // oversampled domain, the original voicing) or Analytic (IIR Hilbert
+    // pair at the native rate). A prepared processor re-prepares itself on
+    // the message thread
+    void setOctaveEngine(DSP::OctaveGenerator::Engine engine);
+    DSP::OctaveGenerator::Engine getOctaveEngine() const;
+    // Engine the octave stage was prepared with
+    DSP::OctaveGenerator::Engine getPreparedOctaveEngine() const
+    {
+        return octaveGenerator.runsAtNativeRate() ? DSP::OctaveGenerator::Engine::Analytic
+                                                  : DSP::OctaveGenerator::Engine::Rectifier;
+    }
+
+    // Parameter resolution. Block reads parameters once per processBlock;
+    // SubBlock runs the chain on automationSubBlockSize-sample chunks and
+    // re-reads them per chunk, so changes land within one chunk of their
+    // position at any host buffer size. Any thread
+    enum class AutomationMode
+    {
+        Block = 0,
+        SubBlock
+    };
+    static constexpr int automationSubBlockSize = 32;
+    void setAutomationMode(AutomationMode mode) { automationMode.store(mode, std::memory_order_relaxed); }
+    AutomationMode getAutomationMode() const { return automationMode.load(std::memory_order_relaxed); }
+
+    // MIDI notes/controllers driving the octaves, PANIC and mode — message
+    // thread only. Once prepared, a change re-prepares from the message loop
+    void setMidiAssignments(const MidiMapping::Assignments& newAssignments);
+    const MidiMapping::Assignments& getMidiAssignments() const { return pendingMidiAssignments; }
+
+    // Pins the chaos and grain-jitter random sources so renders repeat
+    // exactly (regression tests). Applied at the next prepareToPlay —
+    // message thread only
+    void setRandomSeed(unsigned int seed) { pinnedRandomSeed = seed; }
+
     // CPU load — 0..1, EMA-smoothed processBlock cost / block duration
     float getCpuLoad() const { return cpuLoad.load(std::memory_order_relaxed); }
 
+    // Per-stage timing — only populated when built with BLACKHEART_PROFILE_STAGES=1
+    DSP::StageProfiler& getStageProfiler() { return stageProfiler; }
+
     // Stability monitoring
     bool isStable() const { return !stabilityError.load(std::memory_order_relaxed); }
     void resetStabilityError() { stabilityError.store(false, std::memory_order_relaxed); }
 
-    // Waveform visualization data (lock-free)
-    static constexpr int waveformFifoSize = 2048;
-    LockFreeFifo<float, waveformFifoSize>& getWaveformFifo() { return waveformFifo; }
+    // Decimated min/max frames of the probed stages (scope, headless tests)
+    DSP::AnalysisBus& getAnalysisBus() { return analysisBus; }
 
     // Chaos modulation output for visualization
     float getChaosModulationValue() const { return chaosModValue.load(std::memory_order_relaxed); }
     float getGainReduction() const { return signalMeters.outputLevel.load() > 0.9f ? 0.1f : 0.0f; }
 
 private:
+    // Prepare-time settings: a change re-prepares the chain (new latency)
+    void parameterChanged(const juce::String& parameterID, float newValue) override;
+    void handleAsyncUpdate() override;
+    bool needsReconfiguration() const;
+    DSP::Oversampler::Config getRequestedOversamplingConfig(QualityTier tier) const;
+
     void updateDSPParameters();
     void fetchParameterValues();
+    void applyBlockQuality(bool renderingOffline);
+    // Samples [start, start + length) of the host block, in automation
+    // sub-blocks when enabled
+    void processSegment(juce::AudioBuffer<float>& buffer, int start, int length, bool testMode);
+    // Everything between input metering and output metering, for one block
+    // or one automation sub-block
+    void processChain(juce::AudioBuffer<float>& buffer, bool testMode);
+    void applyMidiEvent(const MidiMapping::Event& event);
 
     juce::AudioProcessorValueTreeState apvts;
 
@@ -282,8 +331,11 @@ private:
     std::atomic<float>* shapeParam = nullptr;
     std::atomic<float>* panicParam = nullptr;
     std::atomic<float>* chaosMixParam = nullptr;
+    std::atomic<float>* qualityParam = nullptr;
+    std::atomic<float>* limiterLookaheadParam = nullptr;
+    std::atomic<float>* octaveEngineParam = nullptr;
 
-    SmoothedParameters smoothedParams;
+    ParameterRamps parameterRamps;
 
     float currentGain   = ParameterIDs::Defaults::gain;
     float currentGlare  = ParameterIDs::Defaults::glare;
@@ -300,6 +352,26 @@ private:
     float currentChaosMix = ParameterIDs::Defaults::chaosMix;
 
     DSP::InputConditioner inputConditioner;
+    DSP::Oversampler oversampler;
+    QualityTier preparedQuality = QualityTier::Live;
+    std::optional<DSP::Oversampler::Config> oversamplingOverride;
+    std::atomic<AutomationMode> automationMode { AutomationMode::Block };
+
+    // Audio thread: MIDI-held octaves add to the buttons; a MIDI PANIC or
+    // mode value holds until that parameter itself moves
+    struct MidiControlState
+    {
+        bool octaveOneHeld = false;
+        bool octaveTwoHeld = false;
+        std::optional<float> panic;
+        float panicParameterAtOverride = 0.0f;
+        std::optional<int> mode;
+        float modeParameterAtOverride = 0.0f;
+    };
+    MidiMapping::Assignments pendingMidiAssignments;
+    MidiMapping::Assignments midiAssignments;
+    MidiControlState midiControl;
+    std::optional<unsigned int> pinnedRandomSeed;
     DSP::FuzzEngine fuzzEngine;
     DSP::OctaveGenerator octaveGenerator;
     DSP::DynamicGate dynamicGate;
@@ -310,9 +382,8 @@ private:
     DSP::EnvelopeFollower chaosEnvelopeFollower;
     DSP::OutputLimiter outputLimiter;
 
+    // The chain's only scratch buffer: the delayed dry path for BlendMixer
     juce::AudioBuffer<float> dryBuffer;
-    juce::AudioBuffer<float> stagingBuffer;
-    juce::AudioBuffer<float> prePitchDryBuffer;
 
     // Per-sample chaos modulation buffers (sized in prepareToPlay)
     std::vector<float> pitchModBuffer;
@@ -323,7 +394,9 @@ private:
     std::atomic<float> chaosEnvelope { 0.0f };
 
     double currentSampleRate = 44100.0;
+    std::atomic<bool> isPrepared { false };
     std::atomic<float> cpuLoad { 0.0f };
+    DSP::StageProfiler stageProfiler;
     int currentBlockSize = 512;
     std::atomic<bool> isFirstBlock { true };
     std::atomic<bool> testModeEnabled { false };
@@ -334,6 +407,8 @@ private:
     // Latency tracking
     int totalLatencySamples = 0;
     int pitchShifterLatency = 0;
+    int oversamplingLatency = 0;
+    int limiterLatency = 0;
 
     // Stability safeguards
     std::atomic<bool> stabilityError { false };
@@ -343,7 +418,7 @@ private:
     static constexpr float safetyClipThreshold = 8.0f;
 
     // Visualization data (lock-free for GUI)
-    LockFreeFifo<float, waveformFifoSize> waveformFifo;
+    DSP::AnalysisBus analysisBus;
     std::atomic<float> chaosModValue{0.0f};
 
     // Gain staging helpers
@@ -2,55 +2,88 @@
 #include "BlackheartPalette.h"
 #include "BlackheartLookAndFeel.h"
 
-// Phosphor bloom = stacked strokes with alpha falloff. No shaders, no
-// scanlines, no curvature. Glow is the only effect on this face.
+// Phosphor bloom = wide faint strokes under a bright core. No shaders, no
+// scanlines, no curvature. Glow is the only effect on this face. The bloom
+// strokes go into a quarter-res layer, so they cost a fraction of a full
+// stroke and come out blurred for free when the layer is scaled up.
 
 Scope::Scope()
 {
     setInterceptsMouseClicks(false, false);
-    startTimerHz(30);
     for (auto& v : displayBuffer)
         v = 0.0f;
+    trace.preallocateSpace(displayBufferSize * 3);
 }
 
-void Scope::paint(juce::Graphics& g)
+void Scope::resized()
 {
-    auto bounds = getLocalBounds().toFloat();
-
-    g.setColour(Blackheart::bg());
-    g.fillRect(bounds);
-
-    auto inner = bounds.reduced(1.0f);
+    traceDirty = true;
+}
 
-    // Faint centre reference line.
-    g.setColour(Blackheart::lineAt(0.8f));
-    g.fillRect(juce::Rectangle<float>(inner.getX(), inner.getCentreY() - 0.5f, inner.getWidth(), 1.0f));
+void Scope::rebuildTrace()
+{
+    auto inner = getLocalBounds().toFloat().reduced(1.0f);
 
-    // Waveform path.
     const float centreY   = inner.getCentreY();
     const float amplitude = inner.getHeight() * 0.42f;
     const float xStep     = inner.getWidth() / static_cast<float>(displayBufferSize - 1);
 
-    juce::Path waveform;
-    waveform.preallocateSpace(displayBufferSize * 3);
-
+    // Oldest sample on the left; clear() keeps the path's storage
+    trace.clear();
     for (int i = 0; i < displayBufferSize; ++i)
     {
         const float x = inner.getX() + static_cast<float>(i) * xStep;
-        const float y = centreY - displayBuffer[static_cast<size_t>(i)] * amplitude;
+        const float y = centreY - displayBuffer[static_cast<size_t>((writeIndex + i) % displayBufferSize)] * amplitude;
         if (i == 0)
-            waveform.startNewSubPath(x, y);
+            trace.startNewSubPath(x, y);
         else
-            waveform.lineTo(x, y);
+            trace.lineTo(x, y);
+    }
+
+    const int layerW = juce::jmax(1, getWidth() / bloomDownscale + 1);
+    const int layerH = juce::jmax(1, getHeight() / bloomDownscale + 1);
+
+    if (bloomLayer.getWidth() != layerW || bloomLayer.getHeight() != layerH)
+        bloomLayer = juce::Image(juce::Image::ARGB, layerW, layerH, true);
+    else
+        bloomLayer.clear(bloomLayer.getBounds());
+
+    {
+        juce::Graphics layer(bloomLayer);
+        layer.addTransform(juce::AffineTransform::scale(1.0f / static_cast<float>(bloomDownscale)));
+        layer.setColour(Blackheart::accentAt(0.10f));
+        layer.strokePath(trace, juce::PathStrokeType(6.0f, juce::PathStrokeType::curved));
+        layer.setColour(Blackheart::accentAt(0.28f));
+        layer.strokePath(trace, juce::PathStrokeType(3.0f, juce::PathStrokeType::curved));
     }
 
-    // Phosphor bloom: wide faint → narrow bright.
-    g.setColour(Blackheart::accentAt(0.10f));
-    g.strokePath(waveform, juce::PathStrokeType(6.0f, juce::PathStrokeType::curved));
-    g.setColour(Blackheart::accentAt(0.28f));
-    g.strokePath(waveform, juce::PathStrokeType(3.0f, juce::PathStrokeType::curved));
+    traceDirty = false;
+}
+
+void Scope::paint(juce::Graphics& g)
+{
+    auto bounds = getLocalBounds().toFloat();
+
+    g.setColour(Blackheart::bg());
+    g.fillRect(bounds);
+
+    auto inner = bounds.reduced(1.0f);
+
+    // Faint centre reference line.
+    g.setColour(Blackheart::lineAt(0.8f));
+    g.fillRect(juce::Rectangle<float>(inner.getX(), inner.getCentreY() - 0.5f, inner.getWidth(), 1.0f));
+
+    if (traceDirty)
+        rebuildTrace();
+
+    // Phosphor bloom: pre-rendered glow layer, then the bright core.
+    g.setImageResamplingQuality(juce::Graphics::mediumResamplingQuality);
+    g.drawImage(bloomLayer,
+                juce::Rectangle<float>(0.0f, 0.0f,
+                                       static_cast<float>(bloomLayer.getWidth() * bloomDownscale),
+                                       static_cast<float>(bloomLayer.getHeight() * bloomDownscale)));
     g.setColour(Blackheart::accent());
-    g.strokePath(waveform, juce::PathStrokeType(1.5f, juce::PathStrokeType::curved));
+    g.strokePath(trace, juce::PathStrokeType(1.5f, juce::PathStrokeType::curved));
 
     // --- OSD chrome, burned into corners ---
     const float pad = 10.0f;
@@ -74,24 +107,44 @@ void Scope::paint(juce::Graphics& g)
 
 void Scope::pushSamples(const float* samples, int numSamples)
 {
+    if (numSamples <= 0)
+        return;
+
+    // The bus publishes frames through silence too. A flat buffer that only
+    // takes in more of the same level scrolls into an identical trace, so
+    // the cached layer stays valid and nothing repaints
+    const bool wasFlat = flatRun >= displayBufferSize;
+    const float previousLevel = flatLevel;
+
     for (int i = 0; i < numSamples; ++i)
     {
+        if (std::abs(samples[i] - flatLevel) <= flatTolerance)
+        {
+            flatRun = juce::jmin(flatRun + 1, displayBufferSize);
+        }
+        else
+        {
+            flatLevel = samples[i];
+            flatRun = 1;
+        }
+
         displayBuffer[static_cast<size_t>(writeIndex)] = samples[i];
         writeIndex = (writeIndex + 1) % displayBufferSize;
     }
-}
 
-void Scope::timerCallback()
-{
+    if (wasFlat && flatRun >= displayBufferSize && flatLevel == previousLevel)
+        return;
+
+    traceDirty = true;
     repaint();
 }
 
 void Scope::setOsdChannel(const juce::String& text)
 {
-    if (text != osdChannel) { osdChannel = text; }
+    if (text != osdChannel) { osdChannel = text; repaint(); }
 }
 
 void Scope::setOsdMomentary(const juce::String& text)
 {
-    if (text != osdMomentary) { osdMomentary = text; }
+    if (text != osdMomentary) { osdMomentary = text; repaint(); }
 }
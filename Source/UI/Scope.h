@@ -6,25 +6,42 @@ class BlackheartAudioProcessor;
 
 // DEAD CHANNEL CRT scope. Waveform with phosphor bloom on void black.
 // Minimal OSD: top-left active preset, bottom-left momentary states.
-class Scope : public juce::Component, public juce::Timer
+// No timer of its own: the editor pushes samples from its timer and the
+// scope repaints only when something changed.
+class Scope : public juce::Component
 {
 public:
     Scope();
 
     void paint(juce::Graphics& g) override;
+    void resized() override;
     void pushSamples(const float* samples, int numSamples);
-    void timerCallback() override;
     void setProcessor(BlackheartAudioProcessor* p) { processor = p; }
 
     void setOsdChannel(const juce::String& text);   // e.g. "SCREAM"
     void setOsdMomentary(const juce::String& text); // e.g. "+1OCT\xC2\xB7HOLD" or ""
 
 private:
+    void rebuildTrace();
+
     static constexpr int displayBufferSize = 512;
     std::array<float, displayBufferSize> displayBuffer{};
     int writeIndex = 0;
     BlackheartAudioProcessor* processor = nullptr;
 
+    // Trace path (storage reused across rebuilds) and the bloom, stroked
+    // once into a low-res layer and smoothed by upscaling on draw
+    static constexpr int bloomDownscale = 4;
+    juce::Path trace;
+    juce::Image bloomLayer;
+    bool traceDirty = true;
+
+    // Samples since the trace last left flatLevel (capped at the buffer
+    // size); differences below flatTolerance are far under a pixel
+    static constexpr float flatTolerance = 1.0e-4f;
+    float flatLevel = 0.0f;
+    int flatRun = displayBufferSize;
+
     juce::String osdChannel, osdMomentary;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(Scope)
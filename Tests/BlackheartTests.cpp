@@ -6,10 +6,19 @@
  */
 
 #include "../Source/PluginProcessor.h"
+#include "../Source/DSP/FilterCascade.h"
+#include "../Source/DSP/LookupTables.h"
+#include "../Source/DSP/MathKernels.h"
+#include "../Source/DSP/ParameterRamp.h"
+#include "TestSignals.h"
+#include <algorithm>
 #include <cassert>
 #include <cmath>
 #include <iostream>
 #include <iomanip>
+#include <memory>
+#include <sstream>
+#include <tuple>
 #include <vector>
 #include <chrono>
 
@@ -322,6 +331,83 @@ void testLatencyVerification()
 
         processor.releaseResources();
     }
+
+    // Every quality tier must report its oversampling round-trip latency on
+    // top of the pitch shifter's (LowCpu adds none) and process cleanly.
+    // Render is reached the way hosts reach it: offline flag, then prepare.
+    using Tier = BlackheartAudioProcessor::QualityTier;
+
+    int baseLatency = 0;
+    for (const auto tier : { Tier::LowCpu, Tier::Efficient, Tier::Live, Tier::Render })
+    {
+        BlackheartAudioProcessor processor;
+        if (tier == Tier::Render)
+            processor.setNonRealtime(true);
+        else
+            processor.setLiveQuality(tier);
+        processor.prepareToPlay(48000.0, 256);
+
+        const auto config = processor.getOversamplingConfig();
+        const int latencySamples = processor.getLatencyInSamples();
+        if (tier == Tier::LowCpu)
+            baseLatency = latencySamples;
+
+        juce::AudioBuffer<float> buffer(2, 256);
+        juce::MidiBuffer midiBuffer;
+        bool clean = true;
+
+        for (int block = 0; block < 20 && clean; ++block)
+        {
+            fillWithSineWave(buffer, 196.0f, 48000.0);
+            processor.processBlock(buffer, midiBuffer);
+            clean = !hasNaN(buffer) && calculatePeak(buffer) < 5.0f;
+        }
+
+        std::stringstream name;
+        name << "Quality tier: " << config.factor << "x "
+             << (config.filter == DSP::Oversampler::FilterType::LinearPhaseFIR ? "FIR" : "IIR")
+             << (tier == Tier::Efficient ? " ADAA" : "");
+
+        // Efficient adds exactly the fuzz's one-sample antiderivative delay
+        const bool latencyOk = tier == Tier::Efficient ? latencySamples == baseLatency + 1
+                                                       : latencySamples >= baseLatency;
+        logTest(name.str(), clean && processor.getPreparedQuality() == tier && latencyOk,
+                std::to_string(latencySamples) + " samples latency");
+
+        processor.releaseResources();
+    }
+
+    // Changing the tier or the oversampling config of a prepared processor
+    // re-prepares it (normally from the message loop) with the new latency;
+    // an explicit config overrides the tier until it is reset
+    {
+        BlackheartAudioProcessor processor;
+        processor.prepareToPlay(48000.0, 256);
+        const int liveLatency = processor.getLatencyInSamples();
+
+        processor.setLiveQuality(Tier::LowCpu);
+        processor.applyPendingReconfiguration();
+        const bool tierApplied = processor.getPreparedQuality() == Tier::LowCpu
+                                 && processor.getOversamplingConfig().factor == 1
+                                 && processor.getLatencyInSamples() == baseLatency;
+
+        processor.setOversamplingConfig({ 4, DSP::Oversampler::FilterType::LinearPhaseFIR });
+        processor.applyPendingReconfiguration();
+        const auto overridden = processor.getOversamplingConfig();
+        const bool overrideApplied = overridden.factor == 4
+                                     && overridden.filter == DSP::Oversampler::FilterType::LinearPhaseFIR
+                                     && processor.getLatencyInSamples() > baseLatency;
+
+        processor.setLiveQuality(Tier::Live);
+        processor.resetOversamplingConfig();
+        processor.applyPendingReconfiguration();
+        const bool tierRestored = processor.getOversamplingConfig() == BlackheartAudioProcessor::getOversamplingConfigFor(Tier::Live)
+                                  && processor.getLatencyInSamples() == liveLatency;
+
+        logTest("Quality and oversampling changes re-prepare", tierApplied && overrideApplied && tierRestored,
+                std::to_string(liveLatency) + " -> " + std::to_string(baseLatency) + " samples (Low CPU)");
+        processor.releaseResources();
+    }
 }
 
 //==============================================================================
@@ -662,60 +748,1563 @@ void testInputSignalTypes()
 }
 
 //==============================================================================
-// Main Test Runner
+// Test 9: Analysis Bus
 //==============================================================================
 
-void runAllTests()
+void testAnalysisBus()
 {
-    std::cout << "╔══════════════════════════════════════════════════════════════╗" << std::endl;
-    std::cout << "║           BLACKHEART PLUGIN TEST SUITE                       ║" << std::endl;
-    std::cout << "╚══════════════════════════════════════════════════════════════╝" << std::endl;
+    std::cout << "\n=== Analysis Bus Tests ===" << std::endl;
 
-    auto startTime = std::chrono::high_resolution_clock::now();
+    const double sampleRate = 48000.0;
+    const int totalSamples = 48000;
 
-    testParameterStability();
-    testOctaveButtonBehavior();
-    testLatencyVerification();
-    testSampleRateCompatibility();
-    testBufferSizeCompatibility();
-    testStatePersistence();
-    testStressStability();
-    testInputSignalTypes();
+    // Frame rate must not depend on the host block size
+    juce::uint64 expectedFrames = 0;
+    bool blockSizeIndependent = true;
 
-    auto endTime = std::chrono::high_resolution_clock::now();
-    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(endTime - startTime);
+    for (int blockSize : { 37, 64, 480, 2048 })
+    {
+        BlackheartAudioProcessor processor;
+        processor.prepareToPlay(sampleRate, blockSize);
 
-    // Summary
-    int passed = 0, failed = 0;
-    for (const auto& result : testResults)
+        juce::AudioBuffer<float> buffer(2, blockSize);
+        juce::MidiBuffer midiBuffer;
+
+        for (int done = 0; done < totalSamples; done += blockSize)
+        {
+            fillWithSineWave(buffer, 220.0f, sampleRate);
+            processor.processBlock(buffer, midiBuffer);
+        }
+
+        const auto& bus = processor.getAnalysisBus();
+        const int processed = ((totalSamples + blockSize - 1) / blockSize) * blockSize;
+        const auto frames = bus.getNumFramesWritten() + bus.getNumDroppedFrames();
+        const auto expected = static_cast<juce::uint64>(processed / bus.getSamplesPerFrame());
+
+        if (frames != expected)
+            blockSizeIndependent = false;
+        if (blockSize == 480)
+            expectedFrames = expected;
+    }
+
+    logTest("Analysis frames at fixed rate", blockSizeIndependent && expectedFrames > 0,
+            std::to_string(expectedFrames) + " frames per second of audio");
+
+    // A stalled consumer drops new frames and counts them
     {
-        if (result.passed) passed++;
-        else failed++;
+        BlackheartAudioProcessor processor;
+        processor.prepareToPlay(sampleRate, 512);
+
+        juce::AudioBuffer<float> buffer(2, 512);
+        juce::MidiBuffer midiBuffer;
+
+        for (int block = 0; block < 400; ++block)
+        {
+            fillWithSineWave(buffer, 220.0f, sampleRate);
+            processor.processBlock(buffer, midiBuffer);
+        }
+
+        auto& bus = processor.getAnalysisBus();
+        const bool full = bus.getNumReady() == DSP::AnalysisBus::capacity;
+        const bool counted = bus.getNumDroppedFrames() > 0
+                             && bus.getNumFramesWritten() == static_cast<juce::uint64>(DSP::AnalysisBus::capacity);
+
+        logTest("Analysis overrun counted", full && counted,
+                "dropped " + std::to_string(bus.getNumDroppedFrames()));
+
+        // Draining restores space and the probes carry signal
+        std::vector<DSP::AnalysisBus::Frame> frames(static_cast<size_t>(DSP::AnalysisBus::capacity));
+        const int numRead = bus.read(frames.data(), static_cast<int>(frames.size()));
+
+        float inputPeak = 0.0f, outputPeak = 0.0f;
+        bool ordered = true;
+        for (int i = 0; i < numRead; ++i)
+        {
+            const auto& frame = frames[static_cast<size_t>(i)];
+            for (int p = 0; p < DSP::AnalysisBus::numProbes; ++p)
+                ordered = ordered && frame.minimum[static_cast<size_t>(p)] <= frame.maximum[static_cast<size_t>(p)];
+
+            inputPeak = std::max(inputPeak, frame.maximum[DSP::AnalysisBus::input]);
+            outputPeak = std::max(outputPeak, std::abs(frame.minimum[DSP::AnalysisBus::output]));
+        }
+
+        logTest("Analysis frames drained", numRead == DSP::AnalysisBus::capacity && bus.getNumReady() == 0,
+                std::to_string(numRead) + " frames");
+        logTest("Analysis probes carry signal", ordered && std::abs(inputPeak - 0.5f) < 0.01f && outputPeak > 0.01f,
+                "input peak " + std::to_string(inputPeak) + ", output peak " + std::to_string(outputPeak));
+
+        processor.releaseResources();
     }
+}
 
-    std::cout << "\n╔══════════════════════════════════════════════════════════════╗" << std::endl;
-    std::cout << "║                      TEST SUMMARY                            ║" << std::endl;
-    std::cout << "╚══════════════════════════════════════════════════════════════╝" << std::endl;
-    std::cout << "Total tests: " << testResults.size() << std::endl;
-    std::cout << "Passed: " << passed << std::endl;
-    std::cout << "Failed: " << failed << std::endl;
-    std::cout << "Duration: " << duration.count() << " ms" << std::endl;
-    std::cout << "Result: " << (failed == 0 ? "ALL TESTS PASSED ✓" : "SOME TESTS FAILED ✗") << std::endl;
+//==============================================================================
+// Test 10: Sub-Block Automation
+//==============================================================================
 
-    if (failed > 0)
+void testSubBlockAutomation()
+{
+    std::cout << "\n=== Sub-Block Automation Tests ===" << std::endl;
+
+    const double sampleRate = 48000.0;
+    const int hostBlock = 2048;
+    const int subBlock = BlackheartAudioProcessor::automationSubBlockSize;
+    const int numBlocks = 24;
+
+    // Large host blocks in SubBlock mode must render exactly what the chain
+    // produces when the host itself calls with sub-block-sized buffers
+    auto render = [&](int callSize, BlackheartAudioProcessor::AutomationMode mode)
     {
-        std::cout << "\nFailed tests:" << std::endl;
-        for (const auto& result : testResults)
+        BlackheartAudioProcessor processor;
+        processor.setRandomSeed(0x5eed);
+        processor.setAutomationMode(mode);
+        processor.prepareToPlay(sampleRate, hostBlock);
+
+        juce::AudioBuffer<float> input(2, hostBlock * numBlocks);
+        fillWithSineWave(input, 110.0f, sampleRate);
+
+        juce::AudioBuffer<float> buffer(2, callSize);
+        juce::MidiBuffer midiBuffer;
+
+        for (int offset = 0; offset < input.getNumSamples(); offset += callSize)
         {
-            if (!result.passed)
+            // Automation lands on host-block boundaries in both renders
+            if (offset % (hostBlock * 4) == 0)
             {
-                std::cout << "  - " << result.name;
-                if (!result.details.empty())
-                    std::cout << ": " << result.details;
-                std::cout << std::endl;
+                const bool on = (offset / (hostBlock * 4)) % 2 == 0;
+                processor.setOctave1(on);
+                if (auto* p = processor.getAPVTS().getParameter("panic"))
+                    p->setValueNotifyingHost(on ? 0.8f : 0.2f);
+            }
+
+            for (int ch = 0; ch < 2; ++ch)
+                buffer.copyFrom(ch, 0, input, ch, offset, callSize);
+            processor.processBlock(buffer, midiBuffer);
+            for (int ch = 0; ch < 2; ++ch)
+                input.copyFrom(ch, offset, buffer, ch, 0, callSize);
+        }
+
+        return input;
+    };
+
+    const auto split = render(hostBlock, BlackheartAudioProcessor::AutomationMode::SubBlock);
+    const auto small = render(subBlock, BlackheartAudioProcessor::AutomationMode::Block);
+
+    float maxDiff = 0.0f;
+    for (int ch = 0; ch < 2; ++ch)
+        for (int i = 0; i < split.getNumSamples(); ++i)
+            maxDiff = std::max(maxDiff, std::abs(split.getSample(ch, i) - small.getSample(ch, i)));
+
+    logTest("Sub-block render matches small host blocks", maxDiff < 1.0e-6f && !hasNaN(split),
+            "max diff " + std::to_string(maxDiff));
+
+    // Mode survives a state round trip
+    BlackheartAudioProcessor source;
+    source.setAutomationMode(BlackheartAudioProcessor::AutomationMode::SubBlock);
+    juce::MemoryBlock state;
+    source.getStateInformation(state);
+
+    BlackheartAudioProcessor restored;
+    restored.setStateInformation(state.getData(), static_cast<int>(state.getSize()));
+    logTest("Automation mode restored",
+            restored.getAutomationMode() == BlackheartAudioProcessor::AutomationMode::SubBlock);
+}
+
+//==============================================================================
+// Test 11: MIDI Octave Timing
+//==============================================================================
+
+void testMidiOctaveTiming()
+{
+    std::cout << "\n=== MIDI Octave Timing Tests ===" << std::endl;
+
+    const double sampleRate = 48000.0;
+    const int blockSize = 512;
+    const int numBlocks = 24;
+    const int noteOnAt = 4 * blockSize + 300;
+    const int noteOffAt = 12 * blockSize + 77;
+
+    juce::AudioBuffer<float> input(2, blockSize * numBlocks);
+    fillWithSineWave(input, 110.0f, sampleRate);
+
+    auto makeProcessor = [&]()
+    {
+        auto processor = std::make_unique<BlackheartAudioProcessor>();
+        processor->setRandomSeed(0x5eed);
+        processor->prepareToPlay(sampleRate, blockSize);
+        return processor;
+    };
+
+    // Note on/off inside 512-sample blocks
+    auto renderViaMidi = [&](BlackheartAudioProcessor& processor, int note)
+    {
+        juce::AudioBuffer<float> output(input);
+        juce::AudioBuffer<float> buffer(2, blockSize);
+
+        for (int offset = 0; offset < output.getNumSamples(); offset += blockSize)
+        {
+            juce::MidiBuffer midi;
+            if (noteOnAt >= offset && noteOnAt < offset + blockSize)
+                midi.addEvent(juce::MidiMessage::noteOn(1, note, 0.8f), noteOnAt - offset);
+            if (noteOffAt >= offset && noteOffAt < offset + blockSize)
+                midi.addEvent(juce::MidiMessage::noteOff(1, note), noteOffAt - offset);
+            midi.addEvent(juce::MidiMessage::controllerEvent(1, 74, 64), 10);    // Unmapped: no split
+
+            for (int ch = 0; ch < 2; ++ch)
+                buffer.copyFrom(ch, 0, output, ch, offset, blockSize);
+            processor.processBlock(buffer, midi);
+            for (int ch = 0; ch < 2; ++ch)
+                output.copyFrom(ch, offset, buffer, ch, 0, blockSize);
+        }
+        return output;
+    };
+
+    auto maxDifference = [&](const juce::AudioBuffer<float>& a, const juce::AudioBuffer<float>& b)
+    {
+        float diff = 0.0f;
+        for (int ch = 0; ch < 2; ++ch)
+            for (int i = 0; i < input.getNumSamples(); ++i)
+                diff = std::max(diff, std::abs(a.getSample(ch, i) - b.getSample(ch, i)));
+        return diff;
+    };
+
+    juce::AudioBuffer<float> viaMidi;
+    {
+        auto processor = makeProcessor();
+        viaMidi = renderViaMidi(*processor, processor->getMidiAssignments().octaveOneNote);
+    }
+
+    // Reference: the host splits its buffers at the same samples and
+    // toggles the octave button there
+    juce::AudioBuffer<float> viaSplit(input);
+    {
+        auto processor = makeProcessor();
+        juce::MidiBuffer midi;
+        std::vector<int> edges;
+        for (int offset = 0; offset <= viaSplit.getNumSamples(); offset += blockSize)
+            edges.push_back(offset);
+        edges.push_back(noteOnAt);
+        edges.push_back(noteOffAt);
+        std::sort(edges.begin(), edges.end());
+
+        for (size_t e = 0; e + 1 < edges.size(); ++e)
+        {
+            const int start = edges[e];
+            const int length = edges[e + 1] - start;
+            if (start == noteOnAt)
+                processor->setOctave1(true);
+            if (start == noteOffAt)
+                processor->setOctave1(false);
+
+            juce::AudioBuffer<float> buffer(2, length);
+            for (int ch = 0; ch < 2; ++ch)
+                buffer.copyFrom(ch, 0, viaSplit, ch, start, length);
+            processor->processBlock(buffer, midi);
+            for (int ch = 0; ch < 2; ++ch)
+                viaSplit.copyFrom(ch, start, buffer, ch, 0, length);
+        }
+    }
+
+    const float maxDiff = maxDifference(viaMidi, viaSplit);
+    logTest("MIDI octave lands on its sample", maxDiff < 1.0e-6f && !hasNaN(viaMidi),
+            "max diff " + std::to_string(maxDiff));
+
+    // Assignments set on a prepared processor, as setStateInformation does,
+    // take over once the message loop runs, not at the host's next prepare
+    {
+        auto processor = makeProcessor();
+        auto remapped = processor->getMidiAssignments();
+        remapped.octaveOneNote = 48;
+        processor->setMidiAssignments(remapped);
+        processor->applyPendingReconfiguration();
+
+        const float remapDiff = maxDifference(renderViaMidi(*processor, 48), viaMidi);
+        logTest("MIDI assignments apply while prepared", remapDiff < 1.0e-6f,
+                "max diff " + std::to_string(remapDiff));
+    }
+
+    // The mapping itself
+    const MidiMapping::Assignments assignments;
+    const auto panic = MidiMapping::map(juce::MidiMessage::controllerEvent(1, assignments.panicController, 127), assignments);
+    const auto mode = MidiMapping::map(juce::MidiMessage::controllerEvent(1, assignments.modeController, 64), assignments);
+    const auto other = MidiMapping::map(juce::MidiMessage::noteOn(1, 30, 1.0f), assignments);
+    logTest("MIDI mapping targets",
+            panic.target == MidiMapping::Target::panic && std::abs(panic.value - 1.0f) < 1.0e-6f
+            && mode.target == MidiMapping::Target::mode && static_cast<int>(mode.value) == 1
+            && other.target == MidiMapping::Target::none);
+}
+
+//==============================================================================
+// Test 12: Multi-Channel Processing
+//==============================================================================
+
+void testMultiChannelProcessing()
+{
+    std::cout << "\n=== Multi-Channel Processing Tests ===" << std::endl;
+
+    const double sampleRate = 48000.0;
+    const int blockSize = 512;
+    const int numBlocks = 32;
+
+    // Same signal on every channel: linked detectors see the same level at
+    // any width, so each channel of a 4-channel render must equal the
+    // stereo render — channels past the pair can't fall through untouched
+    auto render = [&](int numChannels, bool& layoutAccepted)
+    {
+        BlackheartAudioProcessor processor;
+        processor.setRandomSeed(0x5eed);
+
+        auto layout = processor.getBusesLayout();
+        layout.inputBuses.getReference(0) = juce::AudioChannelSet::discreteChannels(numChannels);
+        layout.outputBuses.getReference(0) = juce::AudioChannelSet::discreteChannels(numChannels);
+        layoutAccepted = processor.setBusesLayout(layout);
+
+        processor.prepareToPlay(sampleRate, blockSize);
+        if (auto* p = processor.getAPVTS().getParameter("panic"))
+            p->setValueNotifyingHost(0.6f);
+        if (auto* p = processor.getAPVTS().getParameter("chaos"))
+            p->setValueNotifyingHost(0.5f);
+
+        juce::AudioBuffer<float> output(numChannels, blockSize * numBlocks);
+        juce::AudioBuffer<float> mono(1, output.getNumSamples());
+        fillWithSineWave(mono, 98.0f, sampleRate);
+        for (int ch = 0; ch < numChannels; ++ch)
+            output.copyFrom(ch, 0, mono, 0, 0, output.getNumSamples());
+
+        juce::AudioBuffer<float> buffer(numChannels, blockSize);
+        juce::MidiBuffer midiBuffer;
+
+        for (int offset = 0; offset < output.getNumSamples(); offset += blockSize)
+        {
+            // Octave held for the middle half: shifter, feedback and PANIC heads
+            processor.setOctave1(offset >= blockSize * 8 && offset < blockSize * 24);
+
+            for (int ch = 0; ch < numChannels; ++ch)
+                buffer.copyFrom(ch, 0, output, ch, offset, blockSize);
+            processor.processBlock(buffer, midiBuffer);
+            for (int ch = 0; ch < numChannels; ++ch)
+                output.copyFrom(ch, offset, buffer, ch, 0, blockSize);
+        }
+
+        return output;
+    };
+
+    bool stereoAccepted = false, quadAccepted = false;
+    const auto stereo = render(2, stereoAccepted);
+    const auto quad = render(4, quadAccepted);
+
+    logTest("4-channel layout accepted", stereoAccepted && quadAccepted);
+
+    float maxDiff = 0.0f;
+    for (int ch = 0; ch < quad.getNumChannels(); ++ch)
+        for (int i = 0; i < quad.getNumSamples(); ++i)
+            maxDiff = std::max(maxDiff, std::abs(quad.getSample(ch, i) - stereo.getSample(ch % 2, i)));
+
+    logTest("Every channel of a 4-channel render is processed", maxDiff < 1.0e-6f && !hasNaN(quad),
+            "max diff " + std::to_string(maxDiff));
+}
+
+//==============================================================================
+// Test 13: Linked Dynamics
+//==============================================================================
+
+void testLinkedDynamics()
+{
+    std::cout << "\n=== Linked Dynamics Tests ===" << std::endl;
+
+    const double sampleRate = 48000.0;
+    const int blockSize = 512;
+    const juce::dsp::ProcessSpec spec { sampleRate, static_cast<juce::uint32>(blockSize), 3 };
+
+    // Limiter: hot, quiet and a copy of the hot channel. One linked gain
+    // pulls the quiet channel down with the hot one, and equal inputs must
+    // come out bit-identical.
+    DSP::OutputLimiter limiter;
+    limiter.prepare(spec);
+
+    juce::AudioBuffer<float> buffer(3, blockSize);
+    float peakHot = 0.0f, peakQuiet = 0.0f;
+    bool copiesMatch = true;
+
+    for (int block = 0; block < 40; ++block)
+    {
+        for (int i = 0; i < blockSize; ++i)
+        {
+            const float phase = static_cast<float>((block * blockSize + i) * 2.0 * juce::MathConstants<double>::pi * 220.0 / sampleRate);
+            buffer.setSample(0, i, 1.5f * std::sin(phase));
+            buffer.setSample(1, i, 0.1f * std::sin(phase));
+            buffer.setSample(2, i, 1.5f * std::sin(phase));
+        }
+
+        limiter.process(buffer);
+
+        for (int i = 0; i < blockSize; ++i)
+            copiesMatch = copiesMatch && buffer.getSample(0, i) == buffer.getSample(2, i);
+
+        if (block >= 20)
+        {
+            peakHot = std::max(peakHot, buffer.getMagnitude(0, 0, blockSize));
+            peakQuiet = std::max(peakQuiet, buffer.getMagnitude(1, 0, blockSize));
+        }
+    }
+
+    const float ceiling = juce::Decibels::decibelsToGain(limiter.getCeilingDb());
+    logTest("Limiter holds the ceiling", peakHot <= ceiling + 1.0e-6f,
+            "peak " + std::to_string(peakHot));
+    logTest("Limiter gain is linked across channels", peakQuiet < 0.1f * 0.8f && limiter.getGainReduction() > 0.2f,
+            "quiet peak " + std::to_string(peakQuiet));
+    logTest("Limiter channels with equal input match", copiesMatch);
+
+    // Gate: opens on a loud signal, closes on near-silence
+    DSP::DynamicGate gate;
+    gate.prepare(spec);
+
+    auto runGate = [&](float amplitude)
+    {
+        for (int block = 0; block < 40; ++block)
+        {
+            for (int ch = 0; ch < 3; ++ch)
+                for (int i = 0; i < blockSize; ++i)
+                    buffer.setSample(ch, i, amplitude * std::sin(static_cast<float>(i) * 0.05f));
+            gate.process(buffer);
+        }
+        return gate.getCurrentGateGain();
+    };
+
+    const float openGain = runGate(0.5f);
+    const float closedGain = runGate(0.0005f);
+    logTest("Gate opens and closes", openGain > 0.99f && closedGain < 0.3f,
+            "open " + std::to_string(openGain) + ", closed " + std::to_string(closedGain));
+}
+
+//==============================================================================
+// Test 14: Look-Ahead True-Peak Limiter
+//==============================================================================
+
+void testLookaheadLimiter()
+{
+    std::cout << "\n=== Look-Ahead Limiter Tests ===" << std::endl;
+
+    const double sampleRate = 48000.0;
+    const int blockSize = 256;
+    const juce::dsp::ProcessSpec spec { sampleRate, static_cast<juce::uint32>(blockSize), 2 };
+
+    // 8x band-limited reconstruction (64-tap Hann-windowed sinc), independent
+    // of the limiter's own 4x detector
+    auto truePeak = [](const float* data, int numSamples)
+    {
+        constexpr int halfTaps = 32;
+        constexpr int phases = 8;
+        float peak = 0.0f;
+        for (int n = halfTaps; n < numSamples - halfTaps; ++n)
+        {
+            for (int phase = 0; phase < phases; ++phase)
+            {
+                const double frac = static_cast<double>(phase) / phases;
+                double acc = 0.0;
+                for (int j = -halfTaps + 1; j <= halfTaps; ++j)
+                {
+                    const double x = frac - j;
+                    const double sinc = std::abs(x) < 1.0e-9 ? 1.0 : std::sin(juce::MathConstants<double>::pi * x) / (juce::MathConstants<double>::pi * x);
+                    const double window = 0.5 + 0.5 * std::cos(juce::MathConstants<double>::pi * x / halfTaps);
+                    acc += data[n + j] * sinc * window;
+                }
+                peak = std::max(peak, static_cast<float>(std::abs(acc)));
             }
         }
+        return peak;
+    };
+
+    // Quarter-rate sine sampled 45 degrees off its crests: every sample sits
+    // 3dB under the true peak, plus a hot burst every 100ms
+    DSP::OutputLimiter limiter;
+    limiter.setLookahead(2.0f);
+    limiter.prepare(spec);
+
+    const int numBlocks = 80;
+    juce::AudioBuffer<float> rendered(2, numBlocks * blockSize);
+    juce::AudioBuffer<float> buffer(2, blockSize);
+
+    for (int block = 0; block < numBlocks; ++block)
+    {
+        for (int i = 0; i < blockSize; ++i)
+        {
+            const int n = block * blockSize + i;
+            const float burst = (n % 4800) < 480 ? 2.0f : 1.2f;
+            const float phase = static_cast<float>(juce::MathConstants<double>::pi * (0.5 * n + 0.25));
+            buffer.setSample(0, i, burst * std::sin(phase));
+            buffer.setSample(1, i, 0.5f * burst * std::sin(phase));
+        }
+
+        limiter.process(buffer);
+        for (int ch = 0; ch < 2; ++ch)
+            rendered.copyFrom(ch, block * blockSize, buffer, ch, 0, blockSize);
+    }
+
+    const float ceiling = juce::Decibels::decibelsToGain(limiter.getCeilingDb());
+    const int settled = 20 * blockSize;
+    const float outputTruePeak = truePeak(rendered.getReadPointer(0) + settled, rendered.getNumSamples() - settled);
+    logTest("Look-ahead output true peak holds the ceiling", outputTruePeak <= ceiling && !hasNaN(rendered),
+            "true peak " + std::to_string(outputTruePeak) + ", ceiling " + std::to_string(ceiling));
+
+    // 0.4 fs tone phased so the detector's points straddle its crests: the
+    // worst case for the 4x reading, which the limiter's margin covers
+    limiter.prepare(spec);
+    for (int block = 0; block < numBlocks; ++block)
+    {
+        for (int i = 0; i < blockSize; ++i)
+        {
+            const int n = block * blockSize + i;
+            const float phase = static_cast<float>(juce::MathConstants<double>::twoPi * (0.4 * n + 0.0625));
+            buffer.setSample(0, i, 1.5f * std::sin(phase));
+            buffer.setSample(1, i, buffer.getSample(0, i));
+        }
+
+        limiter.process(buffer);
+        for (int ch = 0; ch < 2; ++ch)
+            rendered.copyFrom(ch, block * blockSize, buffer, ch, 0, blockSize);
     }
+
+    const float nyquistTruePeak = truePeak(rendered.getReadPointer(0) + settled, rendered.getNumSamples() - settled);
+    logTest("Look-ahead ceiling holds near Nyquist", nyquistTruePeak <= ceiling && !hasNaN(rendered),
+            "true peak " + std::to_string(nyquistTruePeak) + ", ceiling " + std::to_string(ceiling));
+
+    // A quiet click passes at unity, exactly the reported latency late
+    limiter.setLookahead(1.0f);
+    limiter.prepare(spec);
+    buffer.clear();
+    buffer.setSample(0, 0, 0.25f);
+    buffer.setSample(1, 0, 0.25f);
+    limiter.process(buffer);
+
+    int arrival = 0;
+    for (int i = 1; i < blockSize; ++i)
+        if (std::abs(buffer.getSample(0, i)) > std::abs(buffer.getSample(0, arrival)))
+            arrival = i;
+
+    const int expectedDelay = juce::roundToInt(0.001 * sampleRate);
+    logTest("Look-ahead delay matches reported latency",
+            limiter.getLatencySamples() == expectedDelay && arrival == expectedDelay
+                && std::abs(buffer.getSample(0, arrival) - 0.25f) < 0.001f,
+            std::to_string(arrival) + " samples, reported " + std::to_string(limiter.getLatencySamples()));
+
+    // The processor adds the look-ahead to the latency it reports. Turning
+    // it on after prepare re-prepares (normally from the message loop) and
+    // tells the host
+    BlackheartAudioProcessor processor;
+    processor.prepareToPlay(sampleRate, blockSize);
+    const int baseLatency = processor.getLatencyInSamples();
+    processor.setLimiterLookahead(5.0f);
+    processor.applyPendingReconfiguration();
+    const int lookaheadLatency = processor.getLatencyInSamples();
+    const bool hostLatencyUpdated = processor.getLatencySamples() == lookaheadLatency;
+
+    // prepareToPlay sets a -0.3dB ceiling
+    const float processorCeiling = juce::Decibels::decibelsToGain(-0.3f);
+    juce::MidiBuffer midiBuffer;
+    juce::AudioBuffer<float> block(2, blockSize);
+    bool clean = true;
+    for (int i = 0; i < 40 && clean; ++i)
+    {
+        fillWithSineWave(block, 110.0f, sampleRate);
+        processor.processBlock(block, midiBuffer);
+        clean = !hasNaN(block) && calculatePeak(block) <= processorCeiling + 1.0e-6f;
+    }
+
+    logTest("Processor reports look-ahead latency",
+            lookaheadLatency == baseLatency + juce::roundToInt(0.005 * sampleRate) && hostLatencyUpdated && clean,
+            std::to_string(baseLatency) + " -> " + std::to_string(lookaheadLatency) + " samples");
+    processor.releaseResources();
+}
+
+//==============================================================================
+// Test 15: Math Kernels
+//==============================================================================
+
+void testMathKernels()
+{
+    std::cout << "\n=== Math Kernel Tests ===" << std::endl;
+
+    using namespace DSP::MathKernels;
+    constexpr double twoPi = 2.0 * juce::MathConstants<double>::pi;
+
+    // Max error of a kernel over a dense sweep of [lo, hi]; the batched form
+    // must match the scalar one exactly
+    auto measure = [](auto kernel, double (*reference)(double), float lo, float hi, bool relative, bool& batchMatches)
+    {
+        constexpr int numPoints = 1 << 16;
+        std::vector<float> input(numPoints), output(numPoints);
+        for (int i = 0; i < numPoints; ++i)
+            input[static_cast<size_t>(i)] = lo + (hi - lo) * static_cast<float>(i) / static_cast<float>(numPoints - 1);
+
+        decltype(kernel)::process(input.data(), output.data(), numPoints);
+
+        double maxError = 0.0;
+        for (int i = 0; i < numPoints; ++i)
+        {
+            const float x = input[static_cast<size_t>(i)];
+            const double expected = reference(x);
+            double error = std::abs(static_cast<double>(output[static_cast<size_t>(i)]) - expected);
+            if (relative)
+                error /= std::max(std::abs(expected), 1.0e-30);
+            maxError = std::max(maxError, error);
+            batchMatches = batchMatches && output[static_cast<size_t>(i)] == decltype(kernel)::evaluate(x);
+        }
+        return maxError;
+    };
+
+    struct Bound
+    {
+        const char* name;
+        double error;
+        double limit;
+    };
+
+    bool batchMatches = true;
+    auto sine = [](double p) { return std::sin(twoPi * p); };
+    auto cosine = [](double p) { return std::cos(twoPi * p); };
+    auto exponential = [](double x) { return std::exp(x); };
+    auto hyperbolicTangent = [](double x) { return std::tanh(x); };
+
+    // Limits are the documented bounds in MathKernels.h
+    const Bound bounds[] = {
+        { "Sine (fast)",    measure(Sine<Tier::Fast>(), sine, -3.0f, 3.0f, false, batchMatches), 1.5e-4 },
+        { "Sine (precise)", measure(Sine<Tier::Precise>(), sine, -3.0f, 3.0f, false, batchMatches), 2.5e-7 },
+        { "Cosine (fast)",    measure(Cosine<Tier::Fast>(), cosine, -3.0f, 3.0f, false, batchMatches), 1.5e-4 },
+        { "Cosine (precise)", measure(Cosine<Tier::Precise>(), cosine, -3.0f, 3.0f, false, batchMatches), 2.5e-7 },
+        { "Exp (fast)",    measure(Exp<Tier::Fast>(), exponential, -87.0f, 88.0f, true, batchMatches), 1.1e-4 },
+        { "Exp (precise)", measure(Exp<Tier::Precise>(), exponential, -87.0f, 88.0f, true, batchMatches), 3.0e-7 },
+        { "Tanh (fast)",    measure(Tanh<Tier::Fast>(), hyperbolicTangent, -10.0f, 10.0f, false, batchMatches), 5.5e-5 },
+        { "Tanh (precise)", measure(Tanh<Tier::Precise>(), hyperbolicTangent, -10.0f, 10.0f, false, batchMatches), 2.0e-7 },
+    };
+
+    for (const auto& bound : bounds)
+    {
+        std::stringstream details;
+        details << std::scientific << std::setprecision(2) << "max error " << bound.error << " (bound " << bound.limit << ")";
+        logTest(std::string(bound.name) + " within its error bound", bound.error <= bound.limit, details.str());
+    }
+
+    logTest("Batched kernels match scalar evaluation", batchMatches);
+
+    // The compile-time lookup tables need no initialisation before use
+    double tableError = 0.0;
+    for (int i = 0; i <= 1000; ++i)
+    {
+        const float phase = static_cast<float>(i) / 1000.0f;
+        const float x = 8.0f * phase - 4.0f;
+        tableError = std::max(tableError, std::abs(DSP::LookupTables::fastSin(phase) - std::sin(twoPi * phase)));
+        tableError = std::max(tableError, std::abs(DSP::LookupTables::fastCos(phase) - std::cos(twoPi * phase)));
+        tableError = std::max(tableError, std::abs(DSP::LookupTables::fastTanh(x) - std::tanh(static_cast<double>(x))));
+        tableError = std::max(tableError, std::abs(DSP::LookupTables::fastExpDecay(-8.0f * phase) - std::exp(-8.0 * phase)));
+    }
+    logTest("Lookup tables are ready at compile time", tableError < 1.0e-6,
+            "max error " + std::to_string(tableError));
+}
+
+//==============================================================================
+// Test 16: Buffer Routing
+//==============================================================================
+
+void testBufferRouting()
+{
+    std::cout << "\n=== Buffer Routing Tests ===" << std::endl;
+
+    const double sampleRate = 48000.0;
+    const int blockSize = 512;
+    const juce::dsp::ProcessSpec spec { sampleRate, static_cast<juce::uint32>(blockSize), 2 };
+
+    auto fillSine = [&](juce::AudioBuffer<float>& buffer, int block)
+    {
+        for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+            for (int i = 0; i < blockSize; ++i)
+            {
+                const double t = static_cast<double>(block * blockSize + i) / sampleRate;
+                buffer.setSample(ch, i, 0.4f * static_cast<float>(std::sin(2.0 * juce::MathConstants<double>::pi * 220.0 * t + ch)));
+            }
+    };
+
+    // Chaos Mix inside the shifter: a fully wet shifter and one ramping the
+    // mix 0 -> 1 over each block, fed the same input, must differ exactly by
+    // the crossfade the processor used to apply from a pre-pitch copy
+    DSP::PitchShifter wetShifter, mixedShifter;
+    for (auto* shifter : { &wetShifter, &mixedShifter })
+    {
+        shifter->prepare(spec);
+        shifter->setSeed(7);
+        shifter->setRiseTime(1.0f);
+        shifter->setOctaveOneActive(true);
+    }
+
+    std::vector<float> mixRamp(static_cast<size_t>(blockSize));
+    for (int i = 0; i < blockSize; ++i)
+        mixRamp[static_cast<size_t>(i)] = static_cast<float>(i) / static_cast<float>(blockSize - 1);
+
+    juce::AudioBuffer<float> input(2, blockSize), wet(2, blockSize), mixed(2, blockSize);
+    float maxMixError = 0.0f;
+
+    for (int block = 0; block < 16; ++block)
+    {
+        fillSine(input, block);
+        wet.makeCopyOf(input);
+        mixed.makeCopyOf(input);
+
+        mixedShifter.setChaosMixRamp({ mixRamp.data(), 1.0f, blockSize });
+        wetShifter.process(wet);
+        mixedShifter.process(mixed);
+
+        for (int ch = 0; ch < 2; ++ch)
+            for (int i = 0; i < blockSize; ++i)
+            {
+                const float dry = input.getSample(ch, i);
+                const float expected = dry + mixRamp[static_cast<size_t>(i)] * (wet.getSample(ch, i) - dry);
+                maxMixError = std::max(maxMixError, std::abs(mixed.getSample(ch, i) - expected));
+            }
+    }
+
+    logTest("Chaos Mix ramp applied inside the pitch shifter", maxMixError < 1.0e-6f,
+            "max error " + std::to_string(maxMixError));
+
+    // Static mix of 0 leaves the engaged shifter's input untouched
+    mixedShifter.setChaosMixRamp(DSP::RampBlock::constant(0.0f));
+    fillSine(input, 16);
+    mixed.makeCopyOf(input);
+    mixedShifter.process(mixed);
+
+    bool dryPassesThrough = true;
+    for (int ch = 0; ch < 2; ++ch)
+        for (int i = 0; i < blockSize; ++i)
+            dryPassesThrough = dryPassesThrough && mixed.getSample(ch, i) == input.getSample(ch, i);
+    logTest("Chaos Mix at 0 passes the shifter input", dryPassesThrough);
+
+    // In-place blend matches the equal-power mix of the two inputs
+    DSP::BlendMixer blendMixer;
+    blendMixer.prepare(spec);
+    blendMixer.setBlend(0.35f);
+
+    juce::AudioBuffer<float> dryPath(2, blockSize);
+    fillSine(dryPath, 0);
+    fillSine(wet, 3);
+    input.makeCopyOf(wet);
+    blendMixer.process(dryPath, wet);
+
+    float maxBlendError = 0.0f;
+    for (int ch = 0; ch < 2; ++ch)
+        for (int i = 0; i < blockSize; ++i)
+        {
+            const float expected = dryPath.getSample(ch, i) * blendMixer.getDryGain()
+                                   + input.getSample(ch, i) * blendMixer.getWetGain();
+            maxBlendError = std::max(maxBlendError, std::abs(wet.getSample(ch, i) - expected));
+        }
+    logTest("Blend mixes in place", maxBlendError < 1.0e-6f, "max error " + std::to_string(maxBlendError));
+}
+
+//==============================================================================
+// Test 17: Antiderivative Shaping
+//==============================================================================
+
+void testAntiderivativeShaping()
+{
+    std::cout << "\n=== Antiderivative Shaping Tests ===" << std::endl;
+
+    const double sampleRate = 48000.0;
+    const int blockSize = 256;
+    const juce::dsp::ProcessSpec spec { sampleRate, static_cast<juce::uint32>(blockSize), 2 };
+
+    // Fuzz engine at 1x on a steady tone, after a second of settling
+    auto renderTone = [&](bool antiderivative, int mode, double hz, int numSamples)
+    {
+        DSP::FuzzEngine fuzz;
+        fuzz.setAntiderivativeShaping(antiderivative);
+        fuzz.prepare(spec);
+        fuzz.setMode(mode);
+        fuzz.setGain(0.8f);
+
+        const int settleSamples = static_cast<int>(sampleRate);
+        std::vector<float> output;
+        juce::AudioBuffer<float> buffer(2, blockSize);
+
+        for (int position = 0; static_cast<int>(output.size()) < numSamples; position += blockSize)
+        {
+            for (int i = 0; i < blockSize; ++i)
+            {
+                const double phase = 2.0 * juce::MathConstants<double>::pi * hz * (position + i) / sampleRate;
+                buffer.setSample(0, i, 0.5f * static_cast<float>(std::sin(phase)));
+                buffer.setSample(1, i, buffer.getSample(0, i));
+            }
+
+            juce::dsp::AudioBlock<float> block(buffer);
+            fuzz.process(block);
+
+            for (int i = 0; i < blockSize && static_cast<int>(output.size()) < numSamples; ++i)
+                if (position + i >= settleSamples)
+                    output.push_back(buffer.getSample(0, i));
+        }
+        return output;
+    };
+
+    // Aliasing of a 2.5kHz tone, every mode
+    constexpr int captureSamples = 1 << 14;
+    const int bin = TestSignals::coherentToneBin(sampleRate, 2500.0, captureSamples);
+    const double toneHz = bin * sampleRate / captureSamples;
+
+    for (int mode = 0; mode < 3; ++mode)
+    {
+        const auto direct = renderTone(false, mode, toneHz, captureSamples);
+        const auto shaped = renderTone(true, mode, toneHz, captureSamples);
+        const double directDb = TestSignals::measureAliasingDb(direct.data(), captureSamples, bin);
+        const double shapedDb = TestSignals::measureAliasingDb(shaped.data(), captureSamples, bin);
+
+        float peak = 0.0f;
+        bool finite = true;
+        for (float sample : shaped)
+        {
+            peak = std::max(peak, std::abs(sample));
+            finite = finite && std::isfinite(sample);
+        }
+
+        std::stringstream details;
+        details << std::fixed << std::setprecision(1) << directDb << " dB -> " << shapedDb << " dB";
+        logTest("ADAA lowers aliasing, mode " + std::to_string(mode),
+                finite && peak <= 1.2f && shapedDb < directDb - 6.0, details.str());
+    }
+
+    // The two half-sample stages line up with the direct path one sample late
+    const auto direct = renderTone(false, DSP::FuzzEngine::ModeOverdrive, 110.0, 4096);
+    const auto shaped = renderTone(true, DSP::FuzzEngine::ModeOverdrive, 110.0, 4096);
+
+    int bestLag = -1;
+    double bestError = 0.0;
+    for (int lag = 0; lag <= 3; ++lag)
+    {
+        double error = 0.0;
+        for (int i = 8; i < 4096; ++i)
+            error += std::pow(shaped[static_cast<size_t>(i)] - direct[static_cast<size_t>(i - lag)], 2.0);
+        if (bestLag < 0 || error < bestError)
+        {
+            bestLag = lag;
+            bestError = error;
+        }
+    }
+
+    DSP::FuzzEngine latencyProbe;
+    latencyProbe.setAntiderivativeShaping(true);
+    logTest("ADAA delay matches reported latency", bestLag == latencyProbe.getLatencySamples(),
+            "best lag " + std::to_string(bestLag));
+
+    // Drive ramping through the block re-evaluates the previous input per
+    // sample: no steps beyond what the direct path itself produces
+    auto largestStepUnderRamp = [&](bool antiderivative)
+    {
+        DSP::FuzzEngine fuzz;
+        fuzz.setAntiderivativeShaping(antiderivative);
+        fuzz.prepare(spec);
+
+        std::vector<float> gainRamp(static_cast<size_t>(blockSize));
+        juce::AudioBuffer<float> buffer(2, blockSize);
+        float largestStep = 0.0f, previous = 0.0f;
+
+        for (int block = 0; block < 64; ++block)
+        {
+            for (int i = 0; i < blockSize; ++i)
+            {
+                const int n = block * blockSize + i;
+                gainRamp[static_cast<size_t>(i)] = 0.5f + 0.5f * std::sin(static_cast<float>(n) * 0.0005f);
+                buffer.setSample(0, i, 0.3f * std::sin(static_cast<float>(n) * 0.02f));
+                buffer.setSample(1, i, buffer.getSample(0, i));
+            }
+
+            fuzz.setParameterRamps({ gainRamp.data(), gainRamp.back(), blockSize }, DSP::RampBlock::constant(0.7f),
+                                   DSP::RampBlock::constant(0.5f));
+            juce::dsp::AudioBlock<float> audioBlock(buffer);
+            fuzz.process(audioBlock);
+
+            for (int i = 0; i < blockSize; ++i)
+            {
+                if (block > 4)
+                    largestStep = std::max(largestStep, std::abs(buffer.getSample(0, i) - previous));
+                previous = buffer.getSample(0, i);
+            }
+        }
+        return largestStep;
+    };
+
+    const float directStep = largestStepUnderRamp(false);
+    const float shapedStep = largestStepUnderRamp(true);
+    logTest("ADAA stays smooth under a gain ramp", shapedStep <= directStep,
+            "largest step " + std::to_string(shapedStep) + " (direct " + std::to_string(directStep) + ")");
+}
+
+//==============================================================================
+// Test 18: Analytic Octave Engine
+//==============================================================================
+
+void testAnalyticOctave()
+{
+    std::cout << "\n=== Analytic Octave Tests ===" << std::endl;
+
+    const double sampleRate = 48000.0;
+    const int blockSize = 256;
+    const juce::dsp::ProcessSpec spec { sampleRate, static_cast<juce::uint32>(blockSize), 2 };
+    using Engine = DSP::OctaveGenerator::Engine;
+
+    // Octave contribution (output minus input) of a steady tone at the
+    // native rate, after half a second of settling
+    auto renderOctave = [&](Engine engine, double hz, int numSamples)
+    {
+        DSP::OctaveGenerator octave;
+        octave.setEngine(engine);
+        octave.prepare(spec);
+        octave.setGlare(1.0f);
+
+        const int settleSamples = static_cast<int>(0.5 * sampleRate);
+        std::vector<float> output;
+        juce::AudioBuffer<float> buffer(2, blockSize);
+
+        for (int position = 0; static_cast<int>(output.size()) < numSamples; position += blockSize)
+        {
+            for (int i = 0; i < blockSize; ++i)
+            {
+                const double phase = 2.0 * juce::MathConstants<double>::pi * hz * (position + i) / sampleRate;
+                buffer.setSample(0, i, 0.5f * static_cast<float>(std::sin(phase)));
+                buffer.setSample(1, i, buffer.getSample(0, i));
+            }
+
+            juce::AudioBuffer<float> input;
+            input.makeCopyOf(buffer);
+            juce::dsp::AudioBlock<float> block(buffer);
+            octave.process(block);
+
+            for (int i = 0; i < blockSize && static_cast<int>(output.size()) < numSamples; ++i)
+                if (position + i >= settleSamples)
+                    output.push_back(buffer.getSample(0, i) - input.getSample(0, i));
+        }
+        return output;
+    };
+
+    // Amplitude of one DFT bin
+    auto binAmplitude = [](const std::vector<float>& samples, int bin)
+    {
+        const int n = static_cast<int>(samples.size());
+        double re = 0.0, im = 0.0;
+        for (int i = 0; i < n; ++i)
+        {
+            const double phase = juce::MathConstants<double>::twoPi * bin * i / n;
+            re += samples[static_cast<size_t>(i)] * std::cos(phase);
+            im -= samples[static_cast<size_t>(i)] * std::sin(phase);
+        }
+        return 2.0 * std::sqrt(re * re + im * im) / n;
+    };
+
+    constexpr int captureSamples = 1 << 14;
+
+    // Native rate, no oversampling: the analytic octave of a bright tone is
+    // far cleaner than rectifying it at the same rate
+    {
+        const int bin = TestSignals::coherentToneBin(sampleRate, 2500.0, captureSamples);
+        const double toneHz = bin * sampleRate / captureSamples;
+        const auto rectified = renderOctave(Engine::Rectifier, toneHz, captureSamples);
+        const auto analytic = renderOctave(Engine::Analytic, toneHz, captureSamples);
+        const double rectifiedDb = TestSignals::measureAliasingDb(rectified.data(), captureSamples, bin);
+        const double analyticDb = TestSignals::measureAliasingDb(analytic.data(), captureSamples, bin);
+
+        bool finite = true;
+        for (float sample : analytic)
+            finite = finite && std::isfinite(sample);
+
+        std::stringstream details;
+        details << std::fixed << std::setprecision(1) << rectifiedDb << " dB -> " << analyticDb << " dB";
+        logTest("Analytic octave aliases less at native rate",
+                finite && analyticDb < -60.0 && analyticDb < rectifiedDb - 10.0, details.str());
+    }
+
+    // The doubled fundamental matches the rectifier's level, so Glare sits
+    // the same in either engine
+    {
+        const int bin = TestSignals::coherentToneBin(sampleRate, 220.0, captureSamples);
+        const double toneHz = bin * sampleRate / captureSamples;
+        const auto rectified = renderOctave(Engine::Rectifier, toneHz, captureSamples);
+        const auto analytic = renderOctave(Engine::Analytic, toneHz, captureSamples);
+
+        const double rectifiedOctave = binAmplitude(rectified, 2 * bin);
+        const double analyticOctave = binAmplitude(analytic, 2 * bin);
+        const double fundamental = binAmplitude(analytic, bin);
+        const double levelDb = juce::Decibels::gainToDecibels(analyticOctave / rectifiedOctave);
+
+        std::stringstream details;
+        details << std::fixed << std::setprecision(2) << levelDb << " dB vs rectifier, fundamental "
+                << juce::Decibels::gainToDecibels(fundamental / analyticOctave) << " dB";
+        logTest("Analytic octave level matches rectifier",
+                std::abs(levelDb) < 1.5 && fundamental < analyticOctave * 0.01, details.str());
+    }
+
+    // In the processor the engine leaves latency alone and persists in state.
+    // Switching after prepare re-prepares (normally from the message loop)
+    BlackheartAudioProcessor processor;
+    processor.prepareToPlay(sampleRate, blockSize);
+    const int rectifierLatency = processor.getLatencyInSamples();
+    processor.setOctaveEngine(Engine::Analytic);
+    processor.applyPendingReconfiguration();
+
+    if (auto* p = processor.getAPVTS().getParameter("glare"))
+        p->setValueNotifyingHost(1.0f);
+
+    const auto guitar = TestSignals::renderGuitarSignal(sampleRate, 48 * blockSize);
+    juce::MidiBuffer midiBuffer;
+    juce::AudioBuffer<float> block(2, blockSize);
+    bool clean = true;
+    for (int offset = 0; offset + blockSize <= guitar.getNumSamples() && clean; offset += blockSize)
+    {
+        for (int ch = 0; ch < 2; ++ch)
+            block.copyFrom(ch, 0, guitar, 0, offset, blockSize);
+        processor.processBlock(block, midiBuffer);
+        clean = !hasNaN(block);
+    }
+
+    logTest("Analytic engine runs in the processor",
+            clean && processor.getPreparedOctaveEngine() == Engine::Analytic
+                && processor.getLatencyInSamples() == rectifierLatency,
+            std::to_string(processor.getLatencyInSamples()) + " samples latency");
+
+    juce::MemoryBlock stateData;
+    processor.getStateInformation(stateData);
+    processor.releaseResources();
+
+    BlackheartAudioProcessor restored;
+    restored.setStateInformation(stateData.getData(), static_cast<int>(stateData.getSize()));
+    logTest("Octave engine restored from state", restored.getOctaveEngine() == Engine::Analytic);
+}
+
+//==============================================================================
+// Test 19: Filter Cascade
+//==============================================================================
+
+void testFilterCascade()
+{
+    std::cout << "\n=== Filter Cascade Tests ===" << std::endl;
+
+    using Cascade = DSP::FilterCascade;
+    using Filter = juce::dsp::StateVariableTPTFilter<float>;
+    using FilterType = juce::dsp::StateVariableTPTFilterType;
+
+    const double sampleRate = 48000.0;
+    // Seven channels run as one four-lane, one two-lane and one single pass
+    const int numChannels = 7;
+    const int numSamples = 4096;
+    const juce::dsp::ProcessSpec spec { sampleRate, static_cast<juce::uint32>(numSamples), static_cast<juce::uint32>(numChannels) };
+
+    // A different signal in every channel, so a lane reading the wrong
+    // channel or state row shows up
+    juce::AudioBuffer<float> input(numChannels, numSamples);
+    juce::Random random(1977);
+    for (int ch = 0; ch < numChannels; ++ch)
+    {
+        const double hz = 80.0 * (ch + 1);
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const double phase = 2.0 * juce::MathConstants<double>::pi * hz * i / sampleRate;
+            input.setSample(ch, i, 0.5f * static_cast<float>(std::sin(phase)) + 0.25f * (random.nextFloat() - 0.5f));
+        }
+    }
+
+    auto makeFilter = [&](FilterType type, float cutoffHz, float resonance)
+    {
+        Filter filter;
+        filter.setType(type);
+        filter.prepare(spec);
+        filter.setCutoffFrequency(cutoffHz);
+        filter.setResonance(resonance);
+        return filter;
+    };
+
+    auto bandpassed = [&](float cutoffHz, float resonance)
+    {
+        auto section = Cascade::Section::tuned(sampleRate, cutoffHz, resonance);
+        section.bandpass = 1.0f;
+        return section;
+    };
+
+    // Runs the cascade over the input in uneven blocks, so state carries
+    // across block edges, and returns the largest difference from the
+    // per-sample reference
+    auto compare = [&](const std::vector<Cascade::Section>& sections, auto&& reference)
+    {
+        Cascade cascade;
+        cascade.prepare(numChannels);
+        for (size_t s = 0; s < sections.size(); ++s)
+            cascade.setSection(static_cast<int>(s), sections[s]);
+        cascade.setNumSections(static_cast<int>(sections.size()));
+
+        juce::AudioBuffer<float> output;
+        output.makeCopyOf(input);
+        const int blockSizes[] = { 1, 63, 256, 17, 512 };
+        for (int position = 0, b = 0; position < numSamples; ++b)
+        {
+            const int count = std::min(blockSizes[b % 5], numSamples - position);
+            juce::dsp::AudioBlock<float> block(output);
+            auto sub = block.getSubBlock(static_cast<size_t>(position), static_cast<size_t>(count));
+            cascade.process(sub);
+            position += count;
+        }
+
+        float maxError = 0.0f;
+        for (int ch = 0; ch < numChannels; ++ch)
+            for (int i = 0; i < numSamples; ++i)
+                maxError = std::max(maxError, std::abs(output.getSample(ch, i) - reference(ch, input.getSample(ch, i))));
+        return maxError;
+    };
+
+    auto report = [](const std::string& name, float maxError)
+    {
+        std::stringstream details;
+        details << std::scientific << std::setprecision(2) << "max error " << maxError;
+        logTest(name, maxError < 1.0e-5f, details.str());
+    };
+
+    {
+        auto lowpass = makeFilter(FilterType::lowpass, 1200.0f, 0.9f);
+        report("Cascade lowpass matches the JUCE SVF",
+               compare({ Cascade::Section::lowpassed(sampleRate, 1200.0f, 0.9f) },
+                       [&](int ch, float x) { return lowpass.processSample(ch, x); }));
+    }
+
+    {
+        auto highpass = makeFilter(FilterType::highpass, 150.0f, 0.7071f);
+        report("Cascade highpass matches the JUCE SVF",
+               compare({ Cascade::Section::highpassed(sampleRate, 150.0f, 0.7071f) },
+                       [&](int ch, float x) { return highpass.processSample(ch, x); }));
+    }
+
+    {
+        auto bandpass = makeFilter(FilterType::bandpass, 800.0f, 2.5f);
+        report("Cascade bandpass matches the JUCE SVF",
+               compare({ bandpassed(800.0f, 2.5f) },
+                       [&](int ch, float x) { return bandpass.processSample(ch, x); }));
+    }
+
+    {
+        auto bandpass = makeFilter(FilterType::bandpass, 2000.0f, 1.5f);
+        report("Cascade peak matches input plus JUCE SVF bandpass",
+               compare({ Cascade::Section::peak(sampleRate, 2000.0f, 1.5f, 0.8f) },
+                       [&](int ch, float x) { return x + 0.8f * bandpass.processSample(ch, x); }));
+    }
+
+    // The full chain: every section type in series, with a parallel
+    // bandpass reading the peak section's input and adding to its output
+    {
+        auto highpass = makeFilter(FilterType::highpass, 100.0f, 0.7071f);
+        auto lowpass = makeFilter(FilterType::lowpass, 6000.0f, 0.8f);
+        auto peakBand = makeFilter(FilterType::bandpass, 1500.0f, 2.0f);
+        auto parallelBand = makeFilter(FilterType::bandpass, 400.0f, 1.2f);
+        auto finalBand = makeFilter(FilterType::bandpass, 3000.0f, 0.9f);
+
+        auto parallel = bandpassed(400.0f, 1.2f);
+        parallel.parallel = true;
+
+        report("Cascade chain with a parallel section matches the JUCE SVFs",
+               compare({ Cascade::Section::highpassed(sampleRate, 100.0f, 0.7071f),
+                         Cascade::Section::lowpassed(sampleRate, 6000.0f, 0.8f),
+                         Cascade::Section::peak(sampleRate, 1500.0f, 2.0f, 0.5f),
+                         parallel,
+                         bandpassed(3000.0f, 0.9f) },
+                       [&](int ch, float x)
+                       {
+                           const float filtered = lowpass.processSample(ch, highpass.processSample(ch, x));
+                           const float peaked = filtered + 0.5f * peakBand.processSample(ch, filtered);
+                           const float summed = peaked + parallelBand.processSample(ch, filtered);
+                           return finalBand.processSample(ch, summed);
+                       }));
+    }
+}
+
+//==============================================================================
+// Test 20: Chaos Modulator Control Rate
+//==============================================================================
+
+void testChaosControlRate()
+{
+    std::cout << "\n=== Chaos Control Rate Tests ===" << std::endl;
+
+    const double sampleRate = 48000.0;
+    // Not a multiple of the control interval, so control steps straddle blocks
+    const int blockSize = 100;
+    const int numBlocks = 480;
+    const int numSamples = blockSize * numBlocks;
+    const juce::dsp::ProcessSpec spec { sampleRate, static_cast<juce::uint32>(blockSize), 2 };
+
+    struct Trace
+    {
+        std::vector<float> pitch, grain, timing;
+    };
+
+    auto makeModulator = [&](DSP::ChaosModulator& modulator, float chaosAmount)
+    {
+        // Speed and chaos first: prepare() picks up the starting rate
+        modulator.setSeed(4242);
+        modulator.setSpeed(0.6f);
+        modulator.setChaos(chaosAmount);
+        modulator.prepare(spec);
+    };
+
+    // Envelope swells and decays every 24 blocks, so the smoothers move
+    auto envelopeAt = [](int block) { return 0.5f + 0.5f * std::sin(static_cast<float>(block) * 0.26f); };
+
+    // Per-sample reference: every generator steps once per sample
+    auto renderReference = [&](float chaosAmount)
+    {
+        DSP::ChaosModulator modulator;
+        makeModulator(modulator, chaosAmount);
+
+        Trace trace;
+        for (int b = 0; b < numBlocks; ++b)
+        {
+            modulator.setEnvelopeValue(envelopeAt(b));
+            for (int i = 0; i < blockSize; ++i)
+            {
+                modulator.getNextModulationValue();
+                const auto out = modulator.getModulation();
+                trace.pitch.push_back(out.pitchMod);
+                trace.grain.push_back(out.grainSizeMod);
+                trace.timing.push_back(out.timingMod);
+            }
+        }
+        return trace;
+    };
+
+    auto renderControlRate = [&](float chaosAmount, int interval)
+    {
+        DSP::ChaosModulator modulator;
+        makeModulator(modulator, chaosAmount);
+        modulator.setControlInterval(interval);
+
+        Trace trace;
+        trace.pitch.resize(static_cast<size_t>(numSamples));
+        trace.grain.resize(static_cast<size_t>(numSamples));
+        trace.timing.resize(static_cast<size_t>(numSamples));
+        for (int b = 0; b < numBlocks; ++b)
+        {
+            const auto offset = static_cast<size_t>(b * blockSize);
+            modulator.setEnvelopeValue(envelopeAt(b));
+            modulator.processToBuffers(trace.pitch.data() + offset, trace.grain.data() + offset,
+                                       trace.timing.data() + offset, blockSize);
+        }
+        return trace;
+    };
+
+    auto forEachOutput = [](const Trace& trace, auto&& fn)
+    {
+        fn(trace.pitch);
+        fn(trace.grain);
+        fn(trace.timing);
+    };
+
+    auto maxDifference = [&](const Trace& a, const Trace& b)
+    {
+        const std::vector<float>* others[] = { &b.pitch, &b.grain, &b.timing };
+        int index = 0;
+        float maxError = 0.0f;
+        forEachOutput(a, [&](const std::vector<float>& values)
+        {
+            const auto& other = *others[index++];
+            for (size_t i = 0; i < values.size(); ++i)
+                maxError = std::max(maxError, std::abs(values[i] - other[i]));
+        });
+        return maxError;
+    };
+
+    auto maxJump = [&](const Trace& trace)
+    {
+        float jump = 0.0f;
+        forEachOutput(trace, [&](const std::vector<float>& values)
+        {
+            for (size_t i = 1; i < values.size(); ++i)
+                jump = std::max(jump, std::abs(values[i] - values[i - 1]));
+        });
+        return jump;
+    };
+
+    // How far any sample strays outside the reference's range over the
+    // surrounding control interval: the lag and draw timing control-rate
+    // stepping is allowed, and nothing more
+    auto maxOutsideWindow = [&](const Trace& trace, const Trace& reference, int window)
+    {
+        const std::vector<float>* references[] = { &reference.pitch, &reference.grain, &reference.timing };
+        int index = 0;
+        float maxError = 0.0f;
+        forEachOutput(trace, [&](const std::vector<float>& values)
+        {
+            const auto& expected = *references[index++];
+            for (int i = 0; i < numSamples; ++i)
+            {
+                const auto first = expected.begin() + std::max(0, i - window);
+                const auto last = expected.begin() + std::min(numSamples, i + window + 1);
+                const auto [low, high] = std::minmax_element(first, last);
+                const float v = values[static_cast<size_t>(i)];
+                maxError = std::max(maxError, std::max(*low - v, v - *high));
+            }
+        });
+        return maxError;
+    };
+
+    auto range = [&](const Trace& trace)
+    {
+        float low = 0.0f, high = 0.0f;
+        bool finite = true;
+        forEachOutput(trace, [&](const std::vector<float>& values)
+        {
+            for (float v : values)
+            {
+                finite = finite && std::isfinite(v);
+                low = std::min(low, v);
+                high = std::max(high, v);
+            }
+        });
+        return std::make_tuple(low, high, finite);
+    };
+
+    const int interval = DSP::ChaosModulator::defaultControlInterval;
+
+    for (float chaosAmount : { 0.3f, 0.6f, 0.9f })
+    {
+        std::stringstream label;
+        label << std::fixed << std::setprecision(1) << " (chaos " << chaosAmount << ")";
+        const auto reference = renderReference(chaosAmount);
+        const auto everySample = renderControlRate(chaosAmount, 1);
+        const auto controlRate = renderControlRate(chaosAmount, interval);
+
+        const float perSampleError = maxDifference(everySample, reference);
+        logTest("Interval 1 matches per-sample generation" + label.str(), perSampleError < 1.0e-6f,
+                "max error " + std::to_string(perSampleError));
+
+        // Above 0.6 chaos the S&H stops smoothing and the generators can
+        // take draws from the shared random stream in a different order, so
+        // the traces only agree in range and continuity
+        if (chaosAmount <= 0.6f)
+        {
+            const float trackingError = maxOutsideWindow(controlRate, reference, interval);
+            logTest("Control rate tracks per-sample generation" + label.str(), trackingError < 0.05f,
+                    "max error " + std::to_string(trackingError) + " outside the reference's "
+                        + std::to_string(interval) + "-sample window");
+        }
+
+        const auto [referenceLow, referenceHigh, referenceFinite] = range(reference);
+        const auto [controlLow, controlHigh, controlFinite] = range(controlRate);
+        std::stringstream rangeDetails;
+        rangeDetails << std::fixed << std::setprecision(3) << "[" << controlLow << ", " << controlHigh
+                     << "] vs [" << referenceLow << ", " << referenceHigh << "]";
+        logTest("Control-rate output stays in range" + label.str(),
+                referenceFinite && controlFinite
+                    && controlLow >= referenceLow - 0.01f && controlHigh <= referenceHigh + 0.01f,
+                rangeDetails.str());
+
+        // Ramps start from the previous step's value, including across
+        // block edges, so no sample moves further than the reference does
+        const float referenceJump = maxJump(reference);
+        const float controlJump = maxJump(controlRate);
+        logTest("Control-rate output is continuous across steps" + label.str(),
+                controlJump <= referenceJump * 1.25f,
+                "largest step " + std::to_string(controlJump) + " (per-sample " + std::to_string(referenceJump) + ")");
+    }
+}
+
+//==============================================================================
+// Test 21: Parameter Ramps
+//==============================================================================
+
+void testParameterRamps()
+{
+    std::cout << "\n=== Parameter Ramp Tests ===" << std::endl;
+
+    const double sampleRate = 48000.0;
+    const int rampSamples = 480;    // 10 ms
+    const int maxBlockSize = 512;
+
+    // Renders blocks of the given size until the ramp settles, collecting
+    // every sample; a static block stands for numSamples copies of its value
+    auto render = [](DSP::ParameterRamp& ramp, int blockSize, int numSamples)
+    {
+        std::vector<float> output;
+        while (static_cast<int>(output.size()) < numSamples)
+        {
+            const auto block = ramp.process(blockSize);
+            for (int i = 0; i < blockSize; ++i)
+                output.push_back(block[i]);
+        }
+        output.resize(static_cast<size_t>(numSamples));
+        return output;
+    };
+
+    // Largest difference from the straight line start -> target over the
+    // ramp's length, and whether it holds the target exactly afterwards
+    auto checkLine = [&](const std::vector<float>& output, size_t offset, float start, float target)
+    {
+        float maxError = 0.0f;
+        bool holds = true;
+        for (size_t i = offset; i < output.size(); ++i)
+        {
+            const auto n = static_cast<int>(i - offset) + 1;
+            if (n < rampSamples)
+                maxError = std::max(maxError, std::abs(output[i] - (start + (target - start) * static_cast<float>(n) / rampSamples)));
+            else
+                holds = holds && output[i] == target;
+        }
+        return std::make_pair(maxError, holds);
+    };
+
+    // Blocks shorter than the countdown (neither divides it, so one block
+    // straddles the landing) and one longer than the whole ramp
+    for (int blockSize : { 64, 100, 512 })
+    {
+        DSP::ParameterRamp ramp;
+        ramp.prepare(sampleRate, rampSamples / sampleRate, maxBlockSize);
+        ramp.setCurrentAndTargetValue(0.1f);
+        ramp.setTargetValue(0.7f);
+
+        const auto output = render(ramp, blockSize, 2 * rampSamples);
+        const auto [maxError, holds] = checkLine(output, 0, 0.1f, 0.7f);
+
+        logTest("Ramp lands exactly on target (" + std::to_string(blockSize) + "-sample blocks)",
+                maxError < 1.0e-6f && holds && output[rampSamples - 1] == 0.7f
+                    && ! ramp.isSmoothing() && ramp.process(blockSize).isStatic(),
+                "max deviation " + std::to_string(maxError));
+    }
+
+    // Blocks shorter than the countdown stay ramping and report their last
+    // value; the one that reaches it fills the rest with the target
+    {
+        DSP::ParameterRamp ramp;
+        ramp.prepare(sampleRate, rampSamples / sampleRate, maxBlockSize);
+        ramp.setCurrentAndTargetValue(1.0f);
+        ramp.setTargetValue(0.0f);
+
+        const auto first = ramp.process(400);
+        const bool shortBlock = ! first.isStatic() && first.numSamples == 400
+                             && first.value == first[399] && ramp.isSmoothing()
+                             && ramp.getCurrentValue() == first[399];
+
+        const auto last = ramp.process(200);
+        bool filled = ! last.isStatic() && last.value == 0.0f && ! ramp.isSmoothing();
+        for (int i = 79; i < 200; ++i)
+            filled = filled && last[i] == 0.0f;
+
+        logTest("Ramp blocks shorter and longer than the countdown", shortBlock && filled && last[78] > 0.0f);
+    }
+
+    // Retargeting mid-ramp continues from the current value and takes a
+    // full ramp from there
+    {
+        DSP::ParameterRamp ramp;
+        ramp.prepare(sampleRate, rampSamples / sampleRate, maxBlockSize);
+        ramp.setCurrentAndTargetValue(0.0f);
+        ramp.setTargetValue(1.0f);
+
+        auto output = render(ramp, 64, 192);
+        const float retargetFrom = output.back();
+        const bool continuesFromCurrent = ramp.getCurrentValue() == retargetFrom;
+        ramp.setTargetValue(-0.5f);
+        const auto rest = render(ramp, 64, 2 * rampSamples);
+        output.insert(output.end(), rest.begin(), rest.end());
+
+        const auto [maxError, holds] = checkLine(output, 192, retargetFrom, -0.5f);
+        const float stepBefore = output[191] - output[190];
+        const float stepAfter = output[192] - output[191];
+        const float expectedStep = (-0.5f - retargetFrom) / rampSamples;
+
+        logTest("Ramp retargets mid-ramp without a jump",
+                continuesFromCurrent && maxError < 1.0e-6f && holds
+                    && stepBefore > 0.0f && std::abs(stepAfter - expectedStep) < 1.0e-6f,
+                "max deviation " + std::to_string(maxError));
+    }
+
+    // A target equal to the current one, or a zero-length ramp, never
+    // produces a ramping block
+    {
+        DSP::ParameterRamp ramp;
+        ramp.prepare(sampleRate, rampSamples / sampleRate, maxBlockSize);
+        ramp.setCurrentAndTargetValue(0.25f);
+        ramp.setTargetValue(0.25f);
+        const bool sameTarget = ramp.process(64).isStatic();
+
+        DSP::ParameterRamp instant;
+        instant.prepare(sampleRate, 0.0, maxBlockSize);
+        instant.setTargetValue(0.8f);
+        const auto block = instant.process(64);
+
+        logTest("Ramp stays static without a ramp to run",
+                sameTarget && block.isStatic() && block.value == 0.8f && instant.getCurrentValue() == 0.8f);
+    }
+}
+
+//==============================================================================
+// Main Test Runner
+//==============================================================================
+
+// Returns the number of failed tests
+int runAllTests()
+{
+    std::cout << "╔══════════════════════════════════════════════════════════════╗" << std::endl;
+    std::cout << "║           BLACKHEART PLUGIN TEST SUITE                       ║" << std::endl;
+    std::cout << "╚══════════════════════════════════════════════════════════════╝" << std::endl;
+
+    auto startTime = std::chrono::high_resolution_clock::now();
+
+    testParameterStability();
+    testOctaveButtonBehavior();
+    testLatencyVerification();
+    testSampleRateCompatibility();
+    testBufferSizeCompatibility();
+    testStatePersistence();
+    testStressStability();
+    testInputSignalTypes();
+    testAnalysisBus();
+    testSubBlockAutomation();
+    testMidiOctaveTiming();
+    testMultiChannelProcessing();
+    testLinkedDynamics();
+    testLookaheadLimiter();
+    testMathKernels();
+    testBufferRouting();
+    testAntiderivativeShaping();
+    testAnalyticOctave();
+    testFilterCascade();
+    testChaosControlRate();
+    testParameterRamps();
+
+    auto endTime = std::chrono::high_resolution_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(endTime - startTime);
+
+    // Summary
+    int passed = 0, failed = 0;
+    for (const auto& result : testResults)
+    {
+        if (result.passed) passed++;
+        else failed++;
+    }
+
+    std::cout << "\n╔══════════════════════════════════════════════════════════════╗" << std::endl;
+    std::cout << "║                      TEST SUMMARY                            ║" << std::endl;
+    std::cout << "╚══════════════════════════════════════════════════════════════╝" << std::endl;
+    std::cout << "Total tests: " << testResults.size() << std::endl;
+    std::cout << "Passed: " << passed << std::endl;
+    std::cout << "Failed: " << failed << std::endl;
+    std::cout << "Duration: " << duration.count() << " ms" << std::endl;
+    std::cout << "Result: " << (failed == 0 ? "ALL TESTS PASSED ✓" : "SOME TESTS FAILED ✗") << std::endl;
+
+    if (failed > 0)
+    {
+        std::cout << "\nFailed tests:" << std::endl;
+        for (const auto& result : testResults)
+        {
+            if (!result.passed)
+            {
+                std::cout << "  - " << result.name;
+                if (!result.details.empty())
+                    std::cout << ": " << result.details;
+                std::cout << std::endl;
+            }
+        }
+    }
+
+    return failed;
 }
 
 // Entry point when built as standalone test
@@ -723,7 +2312,6 @@ void runAllTests()
 int main()
 {
     juce::ScopedJuceInitialiser_GUI juceInit;
-    runAllTests();
-    return 0;
+    return runAllTests() == 0 ? 0 : 1;
 }
 #endif
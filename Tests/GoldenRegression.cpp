@@ -0,0 +1,452 @@
+/**
+ * Blackheart Golden-Output Regression
+ *
+ * Renders a fixed set of scenarios — deterministic input, scripted parameter
+ * automation, pinned random seed — and either records the output as golden
+ * files or compares a build against them. Record on the reference build,
+ * then compare after touching the DSP: optimised paths (SIMD kernels,
+ * oversampling, block-rate smoothing) must still produce the same sound.
+ *
+ * Options:
+ *   --record=<dir>          render and write <dir>/<scenario>.wav (32-bit float)
+ *   --compare=<dir>         render and compare against <dir>/<scenario>.wav
+ *   --scenarios=a,b         scenario names to run (default all)
+ *   --max-abs=1e-3          per-sample tolerance, linear full scale (not
+ *                           applied to the octave/chaos scenarios)
+ *   --spectral-db=0.5       mean log-spectral distance tolerance, dB
+ *   --list                  print the scenario names and exit
+ *   --output=report.json    write the comparison report as JSON
+ *
+ * Exits non-zero if any scenario is missing or exceeds a tolerance.
+ */
+
+#include "PluginProcessor.h"
+#include "TestSignals.h"
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <vector>
+
+//==============================================================================
+// Scenarios
+//==============================================================================
+
+// Breakpoints in seconds → denormalised value, linear in between and held
+// past the ends. Two points at the same time make a step.
+struct Automation
+{
+    const char* parameterID;
+    std::vector<std::pair<double, float>> points;
+
+    float valueAt(double seconds) const
+    {
+        size_t next = 0;
+        while (next < points.size() && points[next].first <= seconds)
+            ++next;
+
+        if (next == 0)
+            return points.front().second;
+        if (next == points.size())
+            return points.back().second;
+
+        const auto& [t0, v0] = points[next - 1];
+        const auto& [t1, v1] = points[next];
+        return v0 + static_cast<float>((seconds - t0) / (t1 - t0)) * (v1 - v0);
+    }
+};
+
+enum class Signal { Guitar, Sweep };
+
+struct Scenario
+{
+    const char* name;
+    Signal signal;
+    double sampleRate;
+    int blockSize;
+    double seconds;                 // Input length; 0.5s of silence follows for the tails
+    bool offline;                   // Render-tier processing (isNonRealtime)
+    // With an octave engaged the pitch shifter's chaos generators turn
+    // last-bit drift (a table entry, a reordered sum) into small shifts of
+    // grain timing: inaudible, but far past any per-sample tolerance. Such
+    // scenarios are gated on the spectral distance only
+    bool spectralOnly;
+    std::vector<std::pair<const char*, float>> initial;
+    std::vector<Automation> automation;
+};
+
+static const std::vector<Scenario>& getScenarios()
+{
+    static const std::vector<Scenario> scenarios = {
+        { "default", Signal::Guitar, 48000.0, 256, 3.0, false, false, { }, { } },
+
+        { "scream-gain-shape", Signal::Guitar, 48000.0, 128, 3.0, false, false,
+          { { ParameterIDs::mode, 0.0f } },
+          { { ParameterIDs::gain,  { { 0.0, 0.0f }, { 3.0, 1.0f } } },
+            { ParameterIDs::shape, { { 0.5, 0.2f }, { 2.5, 0.9f } } } } },
+
+        { "doom-sweep", Signal::Sweep, 44100.0, 512, 4.0, false, false,
+          { { ParameterIDs::mode, 2.0f }, { ParameterIDs::gain, 0.7f }, { ParameterIDs::level, 0.6f } },
+          { } },
+
+        { "oct1-chaos", Signal::Guitar, 48000.0, 64, 3.0, false, true,
+          { { ParameterIDs::octave1, 1.0f }, { ParameterIDs::chaos, 0.8f }, { ParameterIDs::chaosMix, 1.0f } },
+          { { ParameterIDs::speed, { { 0.0, 0.3f }, { 3.0, 1.0f } } } } },
+
+        { "oct2-panic", Signal::Guitar, 96000.0, 256, 3.0, false, true,
+          { { ParameterIDs::gain, 0.8f } },
+          { { ParameterIDs::octave2, { { 1.0, 0.0f }, { 1.0, 1.0f } } },
+            { ParameterIDs::panic,   { { 1.0, 0.0f }, { 3.0, 1.0f } } } } },
+
+        // Odd block size: partial blocks, ramp lengths that don't divide evenly
+        { "odd-blocks", Signal::Guitar, 44100.0, 37, 3.0, false, true,
+          { { ParameterIDs::glare, 0.7f } },
+          { { ParameterIDs::octave1, { { 0.5, 0.0f }, { 0.5, 1.0f }, { 2.0, 1.0f }, { 2.0, 0.0f } } },
+            { ParameterIDs::blend,   { { 0.0, 1.0f }, { 3.0, 0.3f } } } } },
+
+        { "render-tier", Signal::Guitar, 48000.0, 512, 3.0, true, true,
+          { { ParameterIDs::gain, 0.8f }, { ParameterIDs::octave1, 1.0f }, { ParameterIDs::octave2, 1.0f },
+            { ParameterIDs::chaos, 0.6f } },
+          { } },
+    };
+    return scenarios;
+}
+
+// Every golden render uses the same seed, so the chaos and grain-jitter
+// random sources replay identically
+static constexpr unsigned int goldenSeed = 0xB1AC;
+
+//==============================================================================
+// Rendering
+//==============================================================================
+
+static void setParameter(BlackheartAudioProcessor& processor, const char* id, float value)
+{
+    if (auto* param = processor.getAPVTS().getParameter(id))
+        param->setValueNotifyingHost(param->convertTo0to1(value));
+}
+
+static juce::AudioBuffer<float> renderScenario(const Scenario& scenario)
+{
+    const int signalSamples = static_cast<int>(scenario.seconds * scenario.sampleRate);
+    const int tailSamples = static_cast<int>(0.5 * scenario.sampleRate);
+
+    auto input = scenario.signal == Signal::Sweep
+        ? TestSignals::renderSineSweep(scenario.sampleRate, signalSamples)
+        : TestSignals::renderGuitarSignal(scenario.sampleRate, signalSamples);
+    input.setSize(2, signalSamples + tailSamples, true, true);
+
+    BlackheartAudioProcessor processor;
+    for (const auto& [id, value] : scenario.initial)
+        setParameter(processor, id, value);
+    for (const auto& automation : scenario.automation)
+        setParameter(processor, automation.parameterID, automation.valueAt(0.0));
+
+    processor.setRandomSeed(goldenSeed);
+    processor.setNonRealtime(scenario.offline);
+    processor.prepareToPlay(scenario.sampleRate, scenario.blockSize);
+
+    const int totalSamples = input.getNumSamples();
+    juce::AudioBuffer<float> output(2, totalSamples);
+    juce::AudioBuffer<float> buffer(2, scenario.blockSize);
+    juce::MidiBuffer midi;
+
+    for (int offset = 0; offset < totalSamples; offset += scenario.blockSize)
+    {
+        const int numSamples = juce::jmin(scenario.blockSize, totalSamples - offset);
+
+        // Automation lands at block boundaries, as from a host
+        const double seconds = static_cast<double>(offset) / scenario.sampleRate;
+        for (const auto& automation : scenario.automation)
+            setParameter(processor, automation.parameterID, automation.valueAt(seconds));
+
+        buffer.setSize(2, numSamples, false, false, true);
+        for (int ch = 0; ch < 2; ++ch)
+            buffer.copyFrom(ch, 0, input, ch, offset, numSamples);
+
+        processor.processBlock(buffer, midi);
+
+        for (int ch = 0; ch < 2; ++ch)
+            output.copyFrom(ch, offset, buffer, ch, 0, numSamples);
+    }
+
+    processor.releaseResources();
+    return output;
+}
+
+//==============================================================================
+// Golden files
+//==============================================================================
+
+static bool writeGolden(const juce::File& file, const juce::AudioBuffer<float>& buffer, double sampleRate)
+{
+    file.deleteFile();
+
+    auto stream = std::make_unique<juce::FileOutputStream>(file);
+    if (! stream->openedOk())
+        return false;
+
+    // 32-bit float WAV: bit-exact round trip, and still playable for a listen
+    juce::WavAudioFormat wav;
+    std::unique_ptr<juce::AudioFormatWriter> writer(wav.createWriterFor(stream.get(), sampleRate,
+        static_cast<unsigned int>(buffer.getNumChannels()), 32, {}, 0));
+    if (writer == nullptr)
+        return false;
+
+    stream.release();  // Owned by the writer now
+    return writer->writeFromAudioSampleBuffer(buffer, 0, buffer.getNumSamples());
+}
+
+static bool readGolden(const juce::File& file, juce::AudioBuffer<float>& buffer)
+{
+    juce::WavAudioFormat wav;
+    std::unique_ptr<juce::AudioFormatReader> reader(wav.createReaderFor(file.createInputStream().release(), true));
+    if (reader == nullptr)
+        return false;
+
+    const auto length = static_cast<int>(reader->lengthInSamples);
+    buffer.setSize(static_cast<int>(reader->numChannels), length);
+    return reader->read(&buffer, 0, length, 0, true, true);
+}
+
+//==============================================================================
+// Comparison
+//==============================================================================
+
+struct Comparison
+{
+    bool lengthMatches = false;
+    double maxAbsError = 0.0;
+    int maxAbsChannel = 0;
+    int maxAbsSample = 0;
+    double rmsErrorDb = -200.0;         // Error energy relative to the golden
+    double spectralDistanceDb = 0.0;    // Mean log-spectral distance
+};
+
+// Mean over frames of the RMS dB difference between magnitude spectra.
+// Bins where both spectra sit below the floor are skipped, so noise-level
+// differences in silence don't dominate.
+static double spectralDistanceDb(const float* reference, const float* candidate, int numSamples)
+{
+    constexpr int fftOrder = 11;
+    constexpr int fftSize = 1 << fftOrder;
+    constexpr int hop = fftSize / 2;
+    constexpr float floorDb = -100.0f;
+
+    juce::dsp::FFT fft(fftOrder);
+    juce::dsp::WindowingFunction<float> window(static_cast<size_t>(fftSize),
+                                               juce::dsp::WindowingFunction<float>::hann, false);
+
+    std::vector<float> a(2 * fftSize), b(2 * fftSize);
+    const float norm = 2.0f / static_cast<float>(fftSize);
+
+    double sum = 0.0;
+    int frames = 0;
+
+    for (int start = 0; start + fftSize <= numSamples; start += hop)
+    {
+        std::fill(a.begin(), a.end(), 0.0f);
+        std::fill(b.begin(), b.end(), 0.0f);
+        std::copy(reference + start, reference + start + fftSize, a.begin());
+        std::copy(candidate + start, candidate + start + fftSize, b.begin());
+
+        window.multiplyWithWindowingTable(a.data(), static_cast<size_t>(fftSize));
+        window.multiplyWithWindowingTable(b.data(), static_cast<size_t>(fftSize));
+        fft.performFrequencyOnlyForwardTransform(a.data());
+        fft.performFrequencyOnlyForwardTransform(b.data());
+
+        double frameSum = 0.0;
+        int bins = 0;
+
+        for (int bin = 1; bin < fftSize / 2; ++bin)
+        {
+            const float dbA = juce::Decibels::gainToDecibels(a[static_cast<size_t>(bin)] * norm, floorDb);
+            const float dbB = juce::Decibels::gainToDecibels(b[static_cast<size_t>(bin)] * norm, floorDb);
+            if (dbA <= floorDb && dbB <= floorDb)
+                continue;
+
+            frameSum += static_cast<double>((dbA - dbB) * (dbA - dbB));
+            ++bins;
+        }
+
+        if (bins > 0)
+        {
+            sum += std::sqrt(frameSum / bins);
+            ++frames;
+        }
+    }
+
+    return frames > 0 ? sum / frames : 0.0;
+}
+
+static Comparison compare(const juce::AudioBuffer<float>& golden, const juce::AudioBuffer<float>& rendered)
+{
+    Comparison result;
+    result.lengthMatches = golden.getNumChannels() == rendered.getNumChannels()
+                        && golden.getNumSamples() == rendered.getNumSamples();
+    if (! result.lengthMatches)
+        return result;
+
+    double errorEnergy = 0.0;
+    double goldenEnergy = 0.0;
+    double spectral = 0.0;
+
+    for (int ch = 0; ch < golden.getNumChannels(); ++ch)
+    {
+        const float* g = golden.getReadPointer(ch);
+        const float* r = rendered.getReadPointer(ch);
+
+        for (int i = 0; i < golden.getNumSamples(); ++i)
+        {
+            const double error = std::abs(static_cast<double>(r[i]) - static_cast<double>(g[i]));
+            errorEnergy += error * error;
+            goldenEnergy += static_cast<double>(g[i]) * static_cast<double>(g[i]);
+
+            // A NaN in either file always fails
+            if (error > result.maxAbsError || std::isnan(error))
+            {
+                result.maxAbsError = std::isnan(error) ? std::numeric_limits<double>::infinity() : error;
+                result.maxAbsChannel = ch;
+                result.maxAbsSample = i;
+            }
+        }
+
+        spectral += spectralDistanceDb(g, r, golden.getNumSamples());
+    }
+
+    if (errorEnergy > 0.0)
+        result.rmsErrorDb = 10.0 * std::log10(errorEnergy / juce::jmax(goldenEnergy, 1.0e-30));
+    result.spectralDistanceDb = spectral / juce::jmax(1, golden.getNumChannels());
+    return result;
+}
+
+//==============================================================================
+// Entry point
+//==============================================================================
+
+int main(int argc, char* argv[])
+{
+    juce::ScopedJuceInitialiser_GUI juceInit;
+
+    const juce::ArgumentList args(argc, argv);
+
+    if (args.containsOption("--list"))
+    {
+        for (const auto& scenario : getScenarios())
+            std::cout << scenario.name << std::endl;
+        return 0;
+    }
+
+    const bool recording = args.containsOption("--record");
+    const auto directory = juce::File::getCurrentWorkingDirectory()
+        .getChildFile(args.getValueForOption(recording ? "--record" : "--compare"));
+
+    if (recording == args.containsOption("--compare"))
+    {
+        std::cerr << "Pass exactly one of --record=<dir> or --compare=<dir>" << std::endl;
+        return 1;
+    }
+
+    const double maxAbsTolerance = args.containsOption("--max-abs")
+        ? args.getValueForOption("--max-abs").getDoubleValue() : 1.0e-3;
+    const double spectralTolerance = args.containsOption("--spectral-db")
+        ? args.getValueForOption("--spectral-db").getDoubleValue() : 0.5;
+
+    const auto filter = juce::StringArray::fromTokens(args.getValueForOption("--scenarios"), ",", "");
+
+    if (recording && directory.createDirectory().failed())
+    {
+        std::cerr << "Could not create " << directory.getFullPathName() << std::endl;
+        return 1;
+    }
+
+    juce::Array<juce::var> results;
+    int failures = 0;
+
+    for (const auto& scenario : getScenarios())
+    {
+        if (! filter.isEmpty() && ! filter.contains(scenario.name))
+            continue;
+
+        const auto file = directory.getChildFile(juce::String(scenario.name) + ".wav");
+        const auto rendered = renderScenario(scenario);
+
+        if (recording)
+        {
+            if (! writeGolden(file, rendered, scenario.sampleRate))
+            {
+                std::cerr << "Could not write " << file.getFullPathName() << std::endl;
+                return 1;
+            }
+
+            std::cerr << "recorded " << scenario.name << std::endl;
+            continue;
+        }
+
+        juce::DynamicObject::Ptr result = new juce::DynamicObject();
+        result->setProperty("scenario", scenario.name);
+
+        juce::AudioBuffer<float> golden;
+        if (! readGolden(file, golden))
+        {
+            std::cerr << "FAIL " << scenario.name << ": no golden at " << file.getFullPathName() << std::endl;
+            result->setProperty("passed", false);
+            result->setProperty("error", "missing golden");
+            results.add(juce::var(result.get()));
+            ++failures;
+            continue;
+        }
+
+        const auto c = compare(golden, rendered);
+        const bool passed = c.lengthMatches
+                         && (scenario.spectralOnly || c.maxAbsError <= maxAbsTolerance)
+                         && c.spectralDistanceDb <= spectralTolerance;
+
+        if (! c.lengthMatches)
+        {
+            std::cerr << "FAIL " << scenario.name << ": length/channels differ (golden "
+                      << golden.getNumChannels() << "x" << golden.getNumSamples() << ", rendered "
+                      << rendered.getNumChannels() << "x" << rendered.getNumSamples() << ")" << std::endl;
+        }
+        else
+        {
+            std::cerr << (passed ? "PASS " : "FAIL ") << scenario.name
+                      << ": max abs " << juce::String(c.maxAbsError, 8)
+                      << " (ch " << c.maxAbsChannel << ", sample " << c.maxAbsSample << ")"
+                      << ", rms error " << juce::String(c.rmsErrorDb, 1) << " dB"
+                      << ", spectral " << juce::String(c.spectralDistanceDb, 4) << " dB"
+                      << (scenario.spectralOnly ? " (spectral only)" : "") << std::endl;
+        }
+
+        result->setProperty("passed", passed);
+        result->setProperty("spectralOnly", scenario.spectralOnly);
+        result->setProperty("lengthMatches", c.lengthMatches);
+        result->setProperty("maxAbsError", c.maxAbsError);
+        result->setProperty("maxAbsChannel", c.maxAbsChannel);
+        result->setProperty("maxAbsSample", c.maxAbsSample);
+        result->setProperty("rmsErrorDb", c.rmsErrorDb);
+        result->setProperty("spectralDistanceDb", c.spectralDistanceDb);
+        results.add(juce::var(result.get()));
+
+        if (! passed)
+            ++failures;
+    }
+
+    if (! recording && args.containsOption("--output"))
+    {
+        juce::DynamicObject::Ptr root = new juce::DynamicObject();
+        root->setProperty("pluginVersion", JucePlugin_VersionString);
+        root->setProperty("maxAbsTolerance", maxAbsTolerance);
+        root->setProperty("spectralToleranceDb", spectralTolerance);
+        root->setProperty("failures", failures);
+        root->setProperty("results", results);
+
+        const auto file = juce::File::getCurrentWorkingDirectory().getChildFile(args.getValueForOption("--output"));
+        if (! file.replaceWithText(juce::JSON::toString(juce::var(root.get()))))
+        {
+            std::cerr << "Could not write " << file.getFullPathName() << std::endl;
+            return 1;
+        }
+    }
+
+    return failures == 0 ? 0 : 1;
+}
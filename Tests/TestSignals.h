@@ -0,0 +1,142 @@
+#pragma once
+
+/**
+ * Deterministic test signals shared by the console tools (benchmark,
+ * golden-output regression) and the tests. Same rate and length in, same
+ * samples out.
+ */
+
+#include <JuceHeader.h>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace TestSignals
+{
+
+// Karplus-Strong plucks on the low strings: a new note every 400ms with a
+// noise-burst pick attack and ~1.5s decay. Deterministic for a given rate.
+inline juce::AudioBuffer<float> renderGuitarSignal(double sampleRate, int numSamples)
+{
+    juce::AudioBuffer<float> signal(2, numSamples);
+    juce::Random random(0x5eed);
+
+    static constexpr float noteHz[] = { 82.41f, 110.0f, 146.83f, 98.0f, 123.47f, 164.81f, 73.42f, 196.0f };
+    const int noteSpacing = static_cast<int>(0.4 * sampleRate);
+    const float decayPerPeriod = 0.996f;
+
+    std::vector<float> string;
+    int stringIndex = 0;
+    int noteIndex = 0;
+
+    float* left = signal.getWritePointer(0);
+    float* right = signal.getWritePointer(1);
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        if (i % noteSpacing == 0)
+        {
+            const float hz = noteHz[noteIndex++ % static_cast<int>(std::size(noteHz))];
+            string.assign(static_cast<size_t>(juce::jmax(2, static_cast<int>(sampleRate / hz))), 0.0f);
+            for (auto& s : string)
+                s = (random.nextFloat() * 2.0f - 1.0f) * 0.6f;
+            stringIndex = 0;
+        }
+
+        const size_t size = string.size();
+        const size_t next = (static_cast<size_t>(stringIndex) + 1) % size;
+        const float out = string[static_cast<size_t>(stringIndex)];
+        string[static_cast<size_t>(stringIndex)] = 0.5f * (out + string[next]) * decayPerPeriod;
+        stringIndex = static_cast<int>(next);
+
+        left[i] = out;
+        right[i] = out * 0.95f;
+    }
+
+    return signal;
+}
+
+// Exponential sine sweep, 40Hz to 8kHz at -6dBFS, with a short fade at each
+// end. Exercises the filters and the octave trackers across the range.
+inline juce::AudioBuffer<float> renderSineSweep(double sampleRate, int numSamples)
+{
+    juce::AudioBuffer<float> signal(2, numSamples);
+
+    const double startHz = 40.0;
+    const double endHz = 8000.0;
+    const double duration = static_cast<double>(numSamples) / sampleRate;
+    const double k = std::log(endHz / startHz);
+    const int fadeSamples = juce::jmin(numSamples / 2, static_cast<int>(0.01 * sampleRate));
+
+    float* left = signal.getWritePointer(0);
+    float* right = signal.getWritePointer(1);
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        const double t = static_cast<double>(i) / sampleRate;
+        const double phase = juce::MathConstants<double>::twoPi * startHz * duration / k
+                             * (std::exp(t * k / duration) - 1.0);
+
+        float fade = 1.0f;
+        if (i < fadeSamples)
+            fade = static_cast<float>(i) / static_cast<float>(fadeSamples);
+        else if (i >= numSamples - fadeSamples)
+            fade = static_cast<float>(numSamples - 1 - i) / static_cast<float>(fadeSamples);
+
+        left[i] = right[i] = 0.5f * fade * static_cast<float>(std::sin(phase));
+    }
+
+    return signal;
+}
+
+// Bin of a tone for aliasing measurements: an odd number of cycles in
+// numSamples (a power of two), so every harmonic and every folded alias
+// lands on an exact DFT bin and no window is needed. The tone's frequency
+// is bin * sampleRate / numSamples.
+inline int coherentToneBin(double sampleRate, double targetHz, int numSamples)
+{
+    return static_cast<int>(targetHz / sampleRate * numSamples) | 1;
+}
+
+// Power outside the harmonics of a coherent tone, relative to the total
+// (DC excluded), in dB. For a memoryless distortion of the tone that
+// residue is the aliasing plus the noise floor.
+inline double measureAliasingDb(const float* samples, int numSamples, int fundamentalBin)
+{
+    double mean = 0.0;
+    for (int i = 0; i < numSamples; ++i)
+        mean += samples[i];
+    mean /= numSamples;
+
+    double total = 0.0;
+    for (int i = 0; i < numSamples; ++i)
+        total += (samples[i] - mean) * (samples[i] - mean);
+    total /= numSamples;
+
+    // One DFT bin per harmonic, the twiddle advanced by rotation
+    double harmonic = 0.0;
+    for (int bin = fundamentalBin; bin < numSamples / 2; bin += fundamentalBin)
+    {
+        const double step = juce::MathConstants<double>::twoPi * bin / numSamples;
+        const double cosStep = std::cos(step), sinStep = std::sin(step);
+        double c = 1.0, s = 0.0, re = 0.0, im = 0.0;
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const double x = samples[i] - mean;
+            re += x * c;
+            im -= x * s;
+            const double nextC = c * cosStep - s * sinStep;
+            s = s * cosStep + c * sinStep;
+            c = nextC;
+        }
+
+        harmonic += 2.0 * (re * re + im * im) / (static_cast<double>(numSamples) * numSamples);
+    }
+
+    if (total <= 0.0)
+        return -300.0;
+    return 10.0 * std::log10(std::max(total - harmonic, total * 1.0e-30) / total);
+}
+
+} // namespace TestSignals
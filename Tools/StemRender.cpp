@@ -0,0 +1,562 @@
+/**
+ * Blackheart Batch Stem Renderer
+ *
+ * Re-amps WAV/FLAC stems through BlackheartAudioProcessor offline, one job
+ * per (input, preset) pair, spread across a work-stealing pool of worker
+ * threads. Each worker owns one processor and reuses it between jobs; audio
+ * streams through it in large chunks (StreamingAudio: memory-mapped WAV or
+ * decoding read-ahead in, write-behind out), so memory stays at a few
+ * chunks per worker however long the files are. Outputs are
+ * latency-compensated (aligned with their inputs) and run on past the
+ * input's end by the processor's tail length.
+ *
+ * Usage:
+ *   BlackheartRender [options] <input.wav|flac>...
+ *
+ * Options:
+ *   --inputs-from=list.txt  read further input paths from a file, one per line
+ *   --presets=a.bin,b.bin   preset state blobs (getStateInformation format);
+ *                           every input renders once per preset (default: the
+ *                           plugin defaults)
+ *   --output-dir=rendered   where outputs go; named <input>.wav, or
+ *                           <input>-<preset>.wav with several presets
+ *   --threads=8             worker threads (default: one per core)
+ *   --chunk=8192            samples per processBlock call
+ *   --bits=32               output bit depth: 16, 24 or 32 (float)
+ *   --live                  render at the preset's realtime quality tier
+ *                           instead of the Render tier
+ *   --seed=1234             pin the chaos random sources (repeatable renders)
+ *   --report=render.json    write per-job timing and levels, and the peak
+ *                           resident memory, as JSON
+ *
+ * Exits non-zero if any job fails.
+ */
+
+#include "PluginProcessor.h"
+#include "StreamingAudio.h"
+#include <algorithm>
+#include <deque>
+#include <iostream>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+#if JUCE_LINUX || JUCE_MAC
+ #include <sys/resource.h>
+#endif
+
+//==============================================================================
+// Configuration
+//==============================================================================
+
+struct RenderConfig
+{
+    juce::Array<juce::File> inputs;
+    juce::Array<juce::File> presets;
+    juce::File outputDirectory;
+    int numThreads = 1;
+    int chunkSize = 8192;
+    int bitsPerSample = 32;
+    bool liveQuality = false;
+    std::optional<unsigned int> seed;
+    juce::String reportPath;
+};
+
+static RenderConfig parseArguments(const juce::ArgumentList& args)
+{
+    RenderConfig config;
+
+    for (const auto& arg : args.arguments)
+        if (! arg.isOption())
+            config.inputs.add(arg.resolveAsFile());
+
+    if (args.containsOption("--inputs-from"))
+    {
+        const auto listFile = juce::File::getCurrentWorkingDirectory().getChildFile(args.getValueForOption("--inputs-from"));
+        juce::StringArray lines;
+        listFile.readLines(lines);
+
+        for (const auto& line : lines)
+            if (line.trim().isNotEmpty())
+                config.inputs.add(listFile.getParentDirectory().getChildFile(line.trim()));
+    }
+
+    for (const auto& token : juce::StringArray::fromTokens(args.getValueForOption("--presets"), ",", ""))
+        config.presets.add(juce::File::getCurrentWorkingDirectory().getChildFile(token));
+
+    config.outputDirectory = juce::File::getCurrentWorkingDirectory().getChildFile(
+        args.containsOption("--output-dir") ? args.getValueForOption("--output-dir") : juce::String("rendered"));
+
+    config.numThreads = juce::SystemStats::getNumCpus();
+    if (args.containsOption("--threads"))
+        config.numThreads = juce::jlimit(1, 256, args.getValueForOption("--threads").getIntValue());
+
+    if (args.containsOption("--chunk"))
+        config.chunkSize = juce::jlimit(64, 65536, args.getValueForOption("--chunk").getIntValue());
+
+    if (args.containsOption("--bits"))
+    {
+        const int bits = args.getValueForOption("--bits").getIntValue();
+        config.bitsPerSample = bits == 16 || bits == 24 ? bits : 32;
+    }
+
+    config.liveQuality = args.containsOption("--live");
+
+    if (args.containsOption("--seed"))
+        config.seed = static_cast<unsigned int>(args.getValueForOption("--seed").getLargeIntValue());
+
+    config.reportPath = args.getValueForOption("--report");
+    return config;
+}
+
+//==============================================================================
+// Jobs
+//==============================================================================
+
+struct RenderJob
+{
+    juce::File input;
+    juce::File preset;              // Nonexistent file: plugin defaults
+    juce::File output;
+    juce::int64 cost = 0;           // Samples x channels, for scheduling
+};
+
+struct JobResult
+{
+    bool ok = false;
+    juce::String error;
+    double audioSeconds = 0.0;
+    double renderSeconds = 0.0;
+    float peak = 0.0f;
+    bool memoryMapped = false;
+};
+
+// One job per (input, preset) pair. Inputs are opened here to fail fast on
+// unreadable files and to size the jobs for scheduling
+static std::vector<RenderJob> buildJobs(const RenderConfig& config, juce::AudioFormatManager& formats,
+                                        juce::StringArray& errors)
+{
+    std::vector<RenderJob> jobs;
+    juce::StringArray outputPaths;
+    const bool namePresets = config.presets.size() > 1;
+
+    for (const auto& input : config.inputs)
+    {
+        std::unique_ptr<juce::AudioFormatReader> reader(formats.createReaderFor(input));
+        if (reader == nullptr)
+        {
+            errors.add("Could not read " + input.getFullPathName());
+            continue;
+        }
+
+        const auto cost = reader->lengthInSamples * static_cast<juce::int64>(reader->numChannels);
+        const int numPresets = juce::jmax(1, config.presets.size());
+
+        for (int p = 0; p < numPresets; ++p)
+        {
+            RenderJob job;
+            job.input = input;
+            job.preset = config.presets.isEmpty() ? juce::File() : config.presets.getReference(p);
+            job.cost = cost;
+
+            auto name = input.getFileNameWithoutExtension();
+            if (namePresets)
+                name << "-" << job.preset.getFileNameWithoutExtension();
+            job.output = config.outputDirectory.getChildFile(name + ".wav");
+
+            if (outputPaths.contains(job.output.getFullPathName()))
+            {
+                errors.add("Two jobs would write " + job.output.getFullPathName());
+                continue;
+            }
+
+            outputPaths.add(job.output.getFullPathName());
+            jobs.push_back(job);
+        }
+    }
+
+    return jobs;
+}
+
+//==============================================================================
+// Work-stealing scheduler
+//==============================================================================
+
+// Jobs are dealt longest-first across one queue per worker. A worker takes
+// from the front of its own queue (its longest remaining job) and, once
+// that runs dry, steals from the back of the fullest other queue. Jobs are
+// whole files, so a mutex per queue costs nothing next to the render.
+class JobScheduler
+{
+public:
+    JobScheduler(int numWorkers, const std::vector<RenderJob>& jobs)
+        : queues(static_cast<size_t>(juce::jmax(1, numWorkers)))
+    {
+        std::vector<int> order(jobs.size());
+        for (size_t i = 0; i < order.size(); ++i)
+            order[i] = static_cast<int>(i);
+
+        std::stable_sort(order.begin(), order.end(), [&jobs](int a, int b)
+        {
+            return jobs[static_cast<size_t>(a)].cost > jobs[static_cast<size_t>(b)].cost;
+        });
+
+        for (size_t i = 0; i < order.size(); ++i)
+            queues[i % queues.size()].jobs.push_back(order[i]);
+    }
+
+    // Index of the worker's next job, or -1 once every queue is empty
+    int next(int worker)
+    {
+        auto& own = queues[static_cast<size_t>(worker)];
+        {
+            const std::lock_guard<std::mutex> lock(own.mutex);
+            if (! own.jobs.empty())
+            {
+                const int job = own.jobs.front();
+                own.jobs.pop_front();
+                return job;
+            }
+        }
+
+        // Nothing is ever added, so an empty sweep means the batch is done
+        for (;;)
+        {
+            Queue* victim = nullptr;
+            size_t most = 0;
+
+            for (auto& queue : queues)
+            {
+                if (&queue == &own)
+                    continue;
+
+                const std::lock_guard<std::mutex> lock(queue.mutex);
+                if (queue.jobs.size() > most)
+                {
+                    most = queue.jobs.size();
+                    victim = &queue;
+                }
+            }
+
+            if (victim == nullptr)
+                return -1;
+
+            const std::lock_guard<std::mutex> lock(victim->mutex);
+            if (! victim->jobs.empty())
+            {
+                const int job = victim->jobs.back();
+                victim->jobs.pop_back();
+                return job;
+            }
+        }
+    }
+
+private:
+    struct Queue
+    {
+        std::mutex mutex;
+        std::deque<int> jobs;
+    };
+
+    std::vector<Queue> queues;
+};
+
+//==============================================================================
+// Rendering
+//==============================================================================
+
+static JobResult renderJob(BlackheartAudioProcessor& processor, const juce::MemoryBlock& defaultState,
+                           const RenderJob& job, const RenderConfig& config, juce::AudioFormatManager& formats,
+                           juce::TimeSliceThread& ioThread)
+{
+    JobResult result;
+    const auto startTicks = juce::Time::getHighResolutionTicks();
+
+    StreamingAudioReader reader(formats, job.input, ioThread, config.chunkSize);
+    if (! reader.isOpen())
+    {
+        result.error = "could not read input";
+        return result;
+    }
+
+    const int numChannels = reader.getNumChannels();
+    const double sampleRate = reader.getSampleRate();
+    const juce::int64 inputLength = reader.getLengthInSamples();
+
+    // The processor is reused between jobs: every job restores a full state,
+    // its preset or the defaults, so nothing carries over from the last one
+    juce::MemoryBlock presetState;
+    if (job.preset.existsAsFile() && ! job.preset.loadFileAsData(presetState))
+    {
+        result.error = "could not read preset";
+        return result;
+    }
+
+    const auto& state = presetState.isEmpty() ? defaultState : presetState;
+    processor.setStateInformation(state.getData(), static_cast<int>(state.getSize()));
+
+    const auto channelSet = numChannels <= 2 ? juce::AudioChannelSet::canonicalChannelSet(numChannels)
+                                             : juce::AudioChannelSet::discreteChannels(numChannels);
+    auto layout = processor.getBusesLayout();
+    layout.inputBuses.getReference(0) = channelSet;
+    layout.outputBuses.getReference(0) = channelSet;
+    if (! processor.setBusesLayout(layout))
+    {
+        result.error = "unsupported channel count " + juce::String(numChannels);
+        return result;
+    }
+
+    processor.setNonRealtime(! config.liveQuality);
+    processor.prepareToPlay(sampleRate, config.chunkSize);
+
+    // Render latency + input + tail, dropping the first latency samples, so
+    // the output lines up with the input and keeps the full tail
+    const juce::int64 latency = processor.getLatencyInSamples();
+    const juce::int64 tail = juce::roundToInt(processor.getTailLengthSeconds() * sampleRate);
+    const juce::int64 renderLength = latency + inputLength + tail;
+
+    StreamingAudioWriter writer(job.output, sampleRate, numChannels, config.bitsPerSample, ioThread, config.chunkSize);
+    if (! writer.isOpen())
+    {
+        result.error = "could not create output";
+        return result;
+    }
+
+    juce::AudioBuffer<float> buffer(numChannels, config.chunkSize);
+    juce::MidiBuffer midi;
+
+    for (juce::int64 position = 0; position < renderLength; position += config.chunkSize)
+    {
+        const int numSamples = static_cast<int>(std::min<juce::int64>(config.chunkSize, renderLength - position));
+
+        buffer.setSize(numChannels, numSamples, false, false, true);
+        if (! reader.readNext(buffer, numSamples))
+        {
+            result.error = "read failed";
+            return result;
+        }
+
+        processor.processBlock(buffer, midi);
+
+        const int skip = static_cast<int>(juce::jlimit<juce::int64>(0, numSamples, latency - position));
+        if (skip == numSamples)
+            continue;
+
+        result.peak = juce::jmax(result.peak, buffer.getMagnitude(skip, numSamples - skip));
+        if (! writer.write(buffer, skip, numSamples - skip))
+        {
+            result.error = "write failed";
+            return result;
+        }
+    }
+
+    processor.releaseResources();
+
+    if (! writer.finish())
+    {
+        result.error = "could not complete output";
+        return result;
+    }
+
+    result.ok = true;
+    result.memoryMapped = reader.isMemoryMapped();
+    result.audioSeconds = static_cast<double>(inputLength + tail) / sampleRate;
+    result.renderSeconds = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - startTicks);
+    return result;
+}
+
+// Peak resident set of the process so far, in MB (0 where unavailable)
+static double getPeakResidentMegabytes()
+{
+   #if JUCE_LINUX || JUCE_MAC
+    rusage usage {};
+    if (getrusage(RUSAGE_SELF, &usage) == 0)
+    {
+       #if JUCE_MAC
+        return static_cast<double>(usage.ru_maxrss) / (1024.0 * 1024.0);   // bytes
+       #else
+        return static_cast<double>(usage.ru_maxrss) / 1024.0;              // KB
+       #endif
+    }
+   #endif
+    return 0.0;
+}
+
+//==============================================================================
+// Report
+//==============================================================================
+
+static juce::var toJson(const RenderConfig& config, const std::vector<RenderJob>& jobs,
+                        const std::vector<JobResult>& results, int numWorkers, double wallSeconds)
+{
+    juce::DynamicObject::Ptr root = new juce::DynamicObject();
+    root->setProperty("tool", "stemRender");
+    root->setProperty("pluginVersion", JucePlugin_VersionString);
+    root->setProperty("cpu", juce::SystemStats::getCpuModel());
+    root->setProperty("threads", numWorkers);
+    root->setProperty("chunkSize", config.chunkSize);
+    root->setProperty("quality", config.liveQuality ? "live" : "render");
+
+    double audioSeconds = 0.0;
+    juce::Array<juce::var> entries;
+
+    for (size_t i = 0; i < jobs.size(); ++i)
+    {
+        const auto& r = results[i];
+        juce::DynamicObject::Ptr entry = new juce::DynamicObject();
+        entry->setProperty("input", jobs[i].input.getFullPathName());
+        entry->setProperty("preset", jobs[i].preset.getFullPathName());
+        entry->setProperty("output", jobs[i].output.getFullPathName());
+        entry->setProperty("ok", r.ok);
+
+        if (r.ok)
+        {
+            entry->setProperty("audioSeconds", r.audioSeconds);
+            entry->setProperty("renderSeconds", r.renderSeconds);
+            entry->setProperty("realtimeFactor", r.audioSeconds / juce::jmax(r.renderSeconds, 1.0e-9));
+            entry->setProperty("peakDb", juce::Decibels::gainToDecibels(r.peak));
+            entry->setProperty("inputMode", r.memoryMapped ? "mapped" : "buffered");
+            audioSeconds += r.audioSeconds;
+        }
+        else
+        {
+            entry->setProperty("error", r.error);
+        }
+
+        entries.add(juce::var(entry.get()));
+    }
+
+    root->setProperty("audioSeconds", audioSeconds);
+    root->setProperty("wallSeconds", wallSeconds);
+    root->setProperty("realtimeFactor", audioSeconds / juce::jmax(wallSeconds, 1.0e-9));
+    root->setProperty("peakResidentMb", getPeakResidentMegabytes());
+    root->setProperty("jobs", entries);
+
+    return juce::var(root.get());
+}
+
+//==============================================================================
+// Entry point
+//==============================================================================
+
+int main(int argc, char* argv[])
+{
+    juce::ScopedJuceInitialiser_GUI juceInit;
+
+    const juce::ArgumentList args(argc, argv);
+    const auto config = parseArguments(args);
+
+    if (config.inputs.isEmpty())
+    {
+        std::cerr << "Usage: BlackheartRender [--presets=a.bin,b.bin] [--output-dir=dir] [--threads=N] "
+                     "[--chunk=N] [--bits=16|24|32] [--live] [--seed=N] [--report=file.json] "
+                     "[--inputs-from=list.txt] <input>..." << std::endl;
+        return 1;
+    }
+
+    for (const auto& preset : config.presets)
+    {
+        if (! preset.existsAsFile())
+        {
+            std::cerr << "No preset at " << preset.getFullPathName() << std::endl;
+            return 1;
+        }
+    }
+
+    juce::AudioFormatManager formats;
+    formats.registerBasicFormats();
+
+    juce::StringArray errors;
+    const auto jobs = buildJobs(config, formats, errors);
+    for (const auto& error : errors)
+        std::cerr << error << std::endl;
+
+    if (! errors.isEmpty() || jobs.empty())
+        return 1;
+
+    if (config.outputDirectory.createDirectory().failed())
+    {
+        std::cerr << "Could not create " << config.outputDirectory.getFullPathName() << std::endl;
+        return 1;
+    }
+
+    // Processors are built here, on the message thread; each worker then
+    // owns one for the whole batch. All start from the same defaults
+    const int numWorkers = juce::jmin(config.numThreads, static_cast<int>(jobs.size()));
+    std::vector<std::unique_ptr<BlackheartAudioProcessor>> processors;
+    for (int w = 0; w < numWorkers; ++w)
+    {
+        processors.push_back(std::make_unique<BlackheartAudioProcessor>());
+        if (config.seed.has_value())
+            processors.back()->setRandomSeed(*config.seed);
+    }
+
+    juce::MemoryBlock defaultState;
+    processors.front()->getStateInformation(defaultState);
+
+    JobScheduler scheduler(numWorkers, jobs);
+    std::vector<JobResult> results(jobs.size());
+    std::mutex logMutex;
+    const auto startTicks = juce::Time::getHighResolutionTicks();
+
+    std::vector<std::thread> workers;
+    for (int w = 0; w < numWorkers; ++w)
+    {
+        workers.emplace_back([&, w]
+        {
+            juce::AudioFormatManager workerFormats;
+            workerFormats.registerBasicFormats();
+
+            // Read-ahead and write-behind for this worker's streams
+            juce::TimeSliceThread ioThread("Render I/O " + juce::String(w));
+            ioThread.startThread();
+
+            for (int index = scheduler.next(w); index >= 0; index = scheduler.next(w))
+            {
+                const auto& job = jobs[static_cast<size_t>(index)];
+                auto& result = results[static_cast<size_t>(index)];
+                result = renderJob(*processors[static_cast<size_t>(w)], defaultState, job, config, workerFormats,
+                                   ioThread);
+
+                const std::lock_guard<std::mutex> lock(logMutex);
+                if (result.ok)
+                    std::cerr << "rendered " << job.output.getFileName() << ": "
+                              << juce::String(result.audioSeconds, 1) << "s of audio in "
+                              << juce::String(result.renderSeconds, 1) << "s, peak "
+                              << juce::String(juce::Decibels::gainToDecibels(result.peak), 1) << " dB" << std::endl;
+                else
+                    std::cerr << "FAIL " << job.input.getFileName() << ": " << result.error << std::endl;
+            }
+        });
+    }
+
+    for (auto& worker : workers)
+        worker.join();
+
+    const double wallSeconds = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - startTicks);
+    int failures = 0;
+    double audioSeconds = 0.0;
+    for (const auto& result : results)
+    {
+        failures += result.ok ? 0 : 1;
+        audioSeconds += result.audioSeconds;
+    }
+
+    std::cerr << static_cast<int>(jobs.size()) - failures << "/" << jobs.size() << " jobs on "
+              << numWorkers << " threads in " << juce::String(wallSeconds, 1) << "s ("
+              << juce::String(audioSeconds / juce::jmax(wallSeconds, 1.0e-9), 1) << "x realtime), peak RSS "
+              << juce::String(getPeakResidentMegabytes(), 1) << " MB" << std::endl;
+
+    if (config.reportPath.isNotEmpty())
+    {
+        const auto file = juce::File::getCurrentWorkingDirectory().getChildFile(config.reportPath);
+        if (! file.replaceWithText(juce::JSON::toString(toJson(config, jobs, results, numWorkers, wallSeconds))))
+        {
+            std::cerr << "Could not write " << file.getFullPathName() << std::endl;
+            return 1;
+        }
+    }
+
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,146 @@
+#include "StreamingAudio.h"
+
+namespace
+{
+    // Background buffering in chunks: enough for the I/O thread to stay a
+    // few chunks ahead of (or behind) the render
+    constexpr int bufferedChunks = 4;
+
+    // Mapped window in chunks: remapping is a syscall, so map well ahead
+    constexpr int mappedChunks = 64;
+}
+
+//==============================================================================
+StreamingAudioReader::StreamingAudioReader(juce::AudioFormatManager& formats, const juce::File& file,
+                                           juce::TimeSliceThread& ioThread, int chunkSize)
+{
+    jassert(chunkSize > 0);
+
+    // WAV maps straight from the page cache; anything the WAV parser
+    // rejects, or a map that fails, goes through a decoding read-ahead
+    juce::WavAudioFormat wav;
+    std::unique_ptr<juce::MemoryMappedAudioFormatReader> mappedReader(wav.createMemoryMappedReader(file));
+
+    if (mappedReader != nullptr && mappedReader->lengthInSamples > 0)
+    {
+        mapWindow = static_cast<juce::int64>(chunkSize) * mappedChunks;
+        if (mappedReader->mapSectionOfFile({ 0, juce::jmin(mapWindow, mappedReader->lengthInSamples) }))
+        {
+            mapped = mappedReader.get();
+            source = std::move(mappedReader);
+        }
+    }
+
+    if (source == nullptr)
+    {
+        if (auto* decoder = formats.createReaderFor(file))
+        {
+            auto buffering = std::make_unique<juce::BufferingAudioReader>(decoder, ioThread, chunkSize * bufferedChunks);
+            // Offline: wait for the decoder rather than read silence
+            buffering->setReadTimeout(-1);
+            source = std::move(buffering);
+        }
+    }
+
+    if (source != nullptr)
+    {
+        numChannels = static_cast<int>(source->numChannels);
+        sampleRate = source->sampleRate;
+        lengthInSamples = source->lengthInSamples;
+    }
+}
+
+bool StreamingAudioReader::ensureMapped(juce::int64 start, int numSamples)
+{
+    const auto needed = juce::Range<juce::int64>(start, start + numSamples);
+    if (mapped->getMappedSection().contains(needed))
+        return true;
+
+    // Remapping releases the previous window, which keeps the resident
+    // share of the file at one window however far the render has got
+    const auto end = juce::jmin(lengthInSamples, start + juce::jmax(mapWindow, static_cast<juce::int64>(numSamples)));
+    return mapped->mapSectionOfFile({ start, end });
+}
+
+bool StreamingAudioReader::readNext(juce::AudioBuffer<float>& buffer, int numSamples)
+{
+    jassert(buffer.getNumSamples() >= numSamples);
+    if (source == nullptr)
+        return false;
+
+    const int fromFile = static_cast<int>(juce::jlimit<juce::int64>(0, numSamples, lengthInSamples - position));
+
+    if (fromFile > 0)
+    {
+        if (mapped != nullptr && ! ensureMapped(position, fromFile))
+            return false;
+
+        if (! source->read(&buffer, 0, fromFile, position, true, true))
+            return false;
+    }
+
+    if (fromFile < numSamples)
+        buffer.clear(fromFile, numSamples - fromFile);
+
+    position += fromFile;
+    return true;
+}
+
+//==============================================================================
+StreamingAudioWriter::StreamingAudioWriter(const juce::File& target, double sampleRate, int numChannels,
+                                           int bitsPerSample, juce::TimeSliceThread& ioThread, int chunkSize)
+    : temporary(target),
+      channels(static_cast<size_t>(juce::jmax(0, numChannels)))
+{
+    jassert(chunkSize > 0);
+
+    auto stream = std::make_unique<juce::FileOutputStream>(temporary.getFile());
+    if (! stream->openedOk())
+        return;
+
+    juce::WavAudioFormat wav;
+    std::unique_ptr<juce::AudioFormatWriter> writer(wav.createWriterFor(stream.get(), sampleRate,
+        static_cast<unsigned int>(numChannels), bitsPerSample, {}, 0));
+    if (writer == nullptr)
+        return;
+
+    stream.release();  // Owned by the writer now
+    bytesPerFrame = numChannels * bitsPerSample / 8;
+
+    // The FIFO takes whole chunks, so it must hold more than one
+    threaded = std::make_unique<juce::AudioFormatWriter::ThreadedWriter>(writer.release(), ioThread,
+                                                                          chunkSize * bufferedChunks);
+}
+
+bool StreamingAudioWriter::write(const juce::AudioBuffer<float>& buffer, int startSample, int numSamples)
+{
+    if (threaded == nullptr || buffer.getNumChannels() < static_cast<int>(channels.size()))
+        return false;
+
+    for (size_t ch = 0; ch < channels.size(); ++ch)
+        channels[ch] = buffer.getReadPointer(static_cast<int>(ch), startSample);
+
+    // write() refuses a block the FIFO has no room for; the I/O thread
+    // frees space as it drains
+    while (! threaded->write(channels.data(), numSamples))
+        juce::Thread::sleep(1);
+
+    samplesWritten += numSamples;
+    return true;
+}
+
+bool StreamingAudioWriter::finish()
+{
+    if (threaded == nullptr)
+        return false;
+
+    // Destroying the ThreadedWriter writes out whatever is queued, then
+    // closes the file. It doesn't report write errors, so check the size
+    threaded.reset();
+
+    const auto expectedBytes = samplesWritten * bytesPerFrame;
+    if (temporary.getFile().getSize() < expectedBytes)
+        return false;
+
+    return temporary.overwriteTargetFileWithTemporary();
+}
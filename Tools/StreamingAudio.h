@@ -0,0 +1,88 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <memory>
+#include <vector>
+
+/**
+ * Bounded-memory audio file streaming for the offline tools.
+ *
+ * StreamingAudioReader hands out consecutive chunks of a file. WAV inputs
+ * are memory-mapped a window at a time, so reads are copies out of the page
+ * cache and only the current window counts towards resident memory. Other
+ * formats (FLAC) decode ahead of the reader on a background TimeSliceThread.
+ *
+ * StreamingAudioWriter queues chunks into a fixed FIFO that the same kind
+ * of background thread drains to disk (write-behind), so encoding and file
+ * I/O overlap the render.
+ *
+ * Memory per stream is a few chunks regardless of file length. Neither
+ * class is thread-safe; give each worker its own, and its own I/O thread.
+ */
+
+//==============================================================================
+class StreamingAudioReader
+{
+public:
+    // Opens the file; isOpen() reports failure. ioThread must outlive the
+    // reader and be running
+    StreamingAudioReader(juce::AudioFormatManager& formats, const juce::File& file,
+                         juce::TimeSliceThread& ioThread, int chunkSize);
+    ~StreamingAudioReader() = default;
+
+    bool isOpen() const noexcept { return source != nullptr; }
+    bool isMemoryMapped() const noexcept { return mapped != nullptr; }
+
+    int getNumChannels() const noexcept { return numChannels; }
+    double getSampleRate() const noexcept { return sampleRate; }
+    juce::int64 getLengthInSamples() const noexcept { return lengthInSamples; }
+
+    // Fills the first numSamples of every buffer channel with the next
+    // samples of the file, zeros past its end. Returns false on a read error
+    bool readNext(juce::AudioBuffer<float>& buffer, int numSamples);
+
+private:
+    bool ensureMapped(juce::int64 start, int numSamples);
+
+    juce::MemoryMappedAudioFormatReader* mapped = nullptr;    // Points into source when mapped
+    std::unique_ptr<juce::AudioFormatReader> source;
+
+    int numChannels = 0;
+    double sampleRate = 0.0;
+    juce::int64 lengthInSamples = 0;
+    juce::int64 position = 0;
+    juce::int64 mapWindow = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(StreamingAudioReader)
+};
+
+//==============================================================================
+class StreamingAudioWriter
+{
+public:
+    // Creates a WAV beside target; finish() moves it into place, so a failed
+    // render never leaves a partial file under the target's name. ioThread
+    // must outlive the writer and be running
+    StreamingAudioWriter(const juce::File& target, double sampleRate, int numChannels, int bitsPerSample,
+                         juce::TimeSliceThread& ioThread, int chunkSize);
+    ~StreamingAudioWriter() = default;
+
+    bool isOpen() const noexcept { return threaded != nullptr; }
+
+    // Queues numSamples of every channel from startSample; waits while the
+    // write-behind FIFO is full
+    bool write(const juce::AudioBuffer<float>& buffer, int startSample, int numSamples);
+
+    // Drains the FIFO, closes the file, checks every sample reached it and
+    // moves it over the target
+    bool finish();
+
+private:
+    juce::TemporaryFile temporary;
+    std::unique_ptr<juce::AudioFormatWriter::ThreadedWriter> threaded;
+    std::vector<const float*> channels;
+    int bytesPerFrame = 0;
+    juce::int64 samplesWritten = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(StreamingAudioWriter)
+};